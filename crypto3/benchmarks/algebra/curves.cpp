@@ -113,6 +113,17 @@ void benchmark_curve_operations(std::string const& curve_name)
             return A *= B;
             });
 
+    if constexpr (curves::detail::has_glv_endomorphism<typename g1_type::params_type>::value) {
+        // Same multiplication without the endomorphism, to compare against the GLV path above.
+        run_benchmark<g1_type, scalar_field>(
+                curve_name + " G1 scalar multiplication (plain wNAF)",
+                [](typename g1_type::value_type& A, typename scalar_field::value_type const& B) {
+                using scalar_integral_type = typename scalar_field::integral_type;
+                curves::detail::scalar_mul_inplace(A, static_cast<scalar_integral_type>(B.data));
+                return A;
+                });
+    }
+
     if constexpr (has_type_g2_type<curve_type>::value) {
         using g2_type = typename curve_type::template g2_type<>;
 
@@ -217,6 +228,16 @@ BOOST_AUTO_TEST_CASE(bls12_381)
     benchmark_curve_operations<nil::crypto3::algebra::curves::bls12<381>>("BLS12-381");
 }
 
+BOOST_AUTO_TEST_CASE(secp256k1)
+{
+    benchmark_curve_operations<nil::crypto3::algebra::curves::secp256k1>("secp256k1");
+}
+
+BOOST_AUTO_TEST_CASE(alt_bn128_254)
+{
+    benchmark_curve_operations<nil::crypto3::algebra::curves::alt_bn128_254>("BN254");
+}
+
 BOOST_AUTO_TEST_CASE(bls12_377)
 {
     benchmark_curve_operations<nil::crypto3::algebra::curves::bls12<377>>("BLS12-377");
@@ -69,6 +69,24 @@ namespace nil {
 
                         constexpr static const std::array<typename field_type::value_type, 2> one_fill = {
                             field_type::value_type::one(), typename field_type::value_type(0x02u)};
+
+                        // The group has prime order, so every point is in the subgroup phi acts on.
+                        constexpr static const std::size_t cofactor = 1;
+
+                        // GLV endomorphism and scalar decomposition constants, see glv_scalar_mul_inplace.
+                        constexpr static const typename field_type::value_type glv_beta =
+                            typename field_type::value_type(0x59e26bcea0d48bacd4f263f1acdb5c4f5763473177fffffe_big_uint254);
+                        constexpr static const typename scalar_field_type::value_type glv_lambda =
+                            typename scalar_field_type::value_type(0xb3c4d79d41a917585bfc41088d8daaa78b17ea66b99c90dd_big_uint254);
+                        constexpr static const typename scalar_field_type::value_type glv_b1 =
+                            typename scalar_field_type::value_type(0x30644e72e131a029b85045b68181585cb8e665ff8b011694c1d039a872b0eed9_big_uint254);
+                        constexpr static const typename scalar_field_type::value_type glv_b2 =
+                            typename scalar_field_type::value_type(0x89d3256894d213e3_big_uint254);
+                        constexpr static const typename scalar_field_type::integral_type glv_g1 =
+                            0xb64748cbb1f82cf6_big_uint254;
+                        constexpr static const typename scalar_field_type::integral_type glv_g2 =
+                            0x9333bc0529dcf4b3de9ef6750e47ac63_big_uint254;
+                        constexpr static const std::size_t glv_shift = 254;
                     };
 
                     template<>
@@ -114,6 +132,19 @@ namespace nil {
                     constexpr std::array<
                         typename alt_bn128_g1_params<254, forms::short_weierstrass>::field_type::value_type,
                         2> const alt_bn128_g1_params<254, forms::short_weierstrass>::one_fill;
+                    constexpr typename alt_bn128_g1_params<254, forms::short_weierstrass>::field_type::value_type const
+                        alt_bn128_g1_params<254, forms::short_weierstrass>::glv_beta;
+                    constexpr typename alt_bn128_g1_params<254, forms::short_weierstrass>::scalar_field_type::value_type const
+                        alt_bn128_g1_params<254, forms::short_weierstrass>::glv_lambda;
+                    constexpr typename alt_bn128_g1_params<254, forms::short_weierstrass>::scalar_field_type::value_type const
+                        alt_bn128_g1_params<254, forms::short_weierstrass>::glv_b1;
+                    constexpr typename alt_bn128_g1_params<254, forms::short_weierstrass>::scalar_field_type::value_type const
+                        alt_bn128_g1_params<254, forms::short_weierstrass>::glv_b2;
+                    constexpr typename alt_bn128_g1_params<254, forms::short_weierstrass>::scalar_field_type::integral_type const
+                        alt_bn128_g1_params<254, forms::short_weierstrass>::glv_g1;
+                    constexpr typename alt_bn128_g1_params<254, forms::short_weierstrass>::scalar_field_type::integral_type const
+                        alt_bn128_g1_params<254, forms::short_weierstrass>::glv_g2;
+                    constexpr std::size_t const alt_bn128_g1_params<254, forms::short_weierstrass>::glv_shift;
                     constexpr std::array<
                         typename alt_bn128_g2_params<254, forms::short_weierstrass>::field_type::value_type,
                         2> const alt_bn128_g2_params<254, forms::short_weierstrass>::zero_fill;
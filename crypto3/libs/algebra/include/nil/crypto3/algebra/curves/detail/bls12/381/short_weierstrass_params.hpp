@@ -72,6 +72,21 @@ namespace nil {
                                 0x17F1D3A73197D7942695638C4FA9AC0FC3688C4F9774B905A14E3A3F171BAC586C55E83FF97A1AEFFB3AF00ADB22C6BB_big_uint381),
                             typename field_type::value_type(
                                 0x8B3F481E3AAA0F1A09E30ED741D8AE4FCF5E095D5D00AF600DB18CB2C04B3EDD03CC744A2888AE40CAA232946C5E7E1_big_uint380)};
+
+                        // GLV endomorphism and scalar decomposition constants, see glv_scalar_mul_inplace.
+                        constexpr static const typename field_type::value_type glv_beta =
+                            typename field_type::value_type(0x1a0111ea397fe699ec02408663d4de85aa0d857d89759ad4897d29650fb85f9b409427eb4f49fffd8bfd00000000aaac_big_uint381);
+                        constexpr static const typename scalar_field_type::value_type glv_lambda =
+                            typename scalar_field_type::value_type(0xac45a4010001a40200000000ffffffff_big_uint255);
+                        constexpr static const typename scalar_field_type::value_type glv_b1 =
+                            typename scalar_field_type::value_type(0x73eda753299d7d483339d80809a1d80553bda402fffe5bfeffffffff00000000_big_uint255);
+                        constexpr static const typename scalar_field_type::value_type glv_b2 =
+                            typename scalar_field_type::value_type(0xac45a4010001a4020000000100000000_big_uint255);
+                        constexpr static const typename scalar_field_type::integral_type glv_g1 =
+                            0xbe35f678f00fd56eb1fb72917b67f718_big_uint255;
+                        constexpr static const typename scalar_field_type::integral_type glv_g2 =
+                            0x1_big_uint255;
+                        constexpr static const std::size_t glv_shift = 255;
                     };
 
                     template<>
@@ -121,6 +136,19 @@ namespace nil {
                     constexpr std::array<
                         typename bls12_g1_params<381, forms::short_weierstrass>::field_type::value_type,
                         2> const bls12_g1_params<381, forms::short_weierstrass>::one_fill;
+                    constexpr typename bls12_g1_params<381, forms::short_weierstrass>::field_type::value_type const
+                        bls12_g1_params<381, forms::short_weierstrass>::glv_beta;
+                    constexpr typename bls12_g1_params<381, forms::short_weierstrass>::scalar_field_type::value_type const
+                        bls12_g1_params<381, forms::short_weierstrass>::glv_lambda;
+                    constexpr typename bls12_g1_params<381, forms::short_weierstrass>::scalar_field_type::value_type const
+                        bls12_g1_params<381, forms::short_weierstrass>::glv_b1;
+                    constexpr typename bls12_g1_params<381, forms::short_weierstrass>::scalar_field_type::value_type const
+                        bls12_g1_params<381, forms::short_weierstrass>::glv_b2;
+                    constexpr typename bls12_g1_params<381, forms::short_weierstrass>::scalar_field_type::integral_type const
+                        bls12_g1_params<381, forms::short_weierstrass>::glv_g1;
+                    constexpr typename bls12_g1_params<381, forms::short_weierstrass>::scalar_field_type::integral_type const
+                        bls12_g1_params<381, forms::short_weierstrass>::glv_g2;
+                    constexpr std::size_t const bls12_g1_params<381, forms::short_weierstrass>::glv_shift;
 
                     constexpr std::array<
                         typename bls12_g2_params<381, forms::short_weierstrass>::field_type::value_type,
@@ -206,6 +206,11 @@ namespace nil {
                                 return result_type::zero();
                             }
 
+                            // Already normalized, e.g. by batch_normalize.
+                            if (Z.is_one()) {
+                                return result_type(X, Y);
+                            }
+
                             //  x=X/Z^2, y=Y/Z^3
                             auto Zi = Z.inversed();
                             return result_type(X * Zi * Zi, Y * Zi * Zi * Zi);
@@ -211,6 +211,11 @@ namespace nil {
                                 return result_type::zero();
                             }
 
+                            // Already normalized, e.g. by batch_normalize.
+                            if (Z.is_one()) {
+                                return result_type(X, Y);
+                            }
+
                             auto Zi = Z.inversed();
                             return result_type(X * Zi * Zi, Y * Zi * Zi * Zi);    //  x=X/Z^2, y=Y/Z^3
                         }
@@ -213,9 +213,14 @@ namespace nil {
                                 return result_type::zero();
                             }
 
+                            // Already normalized, e.g. by batch_normalize.
+                            if (Z.is_one()) {
+                                return result_type(X, Y);
+                            }
+
                             auto Zi = Z.inversed();
 
-                            return result_type(X * Zi * Zi, Y * Zi * Zi);    //  x=X/Z^2, y=Y/Z^3
+                            return result_type(X * Zi * Zi, Y * Zi * Zi * Zi);    //  x=X/Z^2, y=Y/Z^3
                         }
 
                         /** @brief
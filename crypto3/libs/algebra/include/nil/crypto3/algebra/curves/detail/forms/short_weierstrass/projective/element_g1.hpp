@@ -195,6 +195,11 @@ namespace nil {
                                 return result_type::zero();
                             }
 
+                            // Already normalized, e.g. by batch_normalize.
+                            if (Z.is_one()) {
+                                return result_type(X, Y);
+                            }
+
                             return result_type(X * Z.inversed(), Y * Z.inversed());    //  x=X/Z, y=Y/Z
                         }
 
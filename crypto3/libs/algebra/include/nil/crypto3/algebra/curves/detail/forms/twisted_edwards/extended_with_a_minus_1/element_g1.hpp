@@ -213,6 +213,11 @@ namespace nil {
                                 return result_type::zero();
                             }
 
+                            // Already normalized, e.g. by batch_normalize.
+                            if (Z.is_one()) {
+                                return result_type(X, Y);
+                            }
+
                             // assert((X/Z)*(Y/Z) == (T/Z));
                             auto Zi = Z.inversed();
                             return result_type(X * Zi, Y * Zi);    //  x=X/Z, y=Y/Z
@@ -28,6 +28,9 @@
 #ifndef CRYPTO3_ALGEBRA_CURVES_SCALAR_MUL_HPP
 #define CRYPTO3_ALGEBRA_CURVES_SCALAR_MUL_HPP
 
+#include <array>
+#include <type_traits>
+
 #include <nil/crypto3/algebra/type_traits.hpp>
 
 #include <nil/crypto3/multiprecision/big_uint.hpp>
@@ -79,13 +82,144 @@ namespace nil {
                         }
                     }
 
+                    /**
+                     * Curve params providing an efficiently computable endomorphism phi(x, y) = (glv_beta * x, y),
+                     * which acts as multiplication by glv_lambda on the prime order subgroup.
+                     */
+                    template<typename CurveParams, typename = void>
+                    struct has_glv_endomorphism : std::false_type { };
+
+                    template<typename CurveParams>
+                    struct has_glv_endomorphism<CurveParams, std::void_t<decltype(CurveParams::glv_lambda)>>
+                        : std::true_type { };
+
+                    /**
+                     * GLV is valid for every point of the group only if the group has prime order. On curves with a
+                     * cofactor, e.g. BLS12-381 G1, points outside of the subgroup would be multiplied incorrectly,
+                     * there glv_scalar_mul_inplace has to be called explicitly for points known to be in it.
+                     */
+                    template<typename CurveParams, typename = void>
+                    struct has_prime_order_glv : std::false_type { };
+
+                    template<typename CurveParams>
+                    struct has_prime_order_glv<CurveParams, std::void_t<decltype(CurveParams::cofactor)>>
+                        : std::bool_constant<has_glv_endomorphism<CurveParams>::value && CurveParams::cofactor == 1> { };
+
+                    /**
+                     * GLV scalar multiplication, valid for points of the prime order subgroup only.
+                     *
+                     * The scalar k is split as k = k1 + k2 * lambda mod r with |k1|, |k2| about sqrt(r): with
+                     * (a1, b1), (a2, b2) a short basis of {(a, b) : a + b * lambda = 0 mod r} of determinant r,
+                     * c1 = round(b2 * k / r), c2 = round(-b1 * k / r) and k2 = -(c1 * b1 + c2 * b2). The quotients
+                     * are taken as (k * g) >> shift with precomputed g = round(2^shift * b / r), which may be off
+                     * by one and only makes k1, k2 slightly longer. Then k * P = k1 * P + k2 * phi(P) is computed
+                     * by interleaving the wNAFs of both halves, which takes half of the doublings of the plain
+                     * wNAF over the full scalar.
+                     */
+                    template<typename CurveElementType>
+                    constexpr void glv_scalar_mul_inplace(
+                            CurveElementType &base,
+                            typename CurveElementType::params_type::scalar_field_type::value_type const& scalar)
+                    {
+                        using params_type = typename CurveElementType::params_type;
+                        using scalar_field_type = typename params_type::scalar_field_type;
+                        using scalar_value_type = typename scalar_field_type::value_type;
+                        using scalar_integral_type = typename scalar_field_type::integral_type;
+                        using wide_integral_type = nil::crypto3::multiprecision::big_uint<2 * scalar_field_type::modulus_bits>;
+
+                        if (scalar.is_zero() || base.is_zero()) {
+                            base = CurveElementType::zero();
+                            return;
+                        }
+
+                        const scalar_integral_type k = static_cast<scalar_integral_type>(scalar.data);
+                        const auto rounded_quotient = [&k](scalar_integral_type const& g) {
+                            wide_integral_type product = wide_integral_type(k) * wide_integral_type(g);
+                            product += wide_integral_type(1u) << (params_type::glv_shift - 1);
+                            return scalar_value_type(static_cast<scalar_integral_type>(product >> params_type::glv_shift));
+                        };
+                        const scalar_value_type c1 = rounded_quotient(params_type::glv_g1);
+                        const scalar_value_type c2 = rounded_quotient(params_type::glv_g2);
+                        const scalar_value_type k2 = -(c1 * params_type::glv_b1 + c2 * params_type::glv_b2);
+                        const scalar_value_type k1 = scalar - params_type::glv_lambda * k2;
+
+                        // Halves as sign and magnitude, the magnitude is the smaller of v and r - v.
+                        const auto split_sign = [](scalar_value_type const& v, bool &negative) {
+                            scalar_integral_type magnitude = static_cast<scalar_integral_type>(v.data);
+                            negative = magnitude > scalar_field_type::modulus / 2;
+                            if (negative) {
+                                magnitude = scalar_field_type::modulus - magnitude;
+                            }
+                            return magnitude;
+                        };
+                        bool k1_negative = false, k2_negative = false;
+                        const scalar_integral_type k1_magnitude = split_sign(k1, k1_negative);
+                        const scalar_integral_type k2_magnitude = split_sign(k2, k2_negative);
+
+                        const size_t window_size = 3;
+                        auto naf1 = nil::crypto3::multiprecision::find_wnaf_a(window_size + 1, k1_magnitude);
+                        auto naf2 = nil::crypto3::multiprecision::find_wnaf_a(window_size + 1, k2_magnitude);
+
+                        // Odd multiples of P and of phi(P), phi is applied to the x coordinate of every entry.
+                        std::array<CurveElementType, 1ul << window_size > table1, table2;
+                        CurveElementType dbl = base;
+                        dbl.double_inplace();
+                        for (size_t i = 0; i < 1ul << window_size; ++i) {
+                            table1[i] = base;
+                            table2[i] = base;
+                            table2[i].X *= params_type::glv_beta;
+                            base += dbl;
+                        }
+
+                        const auto add_digit = [](CurveElementType &acc, std::array<CurveElementType, 1ul << window_size> const& table,
+                                                  long digit, bool negative) {
+                            if ((digit > 0) != negative) {
+                                acc += table[(digit > 0 ? digit : -digit) / 2];
+                            } else {
+                                acc -= table[(digit > 0 ? digit : -digit) / 2];
+                            }
+                        };
+
+                        base = CurveElementType::zero();
+                        bool found_nonzero = false;
+                        for (long i = naf1.size() - 1; i >= 0; --i) {
+                            if (found_nonzero) {
+                                base.double_inplace();
+                            }
+
+                            if (naf1[i] != 0) {
+                                found_nonzero = true;
+                                add_digit(base, table1, naf1[i], k1_negative);
+                            }
+                            if (naf2[i] != 0) {
+                                found_nonzero = true;
+                                add_digit(base, table2, naf2[i], k2_negative);
+                            }
+                        }
+                    }
+
+                    /**
+                     * Multiplication by a scalar field element, takes the GLV path on prime order curves providing one.
+                     */
+                    template<typename CurveElementType>
+                    constexpr void scalar_field_mul_inplace(
+                            CurveElementType &point,
+                            typename CurveElementType::params_type::scalar_field_type::value_type const& scalar)
+                    {
+                        if constexpr (has_prime_order_glv<typename CurveElementType::params_type>::value) {
+                            glv_scalar_mul_inplace(point, scalar);
+                        } else {
+                            using scalar_integral_type = typename CurveElementType::params_type::scalar_field_type::integral_type;
+                            scalar_mul_inplace(point, static_cast<scalar_integral_type>(scalar.data));
+                        }
+                    }
+
                     template<typename CurveElementType>
                     constexpr CurveElementType& operator *= (
                             CurveElementType& point,
                             typename CurveElementType::params_type::scalar_field_type::value_type const& scalar)
                     {
-                        using scalar_integral_type = typename CurveElementType::params_type::scalar_field_type::integral_type;
-                        scalar_mul_inplace(point, static_cast<scalar_integral_type>(scalar.data));
+                        scalar_field_mul_inplace(point, scalar);
                         return point;
                     }
 
@@ -94,9 +228,8 @@ namespace nil {
                             CurveElementType const& point,
                             typename CurveElementType::params_type::scalar_field_type::value_type const& scalar)
                     {
-                        using scalar_integral_type = typename CurveElementType::params_type::scalar_field_type::integral_type;
                         CurveElementType res = point;
-                        scalar_mul_inplace(res, static_cast<scalar_integral_type>(scalar.data));
+                        scalar_field_mul_inplace(res, scalar);
                         return res;
                     }
 
@@ -105,9 +238,8 @@ namespace nil {
                             typename CurveElementType::params_type::scalar_field_type::value_type const& scalar,
                             CurveElementType const& point)
                     {
-                        using scalar_integral_type = typename CurveElementType::params_type::scalar_field_type::integral_type;
                         CurveElementType res = point;
-                        scalar_mul_inplace(res, static_cast<scalar_integral_type>(scalar.data));
+                        scalar_field_mul_inplace(res, scalar);
                         return res;
                     }
 
@@ -0,0 +1,146 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ALGEBRA_MULTIEXP_BATCH_NORMALIZE_HPP
+#define CRYPTO3_ALGEBRA_MULTIEXP_BATCH_NORMALIZE_HPP
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <nil/crypto3/algebra/curves/detail/forms/short_weierstrass/coordinates.hpp>
+#include <nil/crypto3/algebra/curves/detail/forms/twisted_edwards/coordinates.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace algebra {
+            namespace detail {
+
+                /** @brief Brings a point with non-zero Z to the representation with Z = 1,
+                 *  given the inverse of Z.
+                 */
+                template<typename CurveElementType>
+                constexpr void normalize_with_inverse(
+                        CurveElementType &point,
+                        const typename CurveElementType::field_type::value_type &z_inversed) {
+
+                    using coordinates_type = typename CurveElementType::coordinates;
+
+                    if constexpr (std::is_same_v<coordinates_type, curves::coordinates::jacobian> ||
+                                  std::is_same_v<coordinates_type, curves::coordinates::jacobian_with_a4_0> ||
+                                  std::is_same_v<coordinates_type, curves::coordinates::jacobian_with_a4_minus_3>) {
+                        auto z_inversed_squared = z_inversed.squared();
+                        point.X *= z_inversed_squared;    //  x=X/Z^2
+                        point.Y *= z_inversed_squared * z_inversed;    //  y=Y/Z^3
+                    } else if constexpr (std::is_same_v<coordinates_type, curves::coordinates::projective> ||
+                                         std::is_same_v<coordinates_type,
+                                                        curves::coordinates::projective_with_a4_minus_3>) {
+                        point.X *= z_inversed;    //  x=X/Z
+                        point.Y *= z_inversed;    //  y=Y/Z
+                    } else if constexpr (std::is_same_v<coordinates_type,
+                                                        curves::coordinates::extended_with_a_minus_1>) {
+                        point.X *= z_inversed;    //  x=X/Z
+                        point.Y *= z_inversed;    //  y=Y/Z
+                        point.T *= z_inversed;    //  x*y=T/Z
+                    } else {
+                        static_assert(!std::is_same_v<coordinates_type, coordinates_type>,
+                                      "Batch normalization is not defined for these coordinates");
+                    }
+                    point.Z = CurveElementType::field_type::value_type::one();
+                }
+
+                /** @brief Montgomery's trick over [first, last), points with Z = 0 are skipped.
+                 */
+                template<typename InputIterator>
+                void batch_normalize_range(InputIterator first, InputIterator last) {
+
+                    using curve_element_type = typename std::iterator_traits<InputIterator>::value_type;
+                    using field_value_type = typename curve_element_type::field_type::value_type;
+
+                    const std::size_t size = std::distance(first, last);
+
+                    // prefix_products[i] is the product of all non-zero Z before point i.
+                    std::vector<field_value_type> prefix_products(size);
+                    field_value_type accumulator = field_value_type::one();
+                    for (std::size_t i = 0; i < size; ++i) {
+                        prefix_products[i] = accumulator;
+                        if (!first[i].Z.is_zero()) {
+                            accumulator *= first[i].Z;
+                        }
+                    }
+
+                    accumulator = accumulator.inversed();
+
+                    for (std::size_t i = size; i-- > 0;) {
+                        if (first[i].Z.is_zero()) {
+                            continue;
+                        }
+                        field_value_type z_inversed = accumulator * prefix_products[i];
+                        accumulator *= first[i].Z;
+                        normalize_with_inverse(first[i], z_inversed);
+                    }
+                }
+            }    // namespace detail
+
+            /** @brief Brings all the points in [first, last) to the representation with Z = 1
+             *  using one field inversion. Points at infinity are left untouched, affine points
+             *  are normalized already.
+             */
+            template<typename InputIterator>
+            void batch_normalize(InputIterator first, InputIterator last) {
+                using curve_element_type = typename std::iterator_traits<InputIterator>::value_type;
+
+                if constexpr (!std::is_same_v<typename curve_element_type::coordinates,
+                                              curves::coordinates::affine>) {
+                    detail::batch_normalize_range(first, last);
+                }
+            }
+
+            template<typename InputRange>
+            void batch_normalize(InputRange &points) {
+                batch_normalize(std::begin(points), std::end(points));
+            }
+
+            /** @brief Affine representation of every point, with one field inversion for the whole range.
+             */
+            template<typename InputRange>
+            auto batch_to_affine(const InputRange &points) {
+                using curve_element_type = typename InputRange::value_type;
+                using affine_value_type = decltype(std::declval<const curve_element_type &>().to_affine());
+
+                std::vector<curve_element_type> normalized(std::begin(points), std::end(points));
+                batch_normalize(normalized);
+
+                std::vector<affine_value_type> result;
+                result.reserve(normalized.size());
+                for (const auto &point : normalized) {
+                    // Z is one or the point is zero, to_affine does not invert.
+                    result.emplace_back(point.to_affine());
+                }
+                return result;
+            }
+        }    // namespace algebra
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ALGEBRA_MULTIEXP_BATCH_NORMALIZE_HPP
@@ -0,0 +1,193 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ALGEBRA_MULTIEXP_FIXED_BASE_HPP
+#define CRYPTO3_ALGEBRA_MULTIEXP_FIXED_BASE_HPP
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <nil/crypto3/algebra/multiexp/batch_normalize.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace algebra {
+
+            constexpr static const std::size_t fixed_base_max_window_size = 16;
+
+            /** @brief Window size minimizing the work of building a fixed_base_table and
+             *  multiplying it by scalars_amount scalars of scalar_size bits.
+             */
+            inline std::size_t get_fixed_base_window_size(std::size_t scalar_size, std::size_t scalars_amount) {
+                std::size_t best_window = 1;
+                std::size_t best_cost = 0;
+                for (std::size_t window = 1; window <= fixed_base_max_window_size; ++window) {
+                    std::size_t cost = (scalar_size / window + 1) * (scalars_amount + (std::size_t(1) << (window - 1)));
+                    if (window == 1 || cost < best_cost) {
+                        best_cost = cost;
+                        best_window = window;
+                    }
+                }
+                return best_window;
+            }
+
+            /** @brief Precomputed multiples of a fixed base point.
+             *
+             *  The scalar is recoded into signed digits d_j in [-2^{w-1}, 2^{w-1}] of w bits each,
+             *  and the table holds d * 2^{w*j} * base for every window j and every d in [1, 2^{w-1}].
+             *  A multiplication then takes one addition per window and no doublings.
+             *  Table entries are kept normalized to Z = 1.
+             */
+            template<typename GroupType>
+            class fixed_base_table {
+            public:
+                using group_type = GroupType;
+                using value_type = typename group_type::value_type;
+                using scalar_field_type = typename group_type::curve_type::scalar_field_type;
+                using scalar_value_type = typename scalar_field_type::value_type;
+                using integral_type = typename scalar_field_type::integral_type;
+
+                constexpr static const std::size_t scalar_size = scalar_field_type::modulus_bits;
+
+                fixed_base_table(const value_type &base, std::size_t window) : window_size(window) {
+                    if (window_size == 0 || window_size > fixed_base_max_window_size) {
+                        throw std::invalid_argument("fixed_base_table: unsupported window size");
+                    }
+
+                    const std::size_t half = half_window();
+                    table.resize(windows_amount() * half);
+
+                    value_type window_base = base;
+                    for (std::size_t j = 0; j < windows_amount(); ++j) {
+                        value_type multiple = window_base;
+                        table[j * half] = multiple;
+                        for (std::size_t d = 2; d <= half; ++d) {
+                            multiple += window_base;
+                            table[j * half + d - 1] = multiple;
+                        }
+                        // 2^{w-1} * 2^{w*j} * base doubled once is the base of the next window.
+                        window_base = multiple;
+                        window_base.double_inplace();
+                    }
+
+                    batch_normalize(table);
+                }
+
+                /** @brief Restores a table from its entries, e.g. after unmarshalling.
+                 */
+                fixed_base_table(std::size_t window, std::vector<value_type> &&entries)
+                    : window_size(window), table(std::move(entries)) {
+                    if (window_size == 0 || window_size > fixed_base_max_window_size ||
+                        table.size() != windows_amount() * half_window()) {
+                        throw std::invalid_argument("fixed_base_table: entries do not match the window size");
+                    }
+                }
+
+                value_type operator()(const scalar_value_type &scalar) const {
+                    const integral_type k = static_cast<integral_type>(scalar.data);
+                    const integral_type mask = (integral_type(1u) << window_size) - 1u;
+                    const std::size_t half = half_window();
+
+                    value_type result = value_type::zero();
+                    std::size_t carry = 0;
+                    for (std::size_t j = 0; j < windows_amount(); ++j) {
+                        std::size_t digit =
+                            static_cast<std::uint64_t>((k >> (j * window_size)) & mask) + carry;
+                        if (digit > half) {
+                            // digit - 2^w is negative, borrow 2^w from the next window.
+                            carry = 1;
+                            digit = (std::size_t(1) << window_size) - digit;
+                            if (digit != 0) {
+                                result -= table[j * half + digit - 1];
+                            }
+                        } else {
+                            carry = 0;
+                            if (digit != 0) {
+                                result += table[j * half + digit - 1];
+                            }
+                        }
+                    }
+                    return result;
+                }
+
+                std::size_t window() const {
+                    return window_size;
+                }
+
+                const std::vector<value_type> &entries() const {
+                    return table;
+                }
+
+                /** @brief Amount of windows, the top one absorbs the carry of the signed recoding.
+                 */
+                std::size_t windows_amount() const {
+                    return scalar_size / window_size + 1;
+                }
+
+            private:
+                std::size_t half_window() const {
+                    return std::size_t(1) << (window_size - 1);
+                }
+
+                std::size_t window_size;
+                std::vector<value_type> table;
+            };
+
+            /** @brief Multiplies the table base by every scalar, the results are normalized to Z = 1.
+             */
+            template<typename GroupType, typename InputRange>
+            std::vector<typename GroupType::value_type> fixed_base_batch_exp(const fixed_base_table<GroupType> &table,
+                                                                             const InputRange &scalars) {
+                std::vector<typename GroupType::value_type> result;
+                result.reserve(std::size(scalars));
+                for (const auto &scalar : scalars) {
+                    result.emplace_back(table(scalar));
+                }
+                batch_normalize(result);
+                return result;
+            }
+
+            /** @brief Computes base * alpha^i for i in [0, n), as used for structured reference strings.
+             */
+            template<typename GroupType>
+            std::vector<typename GroupType::value_type>
+                fixed_base_powers(const typename GroupType::value_type &base,
+                                  const typename GroupType::curve_type::scalar_field_type::value_type &alpha,
+                                  std::size_t n) {
+                using scalar_field_type = typename GroupType::curve_type::scalar_field_type;
+
+                std::vector<typename scalar_field_type::value_type> powers(n);
+                typename scalar_field_type::value_type power = scalar_field_type::value_type::one();
+                for (std::size_t i = 0; i < n; ++i) {
+                    powers[i] = power;
+                    power *= alpha;
+                }
+
+                fixed_base_table<GroupType> table(base, get_fixed_base_window_size(scalar_field_type::modulus_bits, n));
+                return fixed_base_batch_exp(table, powers);
+            }
+        }    // namespace algebra
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ALGEBRA_MULTIEXP_FIXED_BASE_HPP
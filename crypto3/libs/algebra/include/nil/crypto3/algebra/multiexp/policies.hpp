@@ -31,6 +31,7 @@
 #include <boost/assert.hpp>
 
 #include <nil/crypto3/algebra/wnaf.hpp>
+#include <nil/crypto3/algebra/multiexp/batch_normalize.hpp>
 
 namespace nil {
     namespace crypto3 {
@@ -92,7 +93,7 @@ namespace nil {
                  * (https://eprint.iacr.org/2012/549.pdf)
                  * When compiled with USE_MIXED_ADDITION, assumes input is in special form.
                  * Requires that base_value_type implements .dbl() (and, if USE_MIXED_ADDITION is defined,
-                 * .to_projective(), .mixed_add(), and batch_to_projective()).
+                 * .mixed_add() and coordinates supported by batch_normalize()).
                  */
                 struct multiexp_method_BDLO12 {
                     template<typename InputBaseIterator, typename InputFieldIterator>
@@ -165,7 +166,8 @@ namespace nil {
                             }
 
 #ifdef USE_MIXED_ADDITION
-                            batch_to_special(buckets);
+                            // One inversion for all buckets, zero buckets are skipped.
+                            batch_normalize(buckets);
 #endif
 
                             base_value_type running_sum;
@@ -57,6 +57,7 @@
 #include <nil/crypto3/algebra/curves/pallas.hpp>
 #include <nil/crypto3/algebra/fields/fp2.hpp>
 #include <nil/crypto3/algebra/fields/fp3.hpp>
+#include <nil/crypto3/algebra/random_element.hpp>
 
 #include <nil/crypto3/multiprecision/literals.hpp>
 
@@ -665,4 +666,76 @@ BOOST_AUTO_TEST_CASE(twisted_edwards_extended_order_test) {
     BOOST_CHECK_EQUAL(check, g1_type::value_type::zero());
 }
 
+/*
+ * GLV scalar multiplication against the plain wNAF over the full scalar
+ */
+template<typename CurveType, typename Coordinates>
+class glv_scalar_mul_runner {
+    using g1_type = typename CurveType::template g1_type<Coordinates>;
+    using params_type = typename g1_type::params_type;
+    using point_type = typename g1_type::value_type;
+    using scalar_field_type = typename CurveType::scalar_field_type;
+    using scalar_type = typename scalar_field_type::value_type;
+    using scalar_integral_type = typename scalar_field_type::integral_type;
+
+    static point_type plain_mul(point_type point, const scalar_type &scalar) {
+        curves::detail::scalar_mul_inplace(point, static_cast<scalar_integral_type>(scalar.data));
+        return point;
+    }
+
+    static point_type glv_mul(point_type point, const scalar_type &scalar) {
+        curves::detail::glv_scalar_mul_inplace(point, scalar);
+        return point;
+    }
+
+    public:
+    bool static run() {
+        static_assert(curves::detail::has_glv_endomorphism<params_type>::value);
+
+        point_type generator = point_type::one();
+        point_type endomorphism = generator;
+        endomorphism.X *= params_type::glv_beta;
+        BOOST_CHECK_EQUAL(endomorphism, plain_mul(generator, params_type::glv_lambda));
+
+        std::vector<scalar_type> scalars = {
+            scalar_type::zero(), scalar_type::one(), -scalar_type::one(), scalar_type(2u),
+            params_type::glv_lambda, -params_type::glv_lambda, params_type::glv_b1, params_type::glv_b2};
+        for (std::size_t i = 0; i < 32; ++i) {
+            scalars.push_back(random_element<scalar_field_type>());
+        }
+
+        for (std::size_t i = 0; i < 4; ++i) {
+            point_type point = plain_mul(generator, random_element<scalar_field_type>());
+            for (const auto &scalar : scalars) {
+                BOOST_CHECK_EQUAL(glv_mul(point, scalar), plain_mul(point, scalar));
+                BOOST_CHECK_EQUAL(point * scalar, plain_mul(point, scalar));
+            }
+        }
+        BOOST_CHECK_EQUAL(glv_mul(point_type::zero(), scalars.back()), point_type::zero());
+        return true;
+    }
+};
+
+using glv_scalar_mul_runners = boost::mpl::list<
+    glv_scalar_mul_runner<curves::pallas, curves::coordinates::jacobian_with_a4_0>,
+    glv_scalar_mul_runner<curves::pallas, curves::coordinates::affine>,
+    glv_scalar_mul_runner<curves::vesta, curves::coordinates::jacobian_with_a4_0>,
+    glv_scalar_mul_runner<curves::secp256k1, curves::coordinates::jacobian_with_a4_0>,
+    glv_scalar_mul_runner<curves::alt_bn128_254, curves::coordinates::jacobian_with_a4_0>,
+    glv_scalar_mul_runner<curves::bls12_381, curves::coordinates::jacobian_with_a4_0> >;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(glv_scalar_mul_test, runner, glv_scalar_mul_runners) {
+    BOOST_CHECK(runner::run());
+}
+
+BOOST_AUTO_TEST_CASE(glv_prime_order_test) {
+    // operator * takes the GLV path only where it is valid for points outside of the prime order subgroup too
+    static_assert(curves::detail::has_prime_order_glv<curves::pallas::g1_type<>::params_type>::value);
+    static_assert(curves::detail::has_prime_order_glv<curves::vesta::g1_type<>::params_type>::value);
+    static_assert(curves::detail::has_prime_order_glv<curves::secp256k1::g1_type<>::params_type>::value);
+    static_assert(curves::detail::has_prime_order_glv<curves::alt_bn128_254::g1_type<>::params_type>::value);
+    static_assert(!curves::detail::has_prime_order_glv<curves::bls12_381::g1_type<>::params_type>::value);
+    static_assert(!curves::detail::has_prime_order_glv<curves::jubjub::g1_type<>::params_type>::value);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
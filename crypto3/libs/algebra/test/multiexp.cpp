@@ -38,6 +38,8 @@
 #include <nil/crypto3/algebra/random_element.hpp>
 
 #include <nil/crypto3/algebra/multiexp/policies.hpp>
+#include <nil/crypto3/algebra/multiexp/batch_normalize.hpp>
+#include <nil/crypto3/algebra/multiexp/fixed_base.hpp>
 
 #include <nil/crypto3/algebra/curves/params/wnaf/alt_bn128.hpp>
 #include <nil/crypto3/algebra/curves/params/wnaf/bls12.hpp>
@@ -116,4 +118,114 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(multiexp_test, runner, multiexp_runners) {
     BOOST_CHECK(runner::run());
 }
 
+template<typename curve_group_type>
+class fixed_base_runner {
+    public:
+    bool static run() {
+        using point = typename curve_group_type::value_type;
+        using scalar = typename curve_group_type::params_type::scalar_field_type;
+
+        std::size_t N = 16;
+
+        point base = random_element<curve_group_type>();
+        std::vector<typename scalar::value_type> scalars(N);
+
+        for(auto & s: scalars) {
+            s = random_element<scalar>();
+        }
+        scalars[0] = scalar::value_type::zero();
+        scalars[1] = scalar::value_type::one();
+        scalars[2] = -scalar::value_type::one();
+
+        bool result = true;
+        for (std::size_t window : {1, 4, 7}) {
+            fixed_base_table<curve_group_type> table(base, window);
+            fixed_base_table<curve_group_type> restored(table.window(), std::vector<point>(table.entries()));
+
+            std::vector<point> batch_result = fixed_base_batch_exp(restored, scalars);
+
+            for (std::size_t i = 0; i < N; ++i) {
+                point expected = base * scalars[i];
+                BOOST_CHECK_EQUAL(table(scalars[i]), expected);
+                BOOST_CHECK_EQUAL(batch_result[i], expected);
+                BOOST_CHECK(batch_result[i].is_zero() || batch_result[i].Z == point::field_type::value_type::one());
+                result = result && (batch_result[i] == expected);
+            }
+        }
+
+        std::vector<point> powers = fixed_base_powers<curve_group_type>(base, scalars[3], N);
+        point expected = base;
+        for (std::size_t i = 0; i < N; ++i) {
+            BOOST_CHECK_EQUAL(powers[i], expected);
+            result = result && (powers[i] == expected);
+            expected = expected * scalars[3];
+        }
+
+        return result;
+    }
+};
+
+using fixed_base_runners = boost::mpl::list<
+    fixed_base_runner<curves::alt_bn128_254::template g1_type<>>,
+    fixed_base_runner<curves::alt_bn128_254::template g2_type<>>,
+
+    fixed_base_runner<curves::bls12_381::template g1_type<>>,
+    fixed_base_runner<curves::bls12_381::template g2_type<>>,
+
+    fixed_base_runner<curves::mnt4_298::template g1_type<>>,
+    fixed_base_runner<curves::mnt6_298::template g1_type<>>
+    >;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(fixed_base_test, runner, fixed_base_runners) {
+    BOOST_CHECK(runner::run());
+}
+
+template<typename curve_group_type>
+class batch_normalize_runner {
+    public:
+    bool static run() {
+        using point = typename curve_group_type::value_type;
+
+        std::size_t N = 16;
+
+        std::vector<point> points(N);
+        for(auto & p: points) {
+            p = random_element<curve_group_type>();
+            p.double_inplace();
+        }
+        points[0] = point::zero();
+        points[N / 2] = point::zero();
+
+        auto affine_points = batch_to_affine(points);
+
+        std::vector<point> normalized = points;
+        batch_normalize(normalized);
+
+        bool result = true;
+        for (std::size_t i = 0; i < N; ++i) {
+            BOOST_CHECK(affine_points[i] == points[i].to_affine());
+            BOOST_CHECK_EQUAL(normalized[i], points[i]);
+            BOOST_CHECK(normalized[i].is_zero() || normalized[i].Z == point::field_type::value_type::one());
+            result = result && (affine_points[i] == points[i].to_affine()) && (normalized[i] == points[i]);
+        }
+
+        return result;
+    }
+};
+
+using batch_normalize_runners = boost::mpl::list<
+    batch_normalize_runner<curves::alt_bn128_254::template g1_type<>>,
+    batch_normalize_runner<curves::alt_bn128_254::template g2_type<>>,
+
+    batch_normalize_runner<curves::bls12_381::template g1_type<>>,
+    batch_normalize_runner<curves::bls12_381::template g2_type<>>,
+
+    batch_normalize_runner<curves::mnt4_298::template g1_type<>>,
+    batch_normalize_runner<curves::mnt6_298::template g1_type<>>
+    >;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(batch_normalize_test, runner, batch_normalize_runners) {
+    BOOST_CHECK(runner::run());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
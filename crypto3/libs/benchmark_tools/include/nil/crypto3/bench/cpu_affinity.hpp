@@ -0,0 +1,309 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2025 Nil Foundation AG
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_BENCH_CPU_AFFINITY_HPP
+#define CRYPTO3_BENCH_CPU_AFFINITY_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace nil {
+    namespace crypto3 {
+        namespace bench {
+
+            enum class thread_pinning {
+                // Workers may run on any CPU of the process.
+                none,
+                // Every worker is pinned to its own CPU.
+                core,
+                // Every worker is pinned to all CPUs of its socket.
+                socket
+            };
+
+            inline std::optional<thread_pinning> parse_thread_pinning(std::string_view name) {
+                if (name == "none") {
+                    return thread_pinning::none;
+                }
+                if (name == "core") {
+                    return thread_pinning::core;
+                }
+                if (name == "socket") {
+                    return thread_pinning::socket;
+                }
+                return std::nullopt;
+            }
+
+            // Parses lists in the sysfs and taskset format, e.g. "0-15,32-47".
+            inline std::optional<std::vector<unsigned>> parse_cpu_list(std::string_view list) {
+                std::vector<unsigned> cpus;
+                while (!list.empty()) {
+                    const std::size_t comma = std::min(list.find(','), list.size());
+                    const std::string range(list.substr(0, comma));
+                    list.remove_prefix(std::min(comma + 1, list.size()));
+
+                    const std::size_t dash = range.find('-');
+                    unsigned first, last;
+                    try {
+                        std::size_t parsed;
+                        first = std::stoul(range.substr(0, dash), &parsed);
+                        if (parsed != std::min(dash, range.size())) {
+                            return std::nullopt;
+                        }
+                        last = first;
+                        if (dash != std::string::npos) {
+                            last = std::stoul(range.substr(dash + 1), &parsed);
+                            if (parsed != range.size() - dash - 1) {
+                                return std::nullopt;
+                            }
+                        }
+                    } catch (const std::exception&) {
+                        return std::nullopt;
+                    }
+                    if (last < first) {
+                        return std::nullopt;
+                    }
+                    for (unsigned cpu = first; cpu <= last; ++cpu) {
+                        cpus.push_back(cpu);
+                    }
+                }
+                std::sort(cpus.begin(), cpus.end());
+                cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+                return cpus;
+            }
+
+            // Reads a list file of sysfs, e.g. /sys/devices/system/node/online.
+            inline std::optional<std::vector<unsigned>> read_cpu_list(const std::string& file_name) {
+                std::ifstream in(file_name);
+                std::string list;
+                if (!(in >> list)) {
+                    return std::nullopt;
+                }
+                return parse_cpu_list(list);
+            }
+
+            struct cpu_info {
+                unsigned cpu;
+                unsigned socket;
+                unsigned core;
+                unsigned node;
+            };
+
+            struct cpu_affinity_options {
+                thread_pinning pinning = thread_pinning::none;
+                // Only one hardware thread of every core gets a worker.
+                bool skip_smt_siblings = false;
+                // CPUs the whole process is restricted to, all CPUs it may run on if empty.
+                std::vector<unsigned> cpu_set;
+            };
+
+            // Placement of thread pool workers. Configured once at startup, before the thread pools are created,
+            // and read by the pools when they start their workers. Pool sizes default to worker_count(), so two
+            // processes restricted to disjoint CPU sets, e.g. one per socket, don't oversubscribe the host.
+            class cpu_affinity {
+            public:
+                static cpu_affinity& instance() {
+                    // Never destroyed, thread pools read it until the very end of the process.
+                    alignas(cpu_affinity) static unsigned char storage[sizeof(cpu_affinity)];
+                    static cpu_affinity* instance = new (storage) cpu_affinity();
+                    return *instance;
+                }
+
+                // Restricts the process to options.cpu_set, threads started afterwards inherit it.
+                // Returns false if the set has CPUs the process may not run on or can't be applied.
+                bool configure(const cpu_affinity_options& options) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    auto topology = read_topology();
+                    if (!options.cpu_set.empty()) {
+                        for (unsigned cpu : options.cpu_set) {
+                            if (std::none_of(topology.begin(), topology.end(),
+                                             [cpu](const cpu_info& info) { return info.cpu == cpu; })) {
+                                return false;
+                            }
+                        }
+                        if (!set_current_thread_cpus(options.cpu_set)) {
+                            return false;
+                        }
+                        topology.erase(std::remove_if(topology.begin(), topology.end(),
+                                                      [&options](const cpu_info& info) {
+                                                          return !std::binary_search(options.cpu_set.begin(),
+                                                                                     options.cpu_set.end(), info.cpu);
+                                                      }),
+                                       topology.end());
+                    }
+                    workers = select_worker_cpus(topology, options);
+                    configured = true;
+                    return true;
+                }
+
+                // Number of workers a thread pool starts by default.
+                std::size_t worker_count() {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!configured) {
+                        workers = select_worker_cpus(read_topology(), {});
+                        configured = true;
+                    }
+                    return std::max<std::size_t>(workers.size(), 1);
+                }
+
+                // CPUs worker i of a pool is pinned to, empty if it is not pinned.
+                std::vector<unsigned> worker_cpus(std::size_t worker) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!configured || workers.empty()) {
+                        return {};
+                    }
+                    return workers[worker % workers.size()];
+                }
+
+                // Returns the CPU sets of the workers, in the order of sockets and cores, so that workers with
+                // consecutive ids share a socket and get adjacent chunks of parallel loops. Without pinning the
+                // sets are empty and only their number matters.
+                static std::vector<std::vector<unsigned>> select_worker_cpus(std::vector<cpu_info> topology,
+                                                                             const cpu_affinity_options& options) {
+                    std::sort(topology.begin(), topology.end(), [](const cpu_info& a, const cpu_info& b) {
+                        return std::tie(a.socket, a.core, a.cpu) < std::tie(b.socket, b.core, b.cpu);
+                    });
+                    if (options.skip_smt_siblings) {
+                        topology.erase(std::unique(topology.begin(), topology.end(),
+                                                   [](const cpu_info& a, const cpu_info& b) {
+                                                       return a.socket == b.socket && a.core == b.core;
+                                                   }),
+                                       topology.end());
+                    }
+
+                    std::vector<std::vector<unsigned>> result(topology.size());
+                    for (std::size_t i = 0; i < topology.size(); ++i) {
+                        switch (options.pinning) {
+                            case thread_pinning::none:
+                                break;
+                            case thread_pinning::core:
+                                result[i].push_back(topology[i].cpu);
+                                break;
+                            case thread_pinning::socket:
+                                for (const auto& info : topology) {
+                                    if (info.socket == topology[i].socket) {
+                                        result[i].push_back(info.cpu);
+                                    }
+                                }
+                                break;
+                        }
+                    }
+                    return result;
+                }
+
+                // CPUs the calling thread may run on with their sockets, cores and NUMA nodes.
+                static std::vector<cpu_info> read_topology() {
+                    std::vector<unsigned> cpus;
+#if defined(__linux__)
+                    cpu_set_t mask;
+                    CPU_ZERO(&mask);
+                    if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+                        for (unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                            if (CPU_ISSET(cpu, &mask)) {
+                                cpus.push_back(cpu);
+                            }
+                        }
+                    }
+#endif
+                    if (cpus.empty()) {
+                        for (unsigned cpu = 0; cpu < std::max(std::thread::hardware_concurrency(), 1u); ++cpu) {
+                            cpus.push_back(cpu);
+                        }
+                    }
+
+                    std::vector<unsigned> cpu_nodes;
+                    for (unsigned node : read_cpu_list("/sys/devices/system/node/online").value_or(std::vector<unsigned>())) {
+                        const auto node_cpus = read_cpu_list("/sys/devices/system/node/node" + std::to_string(node) +
+                                                             "/cpulist");
+                        if (!node_cpus) {
+                            continue;
+                        }
+                        for (unsigned cpu : *node_cpus) {
+                            if (cpu_nodes.size() <= cpu) {
+                                cpu_nodes.resize(cpu + 1, 0);
+                            }
+                            cpu_nodes[cpu] = node;
+                        }
+                    }
+
+                    std::vector<cpu_info> topology;
+                    for (unsigned cpu : cpus) {
+                        const std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+                        cpu_info info{cpu, read_number(path + "physical_package_id").value_or(0),
+                                      read_number(path + "core_id").value_or(cpu),
+                                      cpu < cpu_nodes.size() ? cpu_nodes[cpu] : 0};
+                        topology.push_back(info);
+                    }
+                    return topology;
+                }
+
+                static bool set_current_thread_cpus(const std::vector<unsigned>& cpus) {
+#if defined(__linux__)
+                    cpu_set_t mask;
+                    CPU_ZERO(&mask);
+                    for (unsigned cpu : cpus) {
+                        if (cpu >= CPU_SETSIZE) {
+                            return false;
+                        }
+                        CPU_SET(cpu, &mask);
+                    }
+                    return sched_setaffinity(0, sizeof(mask), &mask) == 0;
+#else
+                    return cpus.empty();
+#endif
+                }
+
+            private:
+                cpu_affinity() = default;
+
+                static std::optional<unsigned> read_number(const std::string& file_name) {
+                    std::ifstream in(file_name);
+                    unsigned value;
+                    if (!(in >> value)) {
+                        return std::nullopt;
+                    }
+                    return value;
+                }
+
+                std::mutex mutex;
+                bool configured = false;
+                std::vector<std::vector<unsigned>> workers;
+            };
+        }    // namespace bench
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_BENCH_CPU_AFFINITY_HPP
@@ -0,0 +1,297 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2025 Nil Foundation AG
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_BENCH_MEMORY_STATS_HPP
+#define CRYPTO3_BENCH_MEMORY_STATS_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace nil {
+    namespace crypto3 {
+        namespace bench {
+
+            struct memory_stage_stats {
+                std::string name;
+                std::int64_t live_bytes_before;
+                std::int64_t live_bytes_after;
+                std::int64_t peak_live_bytes;
+                std::uint64_t allocations;
+                std::uint64_t allocated_bytes;
+            };
+
+            // Heap accounting of the process. Allocations are counted by the replacement operator new and delete
+            // from memory_stats_new_delete.hpp, which an executable includes in one of its translation units.
+            // Without it all counters stay zero. Polynomials, merkle trees and commitment batches all keep their
+            // storage on the heap, so their live bytes and the high-water mark are covered without changing
+            // their container types.
+            //
+            // Nothing is counted until enable() is called, so that operator new and delete cost a flag check
+            // only when no report is asked for. Live bytes are relative to the moment counting started: blocks
+            // allocated before it and freed while counting are subtracted and may take them below zero.
+            class memory_stats {
+            public:
+                static memory_stats& instance() {
+                    // Constructed in static storage, since it is called from operator new itself, and never
+                    // destroyed, since operator delete may run after static objects are gone.
+                    alignas(memory_stats) static unsigned char storage[sizeof(memory_stats)];
+                    static memory_stats* instance = new (storage) memory_stats();
+                    return *instance;
+                }
+
+                static bool enabled() {
+                    return instance().is_enabled.load(std::memory_order_relaxed);
+                }
+
+                // Allocations are counted and stages recorded only while enabled.
+                void enable() {
+                    is_enabled.store(true, std::memory_order_relaxed);
+                }
+
+                void disable() {
+                    is_enabled.store(false, std::memory_order_relaxed);
+                }
+
+                void on_allocate(std::uint64_t size) {
+                    const std::int64_t live = live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+                    allocations.fetch_add(1, std::memory_order_relaxed);
+                    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+                    raise(peak_live_bytes, live);
+                    for (std::uint64_t scopes = active_scopes.load(std::memory_order_relaxed); scopes != 0;
+                         scopes &= scopes - 1) {
+                        raise(scope_peaks[__builtin_ctzll(scopes)], live);
+                    }
+                }
+
+                void on_deallocate(std::uint64_t size) {
+                    live_bytes.fetch_sub(size, std::memory_order_relaxed);
+                }
+
+                std::int64_t get_live_bytes() const {
+                    return live_bytes.load(std::memory_order_relaxed);
+                }
+
+                // High-water mark of the process since counting started.
+                std::int64_t get_peak_live_bytes() const {
+                    return peak_live_bytes.load(std::memory_order_relaxed);
+                }
+
+                std::uint64_t get_allocations() const {
+                    return allocations.load(std::memory_order_relaxed);
+                }
+
+                std::uint64_t get_allocated_bytes() const {
+                    return allocated_bytes.load(std::memory_order_relaxed);
+                }
+
+                // Starts tracking a high-water mark of its own, from the current live bytes, for a scope that
+                // may overlap others in any order and on any thread. Returns the slot of the mark, or -1 if all
+                // max_scopes slots are taken.
+                int open_scope() {
+                    std::uint64_t claimed = claimed_scopes.load(std::memory_order_relaxed);
+                    while (true) {
+                        if (~claimed == 0) {
+                            return -1;
+                        }
+                        const int slot = __builtin_ctzll(~claimed);
+                        if (claimed_scopes.compare_exchange_weak(claimed, claimed | (std::uint64_t(1) << slot),
+                                                                 std::memory_order_relaxed)) {
+                            scope_peaks[slot].store(get_live_bytes(), std::memory_order_relaxed);
+                            active_scopes.fetch_or(std::uint64_t(1) << slot, std::memory_order_relaxed);
+                            return slot;
+                        }
+                    }
+                }
+
+                std::int64_t get_scope_peak(int slot) const {
+                    return scope_peaks[slot].load(std::memory_order_relaxed);
+                }
+
+                // Stops tracking the mark of open_scope and returns it.
+                std::int64_t close_scope(int slot) {
+                    active_scopes.fetch_and(~(std::uint64_t(1) << slot), std::memory_order_relaxed);
+                    const std::int64_t peak = get_scope_peak(slot);
+                    claimed_scopes.fetch_and(~(std::uint64_t(1) << slot), std::memory_order_relaxed);
+                    return peak;
+                }
+
+                static constexpr int max_scopes = 64;
+
+                void add_stage(memory_stage_stats&& stage) {
+                    std::lock_guard<std::mutex> lock(stages_mutex);
+                    stages.push_back(std::move(stage));
+                }
+
+                std::vector<memory_stage_stats> get_stages() const {
+                    std::lock_guard<std::mutex> lock(stages_mutex);
+                    return stages;
+                }
+
+                // Peak resident set size of the process in bytes, 0 if unknown.
+                static std::uint64_t peak_rss_bytes() {
+#if defined(__unix__) || defined(__APPLE__)
+                    struct rusage usage;
+                    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+                        return static_cast<std::uint64_t>(usage.ru_maxrss);
+#else
+                        return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+                    }
+#endif
+                    return 0;
+                }
+
+                // Stages are listed in the order they finished, nested stages before the enclosing ones.
+                void write_json_report(std::ostream& out) const {
+                    out << "{\n  \"peak_rss_bytes\": " << peak_rss_bytes()
+                        << ",\n  \"peak_live_bytes\": " << get_peak_live_bytes()
+                        << ",\n  \"allocations\": " << get_allocations()
+                        << ",\n  \"allocated_bytes\": " << get_allocated_bytes()
+                        << ",\n  \"stages\": [";
+                    const auto stages_copy = get_stages();
+                    for (std::size_t i = 0; i < stages_copy.size(); i++) {
+                        const auto& stage = stages_copy[i];
+                        out << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"";
+                        for (char c : stage.name) {
+                            if (c == '"' || c == '\\') {
+                                out << '\\';
+                            }
+                            out << (static_cast<unsigned char>(c) < 0x20 ? ' ' : c);
+                        }
+                        out << "\", \"live_bytes_before\": " << stage.live_bytes_before
+                            << ", \"live_bytes_after\": " << stage.live_bytes_after
+                            << ", \"peak_live_bytes\": " << stage.peak_live_bytes
+                            << ", \"allocations\": " << stage.allocations
+                            << ", \"allocated_bytes\": " << stage.allocated_bytes << "}";
+                    }
+                    out << "\n  ]\n}\n";
+                }
+
+                bool write_json_report(const std::string& file_name) const {
+                    std::ofstream out(file_name);
+                    if (!out.is_open()) {
+                        return false;
+                    }
+                    write_json_report(out);
+                    return out.good();
+                }
+
+            private:
+                memory_stats() = default;
+
+                static void raise(std::atomic<std::int64_t>& peak, std::int64_t value) {
+                    std::int64_t current = peak.load(std::memory_order_relaxed);
+                    while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+                    }
+                }
+
+                std::atomic<bool> is_enabled{false};
+                std::atomic<std::int64_t> live_bytes{0};
+                std::atomic<std::int64_t> peak_live_bytes{0};
+                // Slots of open_scope, a scope's mark is raised by allocations once its bit is active.
+                std::atomic<std::uint64_t> claimed_scopes{0};
+                std::atomic<std::uint64_t> active_scopes{0};
+                std::atomic<std::int64_t> scope_peaks[max_scopes] = {};
+                std::atomic<std::uint64_t> allocations{0};
+                std::atomic<std::uint64_t> allocated_bytes{0};
+
+                mutable std::mutex stages_mutex;
+                std::vector<memory_stage_stats> stages;
+            };
+
+            // Records the heap high-water mark between construction and destruction as a named stage. Live bytes
+            // are process wide, so the mark includes what stages running concurrently on other threads hold.
+            // Every stage has a mark of its own, they may end in any order. When more than max_scopes stages are
+            // open at once, the extra ones report the process high-water mark instead.
+            class memory_scope {
+            public:
+                explicit memory_scope(const char* name) {
+                    if (memory_stats::enabled()) {
+                        start(name);
+                    }
+                }
+
+                explicit memory_scope(const std::string& name) {
+                    if (memory_stats::enabled()) {
+                        start(name);
+                    }
+                }
+
+                memory_scope(const memory_scope&) = delete;
+                memory_scope& operator=(const memory_scope&) = delete;
+
+                ~memory_scope() {
+                    if (active) {
+                        memory_stats& stats = memory_stats::instance();
+                        stage.live_bytes_after = stats.get_live_bytes();
+                        stage.peak_live_bytes = slot >= 0 ? stats.close_scope(slot) : stats.get_peak_live_bytes();
+                        stage.allocations = stats.get_allocations() - stage.allocations;
+                        stage.allocated_bytes = stats.get_allocated_bytes() - stage.allocated_bytes;
+                        stats.add_stage(std::move(stage));
+                    }
+                }
+
+                bool is_active() const {
+                    return active;
+                }
+
+                // Peak of the stage so far, valid only for an active scope.
+                std::int64_t peak_live_bytes() const {
+                    const memory_stats& stats = memory_stats::instance();
+                    return slot >= 0 ? stats.get_scope_peak(slot) : stats.get_peak_live_bytes();
+                }
+
+            private:
+                void start(std::string stage_name) {
+                    memory_stats& stats = memory_stats::instance();
+                    stage.name = std::move(stage_name);
+                    slot = stats.open_scope();
+                    stage.live_bytes_before = stats.get_live_bytes();
+                    stage.allocations = stats.get_allocations();
+                    stage.allocated_bytes = stats.get_allocated_bytes();
+                    active = true;
+                }
+
+                bool active = false;
+                int slot = -1;
+                memory_stage_stats stage{};
+            };
+
+        }    // namespace bench
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_BENCH_MEMORY_STATS_HPP
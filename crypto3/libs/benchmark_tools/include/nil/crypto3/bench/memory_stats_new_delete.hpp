@@ -0,0 +1,195 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2025 Nil Foundation AG
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+// Replacement global operator new and delete feeding memory_stats. Include in exactly one translation unit
+// of an executable. Sizes are taken from malloc_usable_size, so that every form of delete is counted the same
+// way as the matching new; on platforms without it allocations are not counted. Nothing is counted until
+// memory_stats is enabled. Large allocations are served by huge_page_arena once it is enabled.
+
+#ifndef CRYPTO3_BENCH_MEMORY_STATS_NEW_DELETE_HPP
+#define CRYPTO3_BENCH_MEMORY_STATS_NEW_DELETE_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include <nil/crypto3/bench/memory_stats.hpp>
+#include <nil/crypto3/container/huge_page_arena.hpp>
+
+#if defined(__GLIBC__)
+
+#include <malloc.h>
+
+namespace nil {
+    namespace crypto3 {
+        namespace bench {
+            namespace detail {
+                using container::huge_page_arena;
+
+                inline void* counted_allocate(std::size_t size, std::size_t alignment) {
+                    if (size == 0) {
+                        size = 1;
+                    }
+                    if (alignment <= huge_page_arena::huge_page_size && huge_page_arena::enabled()) {
+                        void* block = huge_page_arena::instance().allocate(size);
+                        if (block != nullptr) {
+                            if (memory_stats::enabled()) {
+                                memory_stats::instance().on_allocate(size);
+                            }
+                            return block;
+                        }
+                    }
+                    void* p;
+                    while (true) {
+                        p = alignment <= alignof(std::max_align_t)
+                            ? std::malloc(size)
+                            : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+                        if (p != nullptr) {
+                            break;
+                        }
+                        std::new_handler handler = std::get_new_handler();
+                        if (handler == nullptr) {
+                            return nullptr;
+                        }
+                        handler();
+                    }
+                    if (memory_stats::enabled()) {
+                        memory_stats::instance().on_allocate(malloc_usable_size(p));
+                    }
+                    return p;
+                }
+
+                inline void counted_deallocate(void* p) noexcept {
+                    if (p == nullptr) {
+                        return;
+                    }
+                    const bool counted = memory_stats::enabled();
+                    if (huge_page_arena::instance().owns(p)) {
+                        const std::size_t size = huge_page_arena::instance().deallocate(p);
+                        if (counted) {
+                            memory_stats::instance().on_deallocate(size);
+                        }
+                        return;
+                    }
+                    if (counted) {
+                        memory_stats::instance().on_deallocate(malloc_usable_size(p));
+                    }
+                    std::free(p);
+                }
+            }    // namespace detail
+        }        // namespace bench
+    }            // namespace crypto3
+}    // namespace nil
+
+void* operator new(std::size_t size) {
+    void* p = nil::crypto3::bench::detail::counted_allocate(size, alignof(std::max_align_t));
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    void* p = nil::crypto3::bench::detail::counted_allocate(size, static_cast<std::size_t>(alignment));
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return ::operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return nil::crypto3::bench::detail::counted_allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return nil::crypto3::bench::detail::counted_allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return nil::crypto3::bench::detail::counted_allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return nil::crypto3::bench::detail::counted_allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept {
+    nil::crypto3::bench::detail::counted_deallocate(p);
+}
+
+void operator delete[](void* p) noexcept {
+    nil::crypto3::bench::detail::counted_deallocate(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    nil::crypto3::bench::detail::counted_deallocate(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    nil::crypto3::bench::detail::counted_deallocate(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+    nil::crypto3::bench::detail::counted_deallocate(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept {
+    nil::crypto3::bench::detail::counted_deallocate(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+    nil::crypto3::bench::detail::counted_deallocate(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {
+    nil::crypto3::bench::detail::counted_deallocate(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    nil::crypto3::bench::detail::counted_deallocate(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    nil::crypto3::bench::detail::counted_deallocate(p);
+}
+
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+    nil::crypto3::bench::detail::counted_deallocate(p);
+}
+
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+    nil::crypto3::bench::detail::counted_deallocate(p);
+}
+
+#endif    // defined(__GLIBC__)
+
+#endif    // CRYPTO3_BENCH_MEMORY_STATS_NEW_DELETE_HPP
@@ -30,15 +30,19 @@
 #include <string>
 #include <iostream>
 #include <iomanip>
+#include <mutex>
 #include <unordered_map>
 #include <stack>
 
+#include <nil/crypto3/bench/memory_stats.hpp>
+#include <nil/crypto3/bench/tracer.hpp>
+
 namespace nil {
     namespace crypto3 {
         namespace bench {
             namespace detail {
-                void no_scope_profiling(const std::string& name, bool stop = false) {
-                    static std::stack<std::pair<std::string, std::chrono::time_point<std::chrono::high_resolution_clock>>> points;
+                inline void no_scope_profiling(const std::string& name, bool stop = false) {
+                    thread_local std::stack<std::pair<std::string, std::chrono::time_point<std::chrono::high_resolution_clock>>> points;
                     if (stop) {
                         const auto curr = std::chrono::high_resolution_clock::now();
                         auto start = curr;
@@ -57,13 +61,31 @@ namespace nil {
                     }
                 }
 
+                // Tracer span and memory stage of a scope, each recorded only if enabled at runtime.
+                class profiled_scope
+                {
+                    public:
+                        template<typename Name>
+                        inline explicit profiled_scope(const Name& name)
+                            : span(name)
+                            , memory(name) {
+                        }
+
+                    private:
+                        trace_scope span;
+                        memory_scope memory;
+                };
+
                 // Measures execution time of a given function just once. Prints 
                 // the time when leaving the function in which this class was created.
+                // The scope is recorded by the tracer and memory stats as well, if they are enabled.
                 class scoped_profiler
                 {
                     public:
                         inline scoped_profiler(std::string name) 
-                            : start(std::chrono::high_resolution_clock::now())
+                            : span(name)
+                            , memory(name)
+                            , start(std::chrono::high_resolution_clock::now())
                             , name(name) {
                         }
 
@@ -71,10 +93,16 @@ namespace nil {
                             auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
                                             std::chrono::high_resolution_clock::now() - start);
                             std::cout << name << ": " << std::fixed << std::setprecision(3)
-                                << elapsed.count() << " ms" << std::endl;
+                                << elapsed.count() << " ms";
+                            if (memory.is_active()) {
+                                std::cout << ", peak heap " << memory.peak_live_bytes() / (1024 * 1024) << " MiB";
+                            }
+                            std::cout << std::endl;
                         }
 
                     private:
+                        trace_scope span;
+                        memory_scope memory;
                         std::chrono::time_point<std::chrono::high_resolution_clock> start;
                         std::string name;
                 };
@@ -88,6 +116,7 @@ namespace nil {
                         }
 
                         void add_stat(const std::string& name, uint64_t time_ms) {
+                            std::lock_guard<std::mutex> lock(stats_mutex);
                             call_counts[name]++;
                             call_miliseconds[name] += time_ms;
                         }
@@ -103,6 +132,7 @@ namespace nil {
                             }
                         }
 
+                        std::mutex stats_mutex;
                         std::unordered_map<std::string, uint64_t> call_counts;
                         std::unordered_map<std::string, uint64_t> call_miliseconds;
                 };
@@ -133,22 +163,26 @@ namespace nil {
     }            // namespace crypto3
 }    // namespace nil
 
+// Scopes are always traced and their heap peaks recorded when the tracer or memory stats are enabled at
+// runtime, see tracer.hpp and memory_stats.hpp. Build flags additionally print their timings to std::cout.
 #ifdef PROFILING_ENABLED
     #define PROFILE_SCOPE(name) \
-        nil::crypto3::bench::detail::scoped_profiler profiler(name);
+        nil::crypto3::bench::detail::scoped_profiler CRYPTO3_TRACE_CONCAT(profiler_, __LINE__)(name);
 #else
-    #define PROFILE_SCOPE(name)
+    #define PROFILE_SCOPE(name) \
+        nil::crypto3::bench::detail::profiled_scope CRYPTO3_TRACE_CONCAT(profiler_, __LINE__)(name);
 #endif
 
 #ifdef TIME_LOG_ENABLED
     #define TIME_LOG_SCOPE(name) \
-        nil::crypto3::bench::detail::scoped_profiler profiler(name);
+        nil::crypto3::bench::detail::scoped_profiler CRYPTO3_TRACE_CONCAT(profiler_, __LINE__)(name);
     #define TIME_LOG_START(name) \
         nil::crypto3::bench::detail::no_scope_profiling(name, false);
     #define TIME_LOG_END(name) \
         nil::crypto3::bench::detail::no_scope_profiling(name, true);
 #else
-    #define TIME_LOG_SCOPE(name)
+    #define TIME_LOG_SCOPE(name) \
+        nil::crypto3::bench::detail::profiled_scope CRYPTO3_TRACE_CONCAT(profiler_, __LINE__)(name);
     #define TIME_LOG_START(name)
     #define TIME_LOG_END(name)
 #endif
@@ -0,0 +1,286 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2025 Nil Foundation AG
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_BENCH_TRACER_HPP
+#define CRYPTO3_BENCH_TRACER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace nil {
+    namespace crypto3 {
+        namespace bench {
+
+            struct trace_event {
+                std::string name;
+                std::uint64_t start_ns;
+                std::uint64_t duration_ns;
+            };
+
+            // Events of one thread. Only the owning thread appends, so appending takes no locks: events are stored
+            // in fixed size chunks that are never moved, and the number of complete events in a chunk is published
+            // with a release store. Readers may walk the buffer while the owner keeps appending.
+            class trace_thread_buffer {
+            public:
+                static constexpr std::size_t chunk_size = 1024;
+
+                explicit trace_thread_buffer(std::uint32_t thread_id)
+                    : thread_id(thread_id), head(std::make_unique<chunk>()), tail(head.get()) {
+                }
+
+                ~trace_thread_buffer() {
+                    chunk* next = head->next.load(std::memory_order_relaxed);
+                    while (next != nullptr) {
+                        chunk* current = next;
+                        next = current->next.load(std::memory_order_relaxed);
+                        delete current;
+                    }
+                }
+
+                void append(trace_event&& event) {
+                    std::size_t size = tail->size.load(std::memory_order_relaxed);
+                    if (size == chunk_size) {
+                        chunk* next = new chunk();
+                        tail->next.store(next, std::memory_order_release);
+                        tail = next;
+                        size = 0;
+                    }
+                    tail->events[size] = std::move(event);
+                    tail->size.store(size + 1, std::memory_order_release);
+                }
+
+                template<typename Visitor>
+                void for_each_event(Visitor visitor) const {
+                    for (const chunk* c = head.get(); c != nullptr; c = c->next.load(std::memory_order_acquire)) {
+                        const std::size_t size = c->size.load(std::memory_order_acquire);
+                        for (std::size_t i = 0; i < size; i++) {
+                            visitor(c->events[i]);
+                        }
+                    }
+                }
+
+                // Names must have static storage duration, they are read by the writer thread without a lock.
+                void set_name(const char* thread_name) {
+                    const char* expected = nullptr;
+                    name.compare_exchange_strong(expected, thread_name, std::memory_order_release);
+                }
+
+                const char* get_name() const {
+                    return name.load(std::memory_order_acquire);
+                }
+
+                const std::uint32_t thread_id;
+
+            private:
+                struct chunk {
+                    std::array<trace_event, chunk_size> events;
+                    std::atomic<std::size_t> size{0};
+                    std::atomic<chunk*> next{nullptr};
+                };
+
+                std::unique_ptr<chunk> head;
+                chunk* tail;
+                std::atomic<const char*> name{nullptr};
+            };
+
+            // Collects nested spans of every thread and writes them in Chrome trace event format, which is
+            // read by chrome://tracing and ui.perfetto.dev. Tracing is always compiled in and off by default,
+            // a disabled tracer costs one relaxed load per span.
+            class tracer {
+            public:
+                using clock = std::chrono::steady_clock;
+
+                // Never destroyed: pool threads may still close spans while static objects are destroyed at exit.
+                static tracer& instance() {
+                    static tracer* instance = new tracer();
+                    return *instance;
+                }
+
+                static bool enabled() {
+                    return instance().is_enabled.load(std::memory_order_relaxed);
+                }
+
+                void enable() {
+                    is_enabled.store(true, std::memory_order_relaxed);
+                }
+
+                void disable() {
+                    is_enabled.store(false, std::memory_order_relaxed);
+                }
+
+                void record(std::string name, clock::time_point start, clock::time_point end) {
+                    current_thread_buffer().append(trace_event{
+                        std::move(name), to_ns(start), static_cast<std::uint64_t>(
+                            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count())});
+                }
+
+                // Names the calling thread in the trace, the first name set wins.
+                void set_thread_name(const char* name) {
+                    current_thread_buffer().set_name(name);
+                }
+
+                void write_chrome_trace(std::ostream& out) const {
+                    std::lock_guard<std::mutex> lock(buffers_mutex);
+                    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+                    bool first = true;
+                    auto separator = [&out, &first]() -> std::ostream& {
+                        if (!first) {
+                            out << ",";
+                        }
+                        first = false;
+                        return out << "\n";
+                    };
+                    for (const auto& buffer : buffers) {
+                        if (const char* name = buffer->get_name()) {
+                            separator() << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->thread_id
+                                        << ",\"args\":{\"name\":";
+                            write_json_string(out, name);
+                            out << "}}";
+                        }
+                        buffer->for_each_event([&](const trace_event& event) {
+                            separator() << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->thread_id << ",\"name\":";
+                            write_json_string(out, event.name);
+                            out << std::fixed << std::setprecision(3)
+                                << ",\"ts\":" << event.start_ns / 1000.0
+                                << ",\"dur\":" << event.duration_ns / 1000.0 << "}";
+                        });
+                    }
+                    out << "\n]}\n";
+                }
+
+                bool write_chrome_trace(const std::string& file_name) const {
+                    std::ofstream out(file_name);
+                    if (!out.is_open()) {
+                        return false;
+                    }
+                    write_chrome_trace(out);
+                    return out.good();
+                }
+
+            private:
+                tracer() : epoch(clock::now()) {
+                }
+
+                std::uint64_t to_ns(clock::time_point time) const {
+                    return std::chrono::duration_cast<std::chrono::nanoseconds>(time - epoch).count();
+                }
+
+                // Buffers are owned by the tracer, so events of exited threads are still written.
+                trace_thread_buffer& current_thread_buffer() {
+                    thread_local trace_thread_buffer* buffer = nullptr;
+                    if (buffer == nullptr) {
+                        std::lock_guard<std::mutex> lock(buffers_mutex);
+                        buffers.push_back(std::make_unique<trace_thread_buffer>(buffers.size() + 1));
+                        buffer = buffers.back().get();
+                    }
+                    return *buffer;
+                }
+
+                static void write_json_string(std::ostream& out, const std::string& value) {
+                    out << '"';
+                    for (char c : value) {
+                        switch (c) {
+                            case '"':
+                                out << "\\\"";
+                                break;
+                            case '\\':
+                                out << "\\\\";
+                                break;
+                            case '\n':
+                                out << "\\n";
+                                break;
+                            default:
+                                if (static_cast<unsigned char>(c) < 0x20) {
+                                    out << ' ';
+                                } else {
+                                    out << c;
+                                }
+                        }
+                    }
+                    out << '"';
+                }
+
+                const clock::time_point epoch;
+                std::atomic<bool> is_enabled{false};
+                mutable std::mutex buffers_mutex;
+                std::vector<std::unique_ptr<trace_thread_buffer>> buffers;
+            };
+
+            // Records a span from construction to destruction if the tracer was enabled at construction.
+            class trace_scope {
+            public:
+                explicit trace_scope(const char* name) {
+                    if (tracer::enabled()) {
+                        start(name);
+                    }
+                }
+
+                explicit trace_scope(const std::string& name) {
+                    if (tracer::enabled()) {
+                        start(name);
+                    }
+                }
+
+                trace_scope(const trace_scope&) = delete;
+                trace_scope& operator=(const trace_scope&) = delete;
+
+                ~trace_scope() {
+                    if (active) {
+                        tracer::instance().record(std::move(name), start_time, tracer::clock::now());
+                    }
+                }
+
+            private:
+                void start(std::string span_name) {
+                    name = std::move(span_name);
+                    start_time = tracer::clock::now();
+                    active = true;
+                }
+
+                bool active = false;
+                std::string name;
+                tracer::clock::time_point start_time;
+            };
+
+        }    // namespace bench
+    }        // namespace crypto3
+}    // namespace nil
+
+#define CRYPTO3_TRACE_CONCAT_IMPL(a, b) a##b
+#define CRYPTO3_TRACE_CONCAT(a, b) CRYPTO3_TRACE_CONCAT_IMPL(a, b)
+
+#define TRACE_SCOPE(name) \
+    nil::crypto3::bench::trace_scope CRYPTO3_TRACE_CONCAT(trace_scope_, __LINE__)(name);
+
+#endif    // CRYPTO3_BENCH_TRACER_HPP
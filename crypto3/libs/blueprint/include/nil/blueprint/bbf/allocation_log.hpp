@@ -27,6 +27,8 @@
 #ifndef CRYPTO3_BLUEPRINT_PLONK_BBF_ALLOCATION_LOG_HPP
 #define CRYPTO3_BLUEPRINT_PLONK_BBF_ALLOCATION_LOG_HPP
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <sstream>
 #include <vector>
@@ -41,58 +43,63 @@ namespace nil {
         namespace bbf {
 
             // A class for storing the information on which cells in the assignment table is already allocated/used.
+            // The flags of each column are packed into atomic words, so cells of different rows can be marked
+            // concurrently, e.g. by context::for_each_row in the ASSIGNMENT stage.
             template<typename FieldType>
             class allocation_log {
             public:
                 using assignment_description_type = nil::crypto3::zk::snark::plonk_table_description<FieldType>;
+                using word_type = std::uint64_t;
+                using column_log_type = std::vector<std::atomic<word_type>>;
 
-                allocation_log(const assignment_description_type& desc) {
-                    log[column_type::witness] = std::vector<std::vector<bool>>(
-                        desc.witness_columns, std::vector<bool>(desc.usable_rows_amount));
-                    log[column_type::public_input] = std::vector<std::vector<bool>>(
-                        desc.public_input_columns, std::vector<bool>(desc.usable_rows_amount));
-                    log[column_type::constant] = std::vector<std::vector<bool>>(
-                        desc.constant_columns, std::vector<bool>(desc.usable_rows_amount));
+                constexpr static const std::size_t word_bits = 8 * sizeof(word_type);
+
+                allocation_log(const assignment_description_type& desc) : rows(desc.usable_rows_amount) {
+                    init_columns(column_type::witness, desc.witness_columns);
+                    init_columns(column_type::public_input, desc.public_input_columns);
+                    init_columns(column_type::constant, desc.constant_columns);
                 }
 
-                bool is_allocated(std::size_t col, std::size_t row, column_type t) {
-                    if (col >= log[t].size()) {
-                        std::stringstream error;
-                        error << "Invalid value col = " << col 
-                            << " when checking if a " << t << " cell is allocated. We have "
-                            << log[t].size() << " columns.";
-                        throw std::out_of_range(error.str());
-                    }
-                    if (row >= log[t][col].size()) {
-                        std::stringstream error;
-                        error << "Invalid value row = " << row 
-                            << " when checking if a " << t << " cell is allocated. Column " << col << " has "
-                            << log[t][col].size() << " rows.";
-                        throw std::out_of_range(error.str());
+                bool is_allocated(std::size_t col, std::size_t row, column_type t) const {
+                    check_cell(col, row, t, "checking if a", "is allocated");
+                    return (log[t][col][row / word_bits].load(std::memory_order_relaxed) >> (row % word_bits)) & 1;
+                }
+
+                // Returns whether the cell was already marked before this call.
+                bool mark_allocated(std::size_t col, std::size_t row, column_type t) {
+                    check_cell(col, row, t, "marking a", "allocated");
+                    const word_type bit = word_type(1) << (row % word_bits);
+                    return log[t][col][row / word_bits].fetch_or(bit, std::memory_order_relaxed) & bit;
+                }
+
+            private:
+                void init_columns(column_type t, std::size_t columns) {
+                    log[t].resize(columns);
+                    for (auto &column : log[t]) {
+                        column = column_log_type((rows + word_bits - 1) / word_bits);
                     }
-                    return log[t][col][row];
                 }
 
-                void mark_allocated(std::size_t col, std::size_t row, column_type t) {
+                void check_cell(std::size_t col, std::size_t row, column_type t,
+                                const char *action, const char *state) const {
                     if (col >= log[t].size()) {
                         std::stringstream error;
                         error << "Invalid value col = " << col 
-                            << " when marking a " << t << " cell allocated. We have "
+                            << " when " << action << " " << t << " cell " << state << ". We have "
                             << log[t].size() << " columns.";
                         throw std::out_of_range(error.str());
                     }
-                    if (row >= log[t][col].size()) {
+                    if (row >= rows) {
                         std::stringstream error;
                         error << "Invalid value row = " << row 
-                            << " when marking a " << t << " cell allocated. Column " << col << " has "
-                            << log[t][col].size() << " rows.";
+                            << " when " << action << " " << t << " cell " << state << ". Column " << col << " has "
+                            << rows << " rows.";
                         throw std::out_of_range(error.str());
                     }
-                    log[t][col][row] = true;
                 }
 
-            private:
-                std::vector<std::vector<bool>> log[column_type::COLUMN_TYPES_COUNT];
+                std::size_t rows;
+                std::vector<column_log_type> log[column_type::COLUMN_TYPES_COUNT];
             };
 
         } // namespace bbf
@@ -27,8 +27,11 @@
 #ifndef CRYPTO3_BLUEPRINT_PLONK_BBF_GENERIC_HPP
 #define CRYPTO3_BLUEPRINT_PLONK_BBF_GENERIC_HPP
 
+#include <algorithm>
+#include <exception>
 #include <functional>
 #include <sstream>
+#include <thread>
 #include <vector>
 #include <unordered_map>
 
@@ -114,8 +117,9 @@ namespace nil {
                         }
                     }
 
-                    void mark_allocated(std::size_t col, std::size_t row, column_type t) {
-                        alloc_log->mark_allocated(get_col(col,t),get_row(row), t);
+                    // Returns whether the cell was already allocated before this call.
+                    bool mark_allocated(std::size_t col, std::size_t row, column_type t) {
+                        return alloc_log->mark_allocated(get_col(col,t),get_row(row), t);
                     }
 
                     std::pair<std::size_t, std::size_t> next_free_cell(column_type t) {
@@ -202,7 +206,9 @@ namespace nil {
                 { };
 
                 void allocate(TYPE &C, size_t col, size_t row, column_type t) {
-                    if (is_allocated(col, row, t)) {
+                    // NB: the cell is marked first, so that two threads allocating the same cell
+                    // can't both pass the check
+                    if (mark_allocated(col, row, t)) {
                         std::stringstream ss;
                         ss << "RE-allocation of " << t << " cell at col = " << col << ", row = " << row << ".\n";
                         throw std::logic_error(ss.str());
@@ -224,7 +230,59 @@ namespace nil {
                         default:
                            throw std::logic_error("Unknown column type.");
                     }
-                    mark_allocated(col, row, t);
+                }
+
+                // Calls f(row) for every row in [begin, end) of the active area, splitting the rows into
+                // contiguous chunks that are assigned from separate threads. Rows must be independent: f may
+                // only allocate witness cells with explicit col and row, and must not touch other shared state.
+                template<typename RowFunction>
+                void for_each_row(std::size_t begin, std::size_t end, RowFunction f) {
+                    if (begin >= end) {
+                        return;
+                    }
+                    // Extend the witness columns up front, at.witness() would resize them concurrently otherwise.
+                    const std::size_t last_row = get_row(end - 1);
+                    for (std::size_t col : col_map[column_type::witness]) {
+                        if (at.witness_column_size(col) <= last_row) {
+                            at.witness(col, last_row);
+                        }
+                    }
+
+                    const std::size_t threads_num = std::min<std::size_t>(
+                        std::max(1u, std::thread::hardware_concurrency()),
+                        (end - begin + min_rows_per_thread - 1) / min_rows_per_thread);
+                    if (threads_num <= 1) {
+                        for (std::size_t row = begin; row < end; row++) {
+                            f(row);
+                        }
+                        return;
+                    }
+
+                    const std::size_t chunk_size = (end - begin + threads_num - 1) / threads_num;
+                    std::vector<std::thread> threads;
+                    std::vector<std::exception_ptr> errors(threads_num);
+                    threads.reserve(threads_num);
+                    for (std::size_t i = 0; i < threads_num; i++) {
+                        const std::size_t chunk_begin = begin + i * chunk_size;
+                        const std::size_t chunk_end = std::min(end, chunk_begin + chunk_size);
+                        threads.emplace_back([&f, &errors, i, chunk_begin, chunk_end]() {
+                            try {
+                                for (std::size_t row = chunk_begin; row < chunk_end; row++) {
+                                    f(row);
+                                }
+                            } catch (...) {
+                                errors[i] = std::current_exception();
+                            }
+                        });
+                    }
+                    for (auto &thread : threads) {
+                        thread.join();
+                    }
+                    for (auto &error : errors) {
+                        if (error) {
+                            std::rethrow_exception(error);
+                        }
+                    }
                 }
 
                 void copy_constrain(TYPE &A, TYPE &B) {
@@ -272,6 +330,9 @@ namespace nil {
                 }
 
                 private:
+                    // rows below this amount per thread are not worth spawning a thread for
+                    constexpr static const std::size_t min_rows_per_thread = 256;
+
                     // reference to the actual assignment table
                     assignment_type &at;
             };
@@ -354,6 +415,14 @@ namespace nil {
                     mark_allocated(col, row, t);
                 }
 
+                // Circuit generation stores constraints in shared containers, so the rows are visited in order.
+                template<typename RowFunction>
+                void for_each_row(std::size_t begin, std::size_t end, RowFunction f) {
+                    for (std::size_t row = begin; row < end; row++) {
+                        f(row);
+                    }
+                }
+
                 void copy_constrain(TYPE &A, TYPE &B) {
                     auto is_var = nil::crypto3::math::expression_is_variable_visitor<var>::is_var;
 
@@ -708,6 +777,13 @@ namespace nil {
                     ct.allocate(C,col,row,t);
                 }
 
+                // Runs f(row) for rows [begin, end), concurrently in the ASSIGNMENT stage.
+                // See context<FieldType, GenerationStage::ASSIGNMENT>::for_each_row for the restrictions on f.
+                template<typename RowFunction>
+                void for_each_row(std::size_t begin, std::size_t end, RowFunction f) {
+                    ct.for_each_row(begin, end, f);
+                }
+
                 void copy_constrain(TYPE &A, TYPE &B) {
                     ct.copy_constrain(A,B);
                 }
@@ -39,6 +39,7 @@ namespace nil {
                 using generic_component<FieldType, stage>::constrain;
                 using generic_component<FieldType, stage>::lookup;
                 using generic_component<FieldType, stage>::lookup_table;
+                using generic_component<FieldType, stage>::for_each_row;
             public:
                 using typename generic_component<FieldType,stage>::TYPE;
                 using integral_type =  nil::crypto3::multiprecision::big_uint<257>;
@@ -165,7 +166,8 @@ namespace nil {
                             std::cout << "\tFor bytes size = " << cp.bytes.size() << " last row is " << current_row - 1 << std::endl;
                         }
                     }
-                    for( std::size_t i = 0; i < max_copy; i++){
+                    // Rows only depend on the precomputed vectors above, so they are assigned concurrently.
+                    for_each_row(0, max_copy, [&](std::size_t i) {
                         for(std::size_t j = 0; j < 6; j++){
                             allocate(type_selector[i][j], j, i);
                         }
@@ -197,7 +199,7 @@ namespace nil {
                             keccak_selector * is_last[i] * id_lo[i] + (1 - keccak_selector * is_last[i]) * w_lo<FieldType>(zerohash)
                         };
                         lookup(tmp, "keccak_table");
-                    }
+                    });
                     if constexpr( stage == GenerationStage::CONSTRAINTS ){
                         std::vector<TYPE> even;
                         std::vector<TYPE> odd;
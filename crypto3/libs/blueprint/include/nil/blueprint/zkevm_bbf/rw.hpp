@@ -44,6 +44,7 @@ namespace nil {
                 using generic_component<FieldType, stage>::constrain;
                 using generic_component<FieldType, stage>::lookup;
                 using generic_component<FieldType, stage>::lookup_table;
+                using generic_component<FieldType, stage>::for_each_row;
             public:
                 using typename generic_component<FieldType,stage>::TYPE;
                 using rw_table_type = rw_table<FieldType, stage>;
@@ -212,8 +213,8 @@ namespace nil {
                             }
                         }
                     }
-                    for( std::size_t i = 0; i < max_rw_size; i++){
-                        if( i % 20 == 0)  std::cout << "."; std::cout.flush();
+                    // Rows only depend on the precomputed vectors above, so they are assigned concurrently.
+                    for_each_row(0, max_rw_size, [&](std::size_t i) {
                         std::size_t cur_column = rw_table_type::get_witness_amount();
                         for( std::size_t j = 0; j < op_bits_amount; j++){
                             allocate(op_bits[i][j], ++cur_column, i);
@@ -235,8 +236,7 @@ namespace nil {
                         allocate(state_root_lo[i], ++cur_column, i);
                         allocate(state_root_before_hi[i], ++cur_column, i);
                         allocate(state_root_before_lo[i], ++cur_column, i);
-                    }
-                    std::cout << std::endl;
+                    });
                     if constexpr (stage == GenerationStage::CONSTRAINTS) {
                         std::vector<TYPE> every_row_constraints;
                         std::vector<TYPE> non_first_row_constraints;
@@ -0,0 +1,110 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2025 Nil Foundation AG
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE blueprint_plonk_bbf_parallel_assignment_test
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/algebra/curves/pallas.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/pallas.hpp>
+
+#include <nil/crypto3/zk/snark/arithmetization/plonk/assignment.hpp>
+
+#include <nil/blueprint/bbf/allocation_log.hpp>
+#include <nil/blueprint/bbf/generic.hpp>
+
+using namespace nil::crypto3;
+using namespace nil::blueprint;
+
+using field_type = typename algebra::curves::pallas::base_field_type;
+using value_type = typename field_type::value_type;
+using assignment_type = zk::snark::plonk_assignment_table<field_type>;
+using context_type = bbf::context<field_type, bbf::GenerationStage::ASSIGNMENT>;
+
+// Fills every cell of the active area with a value derived from its coordinates.
+struct row_filler : public bbf::generic_component<field_type, bbf::GenerationStage::ASSIGNMENT> {
+    using generic_component<field_type, bbf::GenerationStage::ASSIGNMENT>::allocate;
+    using generic_component<field_type, bbf::GenerationStage::ASSIGNMENT>::for_each_row;
+
+    row_filler(context_type &context_object, std::size_t columns, std::size_t rows)
+        : generic_component<field_type, bbf::GenerationStage::ASSIGNMENT>(context_object, false) {
+        for_each_row(0, rows, [&](std::size_t i) {
+            for (std::size_t j = 0; j < columns; j++) {
+                value_type v = i * columns + j;
+                allocate(v, j, i);
+            }
+        });
+    }
+};
+
+BOOST_AUTO_TEST_SUITE(blueprint_bbf_parallel_assignment_test)
+
+BOOST_AUTO_TEST_CASE(allocation_log_marks_once) {
+    zk::snark::plonk_table_description<field_type> desc(3, 0, 0, 0);
+    desc.usable_rows_amount = 130;
+    bbf::allocation_log<field_type> log(desc);
+
+    BOOST_CHECK(!log.is_allocated(2, 129, bbf::column_type::witness));
+    BOOST_CHECK(!log.mark_allocated(2, 129, bbf::column_type::witness));
+    BOOST_CHECK(log.mark_allocated(2, 129, bbf::column_type::witness));
+    BOOST_CHECK(log.is_allocated(2, 129, bbf::column_type::witness));
+    BOOST_CHECK(!log.is_allocated(2, 128, bbf::column_type::witness));
+    BOOST_CHECK_THROW(log.mark_allocated(2, 130, bbf::column_type::witness), std::out_of_range);
+    BOOST_CHECK_THROW(log.is_allocated(3, 0, bbf::column_type::witness), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_rows_match_sequential) {
+    const std::size_t columns = 5, rows = 5000, row_shift = 3;
+    assignment_type at(columns, 0, 0, 0);
+    context_type ct(at, rows + row_shift);
+    context_type sub_ct = ct.subcontext({0, 1, 2, 3, 4}, row_shift, rows);
+    row_filler filler(sub_ct, columns, rows);
+
+    for (std::size_t j = 0; j < columns; j++) {
+        BOOST_CHECK_EQUAL(at.witness_column_size(j), rows + row_shift);
+        for (std::size_t i = 0; i < rows; i++) {
+            BOOST_CHECK(at.witness(j, i + row_shift) == value_type(i * columns + j));
+            BOOST_CHECK(sub_ct.is_allocated(j, i, bbf::column_type::witness));
+        }
+    }
+
+    value_type v = 0;
+    BOOST_CHECK_THROW(sub_ct.allocate(v, 0, rows / 2, bbf::column_type::witness), std::logic_error);
+    BOOST_CHECK(!ct.is_allocated(0, row_shift - 1, bbf::column_type::witness));
+}
+
+BOOST_AUTO_TEST_CASE(parallel_rows_rethrow_errors) {
+    const std::size_t columns = 2, rows = 2000;
+    assignment_type at(columns, 0, 0, 0);
+    context_type ct(at, rows);
+
+    BOOST_CHECK_THROW(
+        ct.for_each_row(0, rows, [&](std::size_t i) {
+            value_type v = i;
+            ct.allocate(v, columns, i, bbf::column_type::witness);
+        }),
+        std::out_of_range);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
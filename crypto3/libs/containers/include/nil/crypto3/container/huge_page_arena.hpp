@@ -0,0 +1,462 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2025 Nil Foundation AG
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CONTAINER_HUGE_PAGE_ARENA_HPP
+#define CRYPTO3_CONTAINER_HUGE_PAGE_ARENA_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace nil {
+    namespace crypto3 {
+        namespace container {
+
+            enum class numa_placement {
+                // Pages are placed on the node of the thread touching them first, the kernel default.
+                local,
+                // Pages are spread round-robin over huge_page_arena_options::numa_nodes.
+                interleave,
+                // Fresh blocks are touched by the first-touch function, see huge_page_arena::set_first_touch.
+                first_touch
+            };
+
+            inline std::optional<numa_placement> parse_numa_placement(std::string_view name) {
+                if (name == "local") {
+                    return numa_placement::local;
+                }
+                if (name == "interleave") {
+                    return numa_placement::interleave;
+                }
+                if (name == "first-touch") {
+                    return numa_placement::first_touch;
+                }
+                return std::nullopt;
+            }
+
+            struct huge_page_arena_options {
+                // Smaller allocations stay on the heap.
+                std::uint64_t min_allocation_bytes = std::uint64_t(2) << 20;
+                // Virtual address space reserved for the arena, twice the physical memory if 0.
+                std::uint64_t reserve_bytes = 0;
+                // Resident bytes of freed blocks kept for reuse, the rest is returned to the system on free.
+                // A quarter of the physical memory if 0.
+                std::uint64_t max_cached_bytes = 0;
+                numa_placement placement = numa_placement::local;
+                // Online nodes, numa_placement::interleave keeps the default policy with less than two.
+                std::vector<unsigned> numa_nodes;
+            };
+
+            // Pool of large buffers in one reserved address range backed by 2MB transparent huge pages.
+            // Buffers are rounded up to power-of-two multiples of the huge page size and managed as buddies:
+            // a freed block merges with its free neighbour of the same size, and a request without a free block
+            // of its size splits a larger one. Freed blocks keep their pages up to max_cached_bytes, so
+            // polynomials and merkle trees reallocated by every prover stage are not faulted in again. Tails of
+            // the rounded blocks are never touched and cost no memory.
+            //
+            // Fed by the replacement operator new and delete from nil/crypto3/bench/memory_stats_new_delete.hpp,
+            // so that containers keep std::allocator and their types are unchanged. Without that header or
+            // before enable() nothing is served from the arena.
+            class huge_page_arena {
+            public:
+                static constexpr std::uint64_t huge_page_size = std::uint64_t(2) << 20;
+
+                static huge_page_arena& instance() {
+                    // Used from operator new and delete, so never destroyed.
+                    alignas(huge_page_arena) static unsigned char storage[sizeof(huge_page_arena)];
+                    static huge_page_arena* instance = new (storage) huge_page_arena();
+                    return *instance;
+                }
+
+                static bool enabled() {
+                    return instance().is_enabled.load(std::memory_order_relaxed);
+                }
+
+                // Reserves the address range on the first call, later calls only enable the arena again.
+                // Returns false if the range can't be reserved, e.g. on platforms other than Linux.
+                bool enable(const huge_page_arena_options& arena_options = {}) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (base.load(std::memory_order_relaxed) == 0 && !reserve(arena_options)) {
+                        return false;
+                    }
+                    is_enabled.store(true, std::memory_order_relaxed);
+                    return true;
+                }
+
+                // Blocks still allocated are freed back to the arena, new allocations go to the heap.
+                void disable() {
+                    is_enabled.store(false, std::memory_order_relaxed);
+                }
+
+                // Called for the untouched part of every block handed out with numa_placement::first_touch.
+                // The parallel thread pool installs a function touching the pages from its workers.
+                void set_first_touch(void (*touch)(void*, std::uint64_t)) {
+                    first_touch.store(touch, std::memory_order_relaxed);
+                }
+
+                bool owns(const void* p) const {
+                    const auto address = reinterpret_cast<std::uintptr_t>(p);
+                    return address >= base.load(std::memory_order_acquire) &&
+                           address < end.load(std::memory_order_acquire);
+                }
+
+                // Returns nullptr if the arena is disabled, the size is below the threshold or the
+                // address range is exhausted, the caller then allocates from the heap.
+                void* allocate(std::uint64_t size) {
+                    if (!enabled() || size < options.min_allocation_bytes) {
+                        return nullptr;
+                    }
+                    const std::uint64_t pages = (size + huge_page_size - 1) / huge_page_size;
+                    std::uint8_t size_class = 0;
+                    while ((std::uint64_t(1) << size_class) < pages) {
+                        ++size_class;
+                    }
+                    if (size_class >= size_classes) {
+                        return nullptr;
+                    }
+
+                    std::uint64_t index;
+                    std::uint64_t resident;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        std::uint8_t free_class = size_class;
+                        while (free_class < size_classes && free_heads[free_class] == 0) {
+                            ++free_class;
+                        }
+                        if (free_class < size_classes) {
+                            index = free_heads[free_class] - 1;
+                            unlink_free(index);
+                            // Upper halves of a larger block stay free, the block keeps their resident pages
+                            while (free_class > size_class) {
+                                --free_class;
+                                const std::uint64_t half = std::uint64_t(1) << free_class;
+                                const std::uint64_t half_bytes = half * huge_page_size;
+                                auto& upper = blocks[index + half];
+                                upper.size_class = free_class;
+                                upper.resident_bytes =
+                                    blocks[index].resident_bytes > half_bytes ? blocks[index].resident_bytes - half_bytes : 0;
+                                blocks[index].resident_bytes -= upper.resident_bytes;
+                                link_free(index + half);
+                            }
+                            cached_bytes -= blocks[index].resident_bytes;
+                            ++recycled_allocations;
+                        } else {
+                            // Blocks are aligned to their size, the skipped pages become free blocks
+                            const std::uint64_t block_pages = std::uint64_t(1) << size_class;
+                            const std::uint64_t aligned = (next_page + block_pages - 1) / block_pages * block_pages;
+                            if (aligned + block_pages > total_pages) {
+                                return nullptr;
+                            }
+                            while (next_page < aligned) {
+                                std::uint8_t gap_class = 0;
+                                while (next_page % (std::uint64_t(2) << gap_class) == 0 &&
+                                       next_page + (std::uint64_t(2) << gap_class) <= aligned) {
+                                    ++gap_class;
+                                }
+                                const std::uint64_t gap = next_page;
+                                next_page += std::uint64_t(1) << gap_class;
+                                blocks[gap].size_class = gap_class;
+                                blocks[gap].resident_bytes = 0;
+                                free_block(gap);
+                            }
+                            index = aligned;
+                            next_page = aligned + block_pages;
+                            blocks[index].resident_bytes = 0;
+                        }
+                        ++allocations;
+                        resident = blocks[index].resident_bytes;
+                        blocks[index].size = size;
+                        blocks[index].size_class = size_class;
+                        blocks[index].resident_bytes = std::max(resident, pages * huge_page_size);
+                    }
+
+                    auto* p = reinterpret_cast<unsigned char*>(base.load(std::memory_order_relaxed)) +
+                              index * huge_page_size;
+                    auto* touch = first_touch.load(std::memory_order_relaxed);
+                    if (options.placement == numa_placement::first_touch && touch != nullptr &&
+                        resident < pages * huge_page_size) {
+                        touch(p + resident, pages * huge_page_size - resident);
+                    }
+                    return p;
+                }
+
+                // Returns the size the block was allocated with.
+                std::uint64_t deallocate(void* p) {
+                    const std::uint64_t index = page_index(p);
+                    std::uint64_t size;
+                    bool release;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        size = blocks[index].size;
+                        release = cached_bytes + blocks[index].resident_bytes > options.max_cached_bytes;
+                        if (!release) {
+                            free_block(index);
+                        }
+                    }
+                    if (release) {
+                        // Returned to the system before the block can be handed out again
+                        release_pages(p, blocks[index].resident_bytes);
+                        std::lock_guard<std::mutex> lock(mutex);
+                        blocks[index].resident_bytes = 0;
+                        free_block(index);
+                    }
+                    return size;
+                }
+
+                std::uint64_t allocation_size(const void* p) const {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    return blocks[page_index(p)].size;
+                }
+
+                // Returns the memory of all free blocks to the system, their address ranges stay reserved.
+                void release_cached() {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    for (std::uint32_t head : free_heads) {
+                        for (std::uint32_t i = head; i != 0; i = blocks[i - 1].next_free) {
+                            auto& block = blocks[i - 1];
+                            if (block.resident_bytes != 0) {
+                                release_pages(page_address(i - 1), block.resident_bytes);
+                                block.resident_bytes = 0;
+                            }
+                        }
+                    }
+                    cached_bytes = 0;
+                }
+
+                std::uint64_t get_reserved_bytes() const {
+                    return end.load(std::memory_order_relaxed) - base.load(std::memory_order_relaxed);
+                }
+
+                std::uint64_t get_used_address_bytes() const {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    return next_page * huge_page_size;
+                }
+
+                std::uint64_t get_cached_bytes() const {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    return cached_bytes;
+                }
+
+                std::uint64_t get_max_cached_bytes() const {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    return options.max_cached_bytes;
+                }
+
+                std::uint64_t get_allocations() const {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    return allocations;
+                }
+
+                std::uint64_t get_recycled_allocations() const {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    return recycled_allocations;
+                }
+
+            private:
+                // Per huge page of the range, only entries of the first page of a block are used. Entries of
+                // pages merged into a larger block are marked not free.
+                struct block_info {
+                    std::uint64_t size;
+                    std::uint64_t resident_bytes;
+                    // Index + 1 of the neighbours in the free list of the size class, 0 ends the list.
+                    std::uint32_t next_free;
+                    std::uint32_t prev_free;
+                    std::uint8_t size_class;
+                    bool is_free;
+                };
+
+                static constexpr std::size_t size_classes = 32;
+
+                huge_page_arena() = default;
+
+                std::uint64_t page_index(const void* p) const {
+                    return (reinterpret_cast<std::uintptr_t>(p) - base.load(std::memory_order_relaxed)) /
+                           huge_page_size;
+                }
+
+                unsigned char* page_address(std::uint64_t index) const {
+                    return reinterpret_cast<unsigned char*>(base.load(std::memory_order_relaxed)) +
+                           index * huge_page_size;
+                }
+
+                void link_free(std::uint64_t index) {
+                    auto& block = blocks[index];
+                    block.is_free = true;
+                    block.prev_free = 0;
+                    block.next_free = free_heads[block.size_class];
+                    if (block.next_free != 0) {
+                        blocks[block.next_free - 1].prev_free = static_cast<std::uint32_t>(index + 1);
+                    }
+                    free_heads[block.size_class] = static_cast<std::uint32_t>(index + 1);
+                }
+
+                void unlink_free(std::uint64_t index) {
+                    auto& block = blocks[index];
+                    if (block.prev_free != 0) {
+                        blocks[block.prev_free - 1].next_free = block.next_free;
+                    } else {
+                        free_heads[block.size_class] = block.next_free;
+                    }
+                    if (block.next_free != 0) {
+                        blocks[block.next_free - 1].prev_free = block.prev_free;
+                    }
+                    block.is_free = false;
+                }
+
+                // Merges the block with its free buddies and adds the result to the free lists.
+                void free_block(std::uint64_t index) {
+                    cached_bytes += blocks[index].resident_bytes;
+                    while (blocks[index].size_class + 1u < size_classes) {
+                        const std::uint64_t half = std::uint64_t(1) << blocks[index].size_class;
+                        const std::uint64_t buddy = index ^ half;
+                        if (buddy + half > next_page || !blocks[buddy].is_free ||
+                            blocks[buddy].size_class != blocks[index].size_class) {
+                            break;
+                        }
+                        const std::uint64_t lower = std::min(index, buddy);
+                        const std::uint64_t upper = std::max(index, buddy);
+                        // Resident pages of a block are a prefix of it. Halves that would break that stay apart
+                        // and keep their cached pages.
+                        if (blocks[upper].resident_bytes != 0 &&
+                            blocks[lower].resident_bytes != half * huge_page_size) {
+                            break;
+                        }
+                        unlink_free(buddy);
+                        blocks[lower].resident_bytes += blocks[upper].resident_bytes;
+                        blocks[lower].size_class += 1;
+                        blocks[upper].is_free = false;
+                        index = lower;
+                    }
+                    link_free(index);
+                }
+
+                static void release_pages(void* p, std::uint64_t size) {
+#if defined(__linux__)
+                    ::madvise(p, size, MADV_DONTNEED);
+#endif
+                }
+
+                bool reserve(const huge_page_arena_options& arena_options) {
+#if defined(__linux__)
+                    options = arena_options;
+                    const std::uint64_t physical_bytes = static_cast<std::uint64_t>(::sysconf(_SC_PHYS_PAGES)) *
+                                                         static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE));
+                    if (options.max_cached_bytes == 0) {
+                        options.max_cached_bytes = physical_bytes / 4;
+                    }
+                    std::uint64_t size = options.reserve_bytes;
+                    if (size == 0) {
+                        size = 2 * physical_bytes;
+                    }
+                    total_pages = std::min<std::uint64_t>((size + huge_page_size - 1) / huge_page_size,
+                                                          std::numeric_limits<std::uint32_t>::max() - 1);
+                    size = total_pages * huge_page_size;
+
+                    // Untouched pages of a MAP_NORESERVE mapping take no memory, one extra huge page aligns
+                    // the start of the range.
+                    const int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+                    void* region = ::mmap(nullptr, size + huge_page_size, PROT_READ | PROT_WRITE, flags, -1, 0);
+                    if (region == MAP_FAILED) {
+                        return false;
+                    }
+                    const auto address = reinterpret_cast<std::uintptr_t>(region);
+                    const std::uintptr_t aligned = (address + huge_page_size - 1) / huge_page_size * huge_page_size;
+                    if (aligned != address) {
+                        ::munmap(region, aligned - address);
+                    }
+                    ::munmap(reinterpret_cast<void*>(aligned + size), address + huge_page_size - aligned);
+
+                    void* table = ::mmap(nullptr, total_pages * sizeof(block_info), PROT_READ | PROT_WRITE, flags,
+                                         -1, 0);
+                    if (table == MAP_FAILED) {
+                        ::munmap(reinterpret_cast<void*>(aligned), size);
+                        return false;
+                    }
+                    blocks = static_cast<block_info*>(table);
+
+#if defined(MADV_HUGEPAGE)
+                    ::madvise(reinterpret_cast<void*>(aligned), size, MADV_HUGEPAGE);
+#endif
+                    if (options.placement == numa_placement::interleave) {
+                        interleave(reinterpret_cast<void*>(aligned), size, options.numa_nodes);
+                    }
+
+                    base.store(aligned, std::memory_order_release);
+                    end.store(aligned + size, std::memory_order_release);
+                    return true;
+#else
+                    return false;
+#endif
+                }
+
+                // Best effort, a kernel without NUMA support keeps the default policy.
+                static void interleave(void* p, std::uint64_t size, const std::vector<unsigned>& nodes) {
+#if defined(__linux__) && defined(SYS_mbind)
+                    constexpr int mpol_interleave = 3;
+                    if (nodes.size() < 2) {
+                        return;
+                    }
+                    constexpr unsigned word_bits = 8 * sizeof(unsigned long);
+                    // The kernel reads one bit less than the passed number of nodes
+                    const unsigned mask_bits = *std::max_element(nodes.begin(), nodes.end()) + 2;
+                    std::vector<unsigned long> mask((mask_bits + word_bits - 1) / word_bits);
+                    for (unsigned node : nodes) {
+                        mask[node / word_bits] |= 1UL << (node % word_bits);
+                    }
+                    ::syscall(SYS_mbind, p, size, mpol_interleave, mask.data(), mask_bits, 0);
+#endif
+                }
+
+                std::atomic<bool> is_enabled{false};
+                std::atomic<std::uintptr_t> base{0};
+                std::atomic<std::uintptr_t> end{0};
+                std::atomic<void (*)(void*, std::uint64_t)> first_touch{nullptr};
+                huge_page_arena_options options;
+
+                mutable std::mutex mutex;
+                block_info* blocks = nullptr;
+                std::uint64_t total_pages = 0;
+                std::uint64_t next_page = 0;
+                std::uint32_t free_heads[size_classes] = {};
+                std::uint64_t cached_bytes = 0;
+                std::uint64_t allocations = 0;
+                std::uint64_t recycled_allocations = 0;
+            };
+        }    // namespace container
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_CONTAINER_HUGE_PAGE_ARENA_HPP
@@ -27,6 +27,8 @@
 #ifndef CRYPTO3_MERKLE_TREE_HPP
 #define CRYPTO3_MERKLE_TREE_HPP
 
+#include <algorithm>
+#include <stdexcept>
 #include <vector>
 #include <cmath>
 
@@ -46,22 +48,41 @@ namespace nil {
                 // returns next highest power of two from a given number if it is not
                 // already a power of two.
                 inline size_t next_pow2(size_t n) {
-                    return std::pow(2, std::ceil(std::log(n)));
+                    size_t result = 1;
+                    while (result < n) {
+                        result <<= 1;
+                    }
+                    return result;
                 }
 
                 // find power of 2 of a number which is power of 2
                 inline size_t log2_pow2(size_t n) {
-                    return next_pow2(n);
+                    size_t result = 0;
+                    while ((size_t(1) << result) < n) {
+                        ++result;
+                    }
+                    return result;
+                }
+
+                // Checks that n is base^k for some integer k >= 0.
+                inline bool is_power_of(size_t n, size_t base) {
+                    if (n == 0 || base < 2) {
+                        return n == 1;
+                    }
+                    while (n % base == 0) {
+                        n /= base;
+                    }
+                    return n == 1;
                 }
 
                 // Row_Count calculation given the number of _leaves in the tree and the branches.
                 inline size_t merkle_tree_row_count(size_t leafs, size_t branches) {
-                    // Optimization
-                    if (branches == 2) {
-                        return std::log2(leafs) + 1;
-                    } else {
-                        return round(std::log(leafs) / std::log(branches)) + 1;
+                    size_t row_count = 1;
+                    while (leafs > 1) {
+                        leafs /= branches;
+                        ++row_count;
                     }
+                    return row_count;
                 }
 
                 // Tree length calculation given the number of _leaves in the tree and the branches.
@@ -191,40 +212,60 @@ namespace nil {
                     typedef typename container_type::reverse_iterator reverse_iterator;
                     typedef typename container_type::const_reverse_iterator const_reverse_iterator;
 
-                    merkle_tree_impl() : _size(0), _leaves(0), _rc(0) {};
+                    merkle_tree_impl() : _size(0), _leaves(0), _rc(0), _discarded_rows(0) {};
 
                     ~merkle_tree_impl() = default;
 
                     merkle_tree_impl(size_t n) :
                             _size(detail::merkle_tree_length(n, Arity)), _leaves(n),
-                            _rc(detail::merkle_tree_row_count(n, Arity)) {
-                        BOOST_ASSERT_MSG(pow(Arity, round(std::log(n) / std::log(Arity))) == n,
+                            _rc(detail::merkle_tree_row_count(n, Arity)), _discarded_rows(0) {
+                        BOOST_ASSERT_MSG(detail::is_power_of(n, Arity),
                                          "Wrong leaves number, it must be a power of Arity.");
                     }
 
                     merkle_tree_impl(const merkle_tree_impl &x) :
-                            _hashes(x._hashes), _size(x._size), _leaves(x._leaves), _rc(x._rc) {
+                            _hashes(x._hashes), _size(x._size), _leaves(x._leaves), _rc(x._rc),
+                            _discarded_rows(x._discarded_rows) {
                     }
 
                     merkle_tree_impl(const merkle_tree_impl &x, const allocator_type &a) : _hashes(x.hashes(), a),
                                                                                            _size(x._size),
                                                                                            _leaves(x._leaves),
-                                                                                           _rc(x._rc) {}
+                                                                                           _rc(x._rc),
+                                                                                           _discarded_rows(x._discarded_rows) {}
 
-                    merkle_tree_impl(const std::initializer_list<value_type> &il) : _hashes(il) {
+                    merkle_tree_impl(const std::initializer_list<value_type> &il) : _hashes(il), _discarded_rows(0) {
                         set_leaves(detail::merkle_tree_leaves(std::distance(il.begin(), il.end()), Arity));
                         set_row_count(detail::merkle_tree_row_count(_leaves, Arity));
                         set_complete_size(detail::merkle_tree_length(_leaves, Arity));
                     }
 
                     template<typename Iterator, typename std::enable_if<std::is_same<typename Iterator::value_type, value_type>::value, bool>::type = true>
-                    merkle_tree_impl(Iterator first, Iterator last) : _hashes(first, last) {
+                    merkle_tree_impl(Iterator first, Iterator last) : _hashes(first, last), _discarded_rows(0) {
                         set_leaves(detail::merkle_tree_leaves(std::distance(first, last), Arity));
                         set_row_count(detail::merkle_tree_row_count(_leaves, Arity));
                         set_complete_size(detail::merkle_tree_length(_leaves, Arity));
                     }
 
-                    merkle_tree_impl(const std::initializer_list<value_type> &il, const allocator_type &a) : _hashes(il, a) {
+                    // Tree of the given number of leaves with the bottom rows discarded, [first, last) being the
+                    // stored top rows, see discard_rows. Throws if they are not whole rows of such a tree.
+                    template<typename Iterator, typename std::enable_if<std::is_same<typename Iterator::value_type, value_type>::value, bool>::type = true>
+                    merkle_tree_impl(size_t leaves, Iterator first, Iterator last) :
+                            _hashes(first, last), _size(detail::merkle_tree_length(leaves, Arity)), _leaves(leaves),
+                            _rc(detail::merkle_tree_row_count(leaves, Arity)), _discarded_rows(0) {
+                        if (!detail::is_power_of(leaves, Arity) || _hashes.empty()) {
+                            throw std::invalid_argument("Wrong merkle tree top");
+                        }
+                        while (_discarded_rows + 1 < _rc && _hashes.size() + discarded_size() < _size) {
+                            ++_discarded_rows;
+                        }
+                        if (_hashes.size() + discarded_size() != _size) {
+                            throw std::invalid_argument("Merkle tree top does not consist of whole rows");
+                        }
+                    }
+
+                    merkle_tree_impl(const std::initializer_list<value_type> &il, const allocator_type &a) :
+                            _hashes(il, a), _discarded_rows(0) {
                         set_leaves(detail::merkle_tree_leaves(std::distance(il.begin(), il.end()), Arity));
                         set_row_count(detail::merkle_tree_row_count(_leaves, Arity));
                         set_complete_size(detail::merkle_tree_length(_leaves, Arity));
@@ -233,15 +274,20 @@ namespace nil {
                     merkle_tree_impl(merkle_tree_impl &&x)
                     BOOST_NOEXCEPT(std::is_nothrow_move_constructible<allocator_type>::value):
                             _hashes(x._hashes),
-                            _size(x._size), _leaves(x._leaves), _rc(x._rc) {
+                            _size(x._size), _leaves(x._leaves), _rc(x._rc), _discarded_rows(x._discarded_rows) {
                     }
 
                     merkle_tree_impl(merkle_tree_impl &&x, const allocator_type &a) :
-                            _hashes(x.hashes(), a), _size(x._size), _leaves(x._leaves), _rc(x._rc) {
+                            _hashes(x.hashes(), a), _size(x._size), _leaves(x._leaves), _rc(x._rc),
+                            _discarded_rows(x._discarded_rows) {
                     }
 
                     merkle_tree_impl &operator=(const merkle_tree_impl &x) {
-                        _hashes = x.hashes();
+                        _hashes = x._hashes;
+                        _size = x._size;
+                        _leaves = x._leaves;
+                        _rc = x._rc;
+                        _discarded_rows = x._discarded_rows;
                         return *this;
                     }
 
@@ -250,11 +296,12 @@ namespace nil {
                         _size = x._size;
                         _leaves = x._leaves;
                         _rc = x._rc;
+                        _discarded_rows = x._discarded_rows;
                         return *this;
                     }
 
                     bool operator==(const merkle_tree_impl &rhs) const {
-                        return _hashes == rhs._hashes;
+                        return _discarded_rows == rhs._discarded_rows && _hashes == rhs._hashes;
                     }
 
                     bool operator!=(const merkle_tree_impl &rhs) const {
@@ -423,16 +470,45 @@ namespace nil {
                         std::swap(_leaves, other.leaves());
                         std::swap(_rc, other.row_count());
                         std::swap(_size, other.size());
+                        std::swap(_discarded_rows, other._discarded_rows);
                     }
 
                     value_type root() const BOOST_NOEXCEPT {
-                        BOOST_ASSERT_MSG(_size == _hashes.size(), "MerkleTree not fulfilled");
-                        return _hashes[_size - 1];
+                        BOOST_ASSERT_MSG(_size == _hashes.size() + discarded_size(), "MerkleTree not fulfilled");
+                        return _hashes.back();
                     }
 
                     value_type root() BOOST_NOEXCEPT {
-                        BOOST_ASSERT_MSG(_size == _hashes.size(), "MerkleTree not fulfilled");
-                        return _hashes[_size - 1];
+                        BOOST_ASSERT_MSG(_size == _hashes.size() + discarded_size(), "MerkleTree not fulfilled");
+                        return _hashes.back();
+                    }
+
+                    // Drops the bottom rows, the leaves being the first one, the way merkle_tree_cache_size
+                    // counts them. At least the root row is kept. Proofs for such a tree are built with the leaves
+                    // passed once again, see merkle_proof_impl.
+                    void discard_rows(size_t rows) {
+                        BOOST_ASSERT_MSG(_size == _hashes.size() + discarded_size(), "MerkleTree not fulfilled");
+                        if (_rc < 2) {
+                            return;
+                        }
+                        rows = std::min(rows, _rc - 1);
+                        if (rows <= _discarded_rows) {
+                            return;
+                        }
+                        const size_t erased = rows_length(rows) - discarded_size();
+                        _hashes.erase(_hashes.begin(), _hashes.begin() + erased);
+                        _hashes.shrink_to_fit();
+                        _discarded_rows = rows;
+                    }
+
+                    // Number of bottom rows that are not stored, 0 for a complete tree.
+                    size_t discarded_rows() const {
+                        return _discarded_rows;
+                    }
+
+                    // Number of nodes in the rows that are not stored.
+                    size_t discarded_size() const {
+                        return rows_length(_discarded_rows);
                     }
 
                     size_t row_count() const {
@@ -456,6 +532,15 @@ namespace nil {
                     }
 
                 protected:
+                    // Number of nodes in the bottom rows.
+                    size_t rows_length(size_t rows) const {
+                        size_t len = 0;
+                        for (size_t row = 0, row_size = _leaves; row < rows; ++row, row_size /= Arity) {
+                            len += row_size;
+                        }
+                        return len;
+                    }
+
                     container_type _hashes;
 
                     size_t _size;
@@ -468,6 +553,7 @@ namespace nil {
                     //
                     // Internally, this code considers only the _rc.
                     size_t _rc;
+                    size_t _discarded_rows;
                 };
 
                 template<typename T, typename LeafIterator>
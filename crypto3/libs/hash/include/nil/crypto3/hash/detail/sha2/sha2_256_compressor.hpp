@@ -0,0 +1,150 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_HASH_SHA2_256_COMPRESSOR_HPP
+#define CRYPTO3_HASH_SHA2_256_COMPRESSOR_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <nil/crypto3/hash/shacal2.hpp>
+#include <nil/crypto3/hash/detail/state_adder.hpp>
+#include <nil/crypto3/hash/detail/davies_meyer_compressor.hpp>
+#include <nil/crypto3/hash/detail/sha2/sha2_256_x86_impl.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+
+                enum class sha2_256_backend {
+                    portable,
+                    avx2,      // 8-way multi-buffer, single blocks stay portable
+                    sha_ni
+                };
+
+                inline sha2_256_backend sha2_256_detect_backend() {
+#ifdef CRYPTO3_HASH_SHA2_256_X86
+                    if (sha2_256_x86_has_sha_ni()) {
+                        return sha2_256_backend::sha_ni;
+                    }
+                    if (sha2_256_x86_has_avx2()) {
+                        return sha2_256_backend::avx2;
+                    }
+#endif
+                    return sha2_256_backend::portable;
+                }
+
+                /*!
+                 * @brief Backend picked once by CPUID for this process.
+                 */
+                inline sha2_256_backend sha2_256_active_backend() {
+                    static const sha2_256_backend backend = sha2_256_detect_backend();
+                    return backend;
+                }
+
+                inline bool sha2_256_backend_supported(sha2_256_backend backend) {
+                    switch (backend) {
+                        case sha2_256_backend::portable:
+                            return true;
+#ifdef CRYPTO3_HASH_SHA2_256_X86
+                        case sha2_256_backend::avx2:
+                            return sha2_256_x86_has_avx2();
+                        case sha2_256_backend::sha_ni:
+                            return sha2_256_x86_has_sha_ni();
+#endif
+                        default:
+                            return false;
+                    }
+                }
+
+                /*!
+                 * @brief SHA-256 compression function with the interface of davies_meyer_compressor.
+                 *
+                 * Uses the SHA extensions when the CPU has them and falls back to the SHACAL-2 based
+                 * Davies-Meyer construction otherwise. process_blocks compresses independent
+                 * (state, block) pairs, eight at a time with AVX2 when SHA extensions are missing.
+                 */
+                struct sha2_256_compressor {
+                    typedef block::shacal2<256> block_cipher_type;
+                    typedef davies_meyer_compressor<block_cipher_type, state_adder> portable_compressor_type;
+
+                    constexpr static const std::size_t word_bits = portable_compressor_type::word_bits;
+                    typedef typename portable_compressor_type::word_type word_type;
+
+                    constexpr static const std::size_t state_bits = portable_compressor_type::state_bits;
+                    constexpr static const std::size_t state_words = portable_compressor_type::state_words;
+                    typedef typename portable_compressor_type::state_type state_type;
+
+                    constexpr static const std::size_t block_bits = portable_compressor_type::block_bits;
+                    constexpr static const std::size_t block_words = portable_compressor_type::block_words;
+                    typedef typename portable_compressor_type::block_type block_type;
+
+                    constexpr static const std::size_t lanes = 8;
+
+                    inline static void process_block(state_type &state, const block_type &block) {
+                        process_block(state, block, sha2_256_active_backend());
+                    }
+
+                    inline static void process_block(state_type &state, const block_type &block,
+                                                     sha2_256_backend backend) {
+#ifdef CRYPTO3_HASH_SHA2_256_X86
+                        if (backend == sha2_256_backend::sha_ni) {
+                            sha2_256_x86_shani_compress(state.data(), block.data());
+                            return;
+                        }
+#endif
+                        portable_compressor_type::process_block(state, block);
+                    }
+
+                    inline static void process_blocks(state_type *states, const block_type *blocks, std::size_t count) {
+                        process_blocks(states, blocks, count, sha2_256_active_backend());
+                    }
+
+                    inline static void process_blocks(state_type *states, const block_type *blocks, std::size_t count,
+                                                      sha2_256_backend backend) {
+                        std::size_t i = 0;
+#ifdef CRYPTO3_HASH_SHA2_256_X86
+                        if (backend == sha2_256_backend::avx2) {
+                            for (; i + lanes <= count; i += lanes) {
+                                std::array<std::uint32_t *, lanes> lane_states;
+                                std::array<const std::uint32_t *, lanes> lane_blocks;
+                                for (std::size_t lane = 0; lane < lanes; ++lane) {
+                                    lane_states[lane] = states[i + lane].data();
+                                    lane_blocks[lane] = blocks[i + lane].data();
+                                }
+                                sha2_256_x86_avx2_compress_x8(lane_states, lane_blocks);
+                            }
+                        }
+#endif
+                        for (; i < count; ++i) {
+                            process_block(states[i], blocks[i], backend);
+                        }
+                    }
+                };
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_SHA2_256_COMPRESSOR_HPP
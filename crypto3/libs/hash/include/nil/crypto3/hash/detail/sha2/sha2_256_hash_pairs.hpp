@@ -0,0 +1,107 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_HASH_SHA2_256_HASH_PAIRS_HPP
+#define CRYPTO3_HASH_SHA2_256_HASH_PAIRS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <nil/crypto3/hash/detail/sha2/sha2_policy.hpp>
+#include <nil/crypto3/hash/detail/sha2/sha2_256_compressor.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+
+                /*!
+                 * @brief SHA-256 of the concatenation of two 32-byte digests, for count consecutive pairs.
+                 *
+                 * Same result as hashing children[2i] and children[2i + 1] through an accumulator, but
+                 * the 64-byte message and its padding block are laid out directly, so that independent
+                 * pairs can be compressed together by sha2_256_compressor::process_blocks.
+                 */
+                template<typename InputIterator, typename OutputIterator>
+                OutputIterator sha2_256_hash_pairs(InputIterator children, std::size_t count, OutputIterator parents,
+                                                   sha2_256_backend backend = sha2_256_active_backend()) {
+                    typedef sha2_256_compressor compressor_type;
+                    typedef typename compressor_type::state_type state_type;
+                    typedef typename compressor_type::block_type block_type;
+                    typedef typename sha2_policy<256>::digest_type digest_type;
+
+                    constexpr static const std::size_t batch_size = 8 * compressor_type::lanes;
+
+                    // A 64-byte message is followed by a block holding only the padding and the length.
+                    block_type padding_block = {};
+                    padding_block[0] = 0x80000000;
+                    padding_block[15] = 512;
+
+                    std::array<state_type, batch_size> states;
+                    std::array<block_type, batch_size> blocks;
+                    std::array<block_type, batch_size> padding_blocks;
+                    padding_blocks.fill(padding_block);
+
+                    const state_type &iv = typename sha2_policy<256>::iv_generator()();
+
+                    for (std::size_t done = 0; done < count;) {
+                        const std::size_t batch = std::min(batch_size, count - done);
+
+                        for (std::size_t i = 0; i < batch; ++i) {
+                            states[i] = iv;
+                            for (std::size_t half = 0; half < 2; ++half, ++children) {
+                                auto byte = std::begin(*children);
+                                for (std::size_t j = 0; j < 8; ++j) {
+                                    std::uint32_t word = 0;
+                                    for (std::size_t k = 0; k < 4; ++k, ++byte) {
+                                        word = (word << 8) | static_cast<std::uint8_t>(*byte);
+                                    }
+                                    blocks[i][8 * half + j] = word;
+                                }
+                            }
+                        }
+
+                        compressor_type::process_blocks(states.data(), blocks.data(), batch, backend);
+                        compressor_type::process_blocks(states.data(), padding_blocks.data(), batch, backend);
+
+                        for (std::size_t i = 0; i < batch; ++i, ++parents) {
+                            digest_type digest;
+                            for (std::size_t j = 0; j < 8; ++j) {
+                                digest[4 * j] = static_cast<std::uint8_t>(states[i][j] >> 24);
+                                digest[4 * j + 1] = static_cast<std::uint8_t>(states[i][j] >> 16);
+                                digest[4 * j + 2] = static_cast<std::uint8_t>(states[i][j] >> 8);
+                                digest[4 * j + 3] = static_cast<std::uint8_t>(states[i][j]);
+                            }
+                            *parents = digest;
+                        }
+                        done += batch;
+                    }
+                    return parents;
+                }
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_SHA2_256_HASH_PAIRS_HPP
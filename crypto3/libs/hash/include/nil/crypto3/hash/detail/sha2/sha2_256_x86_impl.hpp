@@ -0,0 +1,207 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_HASH_SHA2_256_X86_IMPL_HPP
+#define CRYPTO3_HASH_SHA2_256_X86_IMPL_HPP
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define CRYPTO3_HASH_SHA2_256_X86
+
+#include <array>
+#include <cstdint>
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+#include <nil/crypto3/hash/detail/shacal/shacal2_policy.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                // Kernels below are compiled for their own target, callers have to check the CPU first.
+
+                inline bool sha2_256_x86_has_sha_ni() {
+                    unsigned int eax, ebx, ecx, edx;
+                    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+                        return false;
+                    }
+                    // CPUID.(EAX=7,ECX=0):EBX[29] is SHA, the kernel also uses SSE4.1 blends.
+                    return (ebx & (1u << 29)) != 0 && __builtin_cpu_supports("sse4.1");
+                }
+
+                inline bool sha2_256_x86_has_avx2() {
+                    return __builtin_cpu_supports("avx2");
+                }
+
+                /*!
+                 * @brief One SHA-256 compression with the SHA extensions.
+                 * Message words are already decoded from big endian, so there is no byte shuffle on load.
+                 */
+                __attribute__((target("sha,sse4.1"))) inline void
+                    sha2_256_x86_shani_compress(std::uint32_t *state, const std::uint32_t *block) {
+                    const auto &constants = block::detail::shacal2_policy<256>::constants;
+
+                    __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state));
+                    __m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state + 4));
+
+                    tmp = _mm_shuffle_epi32(tmp, 0xB1);             // CDAB
+                    state1 = _mm_shuffle_epi32(state1, 0x1B);       // EFGH
+                    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);    // ABEF
+                    state1 = _mm_blend_epi16(state1, tmp, 0xF0);    // CDGH
+
+                    const __m128i abef_save = state0;
+                    const __m128i cdgh_save = state1;
+
+                    __m128i msgs[4];
+                    for (std::size_t g = 0; g < 16; ++g) {
+                        if (g < 4) {
+                            msgs[g] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 4 * g));
+                        }
+
+                        __m128i msg = _mm_add_epi32(
+                            msgs[g % 4], _mm_loadu_si128(reinterpret_cast<const __m128i *>(constants.data() + 4 * g)));
+                        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+
+                        // Finish the schedule words of the next group.
+                        if (g >= 3 && g < 15) {
+                            __m128i &next = msgs[(g + 1) % 4];
+                            next = _mm_add_epi32(next, _mm_alignr_epi8(msgs[g % 4], msgs[(g + 3) % 4], 4));
+                            next = _mm_sha256msg2_epu32(next, msgs[g % 4]);
+                        }
+
+                        msg = _mm_shuffle_epi32(msg, 0x0E);
+                        state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+                        // Start the schedule words of the group three steps ahead.
+                        if (g >= 1 && g < 13) {
+                            msgs[(g + 3) % 4] = _mm_sha256msg1_epu32(msgs[(g + 3) % 4], msgs[g % 4]);
+                        }
+                    }
+
+                    state0 = _mm_add_epi32(state0, abef_save);
+                    state1 = _mm_add_epi32(state1, cdgh_save);
+
+                    tmp = _mm_shuffle_epi32(state0, 0x1B);          // FEBA
+                    state1 = _mm_shuffle_epi32(state1, 0xB1);       // DCHG
+                    state0 = _mm_blend_epi16(tmp, state1, 0xF0);    // DCBA
+                    state1 = _mm_alignr_epi8(state1, tmp, 8);       // ABEF
+
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(state), state0);
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(state + 4), state1);
+                }
+
+                namespace sha2_256_avx2 {
+                    __attribute__((target("avx2"))) inline __m256i rotr(__m256i x, int n) {
+                        return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+                    }
+
+                    __attribute__((target("avx2"))) inline __m256i xor3(__m256i a, __m256i b, __m256i c) {
+                        return _mm256_xor_si256(_mm256_xor_si256(a, b), c);
+                    }
+
+                    // Word i of every lane.
+                    __attribute__((target("avx2"))) inline __m256i
+                        gather(const std::array<const std::uint32_t *, 8> &src, std::size_t i) {
+                        return _mm256_setr_epi32(src[0][i], src[1][i], src[2][i], src[3][i], src[4][i], src[5][i],
+                                                 src[6][i], src[7][i]);
+                    }
+                }    // namespace sha2_256_avx2
+
+                /*!
+                 * @brief Eight independent SHA-256 compressions, one per 32-bit lane.
+                 * Used to hash many short messages at once, e.g. the nodes of a Merkle tree row.
+                 */
+                __attribute__((target("avx2"))) inline void
+                    sha2_256_x86_avx2_compress_x8(std::array<std::uint32_t *, 8> states,
+                                                  std::array<const std::uint32_t *, 8> blocks) {
+                    using namespace sha2_256_avx2;
+                    const auto &constants = block::detail::shacal2_policy<256>::constants;
+
+                    std::array<const std::uint32_t *, 8> const_states;
+                    for (std::size_t lane = 0; lane < 8; ++lane) {
+                        const_states[lane] = states[lane];
+                    }
+
+                    __m256i saved[8];
+                    for (std::size_t i = 0; i < 8; ++i) {
+                        saved[i] = gather(const_states, i);
+                    }
+
+                    __m256i a = saved[0], b = saved[1], c = saved[2], d = saved[3];
+                    __m256i e = saved[4], f = saved[5], g = saved[6], h = saved[7];
+
+                    __m256i w[16];
+                    for (std::size_t t = 0; t < 64; ++t) {
+                        if (t < 16) {
+                            w[t] = gather(blocks, t);
+                        } else {
+                            const __m256i w15 = w[(t - 15) & 15];
+                            const __m256i w2 = w[(t - 2) & 15];
+                            const __m256i s0 = xor3(rotr(w15, 7), rotr(w15, 18), _mm256_srli_epi32(w15, 3));
+                            const __m256i s1 = xor3(rotr(w2, 17), rotr(w2, 19), _mm256_srli_epi32(w2, 10));
+                            w[t & 15] = _mm256_add_epi32(_mm256_add_epi32(w[t & 15], s0),
+                                                         _mm256_add_epi32(w[(t - 7) & 15], s1));
+                        }
+
+                        const __m256i sigma1 = xor3(rotr(e, 6), rotr(e, 11), rotr(e, 25));
+                        const __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+                        const __m256i t1 = _mm256_add_epi32(
+                            _mm256_add_epi32(_mm256_add_epi32(h, sigma1), ch),
+                            _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(constants[t])), w[t & 15]));
+
+                        const __m256i sigma0 = xor3(rotr(a, 2), rotr(a, 13), rotr(a, 22));
+                        const __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b),
+                                                            _mm256_and_si256(c, _mm256_or_si256(a, b)));
+                        const __m256i t2 = _mm256_add_epi32(sigma0, maj);
+
+                        h = g;
+                        g = f;
+                        f = e;
+                        e = _mm256_add_epi32(d, t1);
+                        d = c;
+                        c = b;
+                        b = a;
+                        a = _mm256_add_epi32(t1, t2);
+                    }
+
+                    const __m256i result[8] = {
+                        _mm256_add_epi32(a, saved[0]), _mm256_add_epi32(b, saved[1]), _mm256_add_epi32(c, saved[2]),
+                        _mm256_add_epi32(d, saved[3]), _mm256_add_epi32(e, saved[4]), _mm256_add_epi32(f, saved[5]),
+                        _mm256_add_epi32(g, saved[6]), _mm256_add_epi32(h, saved[7])};
+
+                    alignas(32) std::uint32_t lanes[8];
+                    for (std::size_t i = 0; i < 8; ++i) {
+                        _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), result[i]);
+                        for (std::size_t lane = 0; lane < 8; ++lane) {
+                            states[lane][i] = lanes[lane];
+                        }
+                    }
+                }
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // defined(__x86_64__) && defined(__GNUC__)
+
+#endif    // CRYPTO3_HASH_SHA2_256_X86_IMPL_HPP
@@ -27,8 +27,11 @@
 #ifndef CRYPTO3_HASH_SHA2_HPP
 #define CRYPTO3_HASH_SHA2_HPP
 
+#include <type_traits>
+
 #include <nil/crypto3/hash/accumulators/hash.hpp>
 #include <nil/crypto3/hash/detail/sha2/sha2_policy.hpp>
+#include <nil/crypto3/hash/detail/sha2/sha2_256_compressor.hpp>
 #include <nil/crypto3/hash/detail/state_adder.hpp>
 #include <nil/crypto3/hash/detail/davies_meyer_compressor.hpp>
 #include <nil/crypto3/hash/detail/merkle_damgard_construction.hpp>
@@ -75,9 +78,14 @@ namespace nil {
                         constexpr static const std::size_t digest_bits = policy_type::digest_bits;
                     };
 
+                    // SHA-224 and SHA-256 share the 32-bit compression function, which has a hardware backend.
+                    typedef typename std::conditional<
+                        policy_type::cipher_version == 256,
+                        detail::sha2_256_compressor,
+                        davies_meyer_compressor<block_cipher_type, detail::state_adder>>::type compressor_type;
+
                     typedef merkle_damgard_construction<params_type, typename policy_type::iv_generator,
-                                                        davies_meyer_compressor<block_cipher_type, detail::state_adder>,
-                                                        detail::merkle_damgard_padding<policy_type>>
+                                                        compressor_type, detail::merkle_damgard_padding<policy_type>>
                         type;
                 };
 
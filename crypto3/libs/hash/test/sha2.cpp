@@ -38,6 +38,7 @@
 #include <nil/crypto3/hash/adaptor/hashed.hpp>
 
 #include <nil/crypto3/hash/sha2.hpp>
+#include <nil/crypto3/hash/detail/sha2/sha2_256_hash_pairs.hpp>
 
 using namespace nil::crypto3;
 using namespace nil::crypto3::accumulators;
@@ -602,3 +603,82 @@ BOOST_AUTO_TEST_CASE(sha224_range_hash) {
 }
 
 BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(sha2_256_compressor_test_suite)
+
+using compressor_type = hashes::detail::sha2_256_compressor;
+using hashes::detail::sha2_256_backend;
+
+const std::vector<sha2_256_backend> backends = {sha2_256_backend::portable, sha2_256_backend::avx2,
+                                                sha2_256_backend::sha_ni};
+
+// Deterministic blocks and states, the compressor does not care where the words come from.
+std::vector<compressor_type::block_type> make_blocks(std::size_t count, std::uint32_t seed) {
+    std::vector<compressor_type::block_type> blocks(count);
+    for (auto &block : blocks) {
+        for (auto &word : block) {
+            seed = seed * 1664525u + 1013904223u;
+            word = seed;
+        }
+    }
+    return blocks;
+}
+
+BOOST_AUTO_TEST_CASE(sha2_256_backends_agree) {
+    // 19 is two full 8-lane batches and a tail.
+    const std::size_t count = 19;
+    const auto blocks = make_blocks(count, 1);
+    std::vector<compressor_type::state_type> expected(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        for (std::size_t j = 0; j < 8; ++j) {
+            expected[i][j] = blocks[(i + 1) % count][j];
+        }
+    }
+    const auto initial = expected;
+    for (std::size_t i = 0; i < count; ++i) {
+        compressor_type::process_block(expected[i], blocks[i], sha2_256_backend::portable);
+    }
+
+    for (auto backend : backends) {
+        if (!hashes::detail::sha2_256_backend_supported(backend)) {
+            BOOST_TEST_MESSAGE("SHA-256 backend " << static_cast<int>(backend) << " is not supported, skipped");
+            continue;
+        }
+        auto states = initial;
+        compressor_type::process_blocks(states.data(), blocks.data(), count, backend);
+        BOOST_CHECK(states == expected);
+
+        states = initial;
+        for (std::size_t i = 0; i < count; ++i) {
+            compressor_type::process_block(states[i], blocks[i], backend);
+        }
+        BOOST_CHECK(states == expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sha2_256_hash_pairs) {
+    const std::size_t count = 70;
+    std::vector<hashes::sha2<256>::digest_type> children(2 * count);
+    for (std::size_t i = 0; i < children.size(); ++i) {
+        children[i] = hash<hashes::sha2<256>>(std::vector<std::uint8_t>(i % 7, static_cast<std::uint8_t>(i)));
+    }
+
+    std::vector<hashes::sha2<256>::digest_type> expected(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        accumulator_set<hashes::sha2<256>> acc;
+        hash<hashes::sha2<256>>(children[2 * i], acc);
+        hash<hashes::sha2<256>>(children[2 * i + 1], acc);
+        expected[i] = extract::hash<hashes::sha2<256>>(acc);
+    }
+
+    for (auto backend : backends) {
+        if (!hashes::detail::sha2_256_backend_supported(backend)) {
+            continue;
+        }
+        std::vector<hashes::sha2<256>::digest_type> parents(count);
+        hashes::detail::sha2_256_hash_pairs(children.begin(), count, parents.begin(), backend);
+        BOOST_CHECK(parents == expected);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
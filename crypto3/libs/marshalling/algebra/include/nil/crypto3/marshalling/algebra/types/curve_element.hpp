@@ -39,6 +39,8 @@
 #include <nil/marshalling/types/tag.hpp>
 #include <nil/marshalling/types/detail/adapt_basic_field.hpp>
 
+#include <nil/crypto3/algebra/multiexp/batch_normalize.hpp>
+
 #include <nil/crypto3/marshalling/algebra/types/detail/curve_element/basic_type.hpp>
 #include <nil/crypto3/marshalling/algebra/inference.hpp>
 #include <nil/crypto3/marshalling/algebra/type_traits.hpp>
@@ -292,10 +294,15 @@ namespace nil {
 
                     using curve_element_type = curve_element<TTypeBase, CurveGroupType>;
 
+                    // Writing a normalized point takes no inversion, normalize them all with a single one.
+                    std::vector<typename CurveGroupType::value_type> normalized(curve_elem_vector);
+                    nil::crypto3::algebra::batch_normalize(normalized);
+
                     curve_element_vector<CurveGroupType, TTypeBase> result;
                     std::vector<curve_element_type> &val = result.value();
-                    for (std::size_t i = 0; i < curve_elem_vector.size(); i++) {
-                        val.push_back(curve_element_type(curve_elem_vector[i]));
+                    val.reserve(normalized.size());
+                    for (std::size_t i = 0; i < normalized.size(); i++) {
+                        val.push_back(curve_element_type(normalized[i]));
                     }
                     return result;
                 }
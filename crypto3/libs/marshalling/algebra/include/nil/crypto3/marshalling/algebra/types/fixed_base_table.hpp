@@ -0,0 +1,78 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MARSHALLING_FIXED_BASE_TABLE_HPP
+#define CRYPTO3_MARSHALLING_FIXED_BASE_TABLE_HPP
+
+#include <cstdint>
+#include <tuple>
+
+#include <nil/marshalling/types/bundle.hpp>
+#include <nil/marshalling/types/integral.hpp>
+#include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/options.hpp>
+
+#include <nil/crypto3/algebra/multiexp/fixed_base.hpp>
+
+#include <nil/crypto3/marshalling/algebra/types/curve_element.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace marshalling {
+            namespace types {
+
+                /* Window size followed by all the table entries, see algebra::fixed_base_table */
+                template<typename TTypeBase, typename CurveGroupType>
+                using fixed_base_table = nil::crypto3::marshalling::types::bundle<
+                    TTypeBase,
+                    std::tuple<
+                        nil::crypto3::marshalling::types::integral<TTypeBase, std::uint8_t>,
+                        curve_element_vector<CurveGroupType, TTypeBase>
+                    >
+                >;
+
+                template<typename CurveGroupType, typename Endianness>
+                fixed_base_table<nil::crypto3::marshalling::field_type<Endianness>, CurveGroupType>
+                    fill_fixed_base_table(const algebra::fixed_base_table<CurveGroupType> &table) {
+
+                    using TTypeBase = nil::crypto3::marshalling::field_type<Endianness>;
+
+                    return fixed_base_table<TTypeBase, CurveGroupType>(std::make_tuple(
+                        nil::crypto3::marshalling::types::integral<TTypeBase, std::uint8_t>(table.window()),
+                        fill_curve_element_vector<CurveGroupType, Endianness>(table.entries())));
+                }
+
+                template<typename CurveGroupType, typename Endianness>
+                algebra::fixed_base_table<CurveGroupType> make_fixed_base_table(
+                    const fixed_base_table<nil::crypto3::marshalling::field_type<Endianness>, CurveGroupType>
+                        &filled_table) {
+
+                    return algebra::fixed_base_table<CurveGroupType>(
+                        std::get<0>(filled_table.value()).value(),
+                        make_curve_element_vector<CurveGroupType, Endianness>(std::get<1>(filled_table.value())));
+                }
+            }    // namespace types
+        }        // namespace marshalling
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_MARSHALLING_FIXED_BASE_TABLE_HPP
@@ -0,0 +1,83 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE crypto3_marshalling_fixed_base_table_test
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/marshalling/status_type.hpp>
+#include <nil/marshalling/field_type.hpp>
+#include <nil/marshalling/endianness.hpp>
+
+#include <nil/crypto3/algebra/random_element.hpp>
+#include <nil/crypto3/algebra/curves/bls12.hpp>
+#include <nil/crypto3/algebra/multiexp/fixed_base.hpp>
+#include <nil/crypto3/marshalling/algebra/processing/bls12.hpp>
+
+#include <nil/crypto3/marshalling/algebra/types/fixed_base_table.hpp>
+
+template<typename Endianness, class CurveGroup>
+void test_fixed_base_table(std::size_t window) {
+    using namespace nil::crypto3::marshalling;
+    using TTypeBase = nil::crypto3::marshalling::field_type<Endianness>;
+    using unit_type = unsigned char;
+    using scalar_field_type = typename CurveGroup::curve_type::scalar_field_type;
+
+    nil::crypto3::algebra::fixed_base_table<CurveGroup> table(
+        nil::crypto3::algebra::random_element<CurveGroup>(), window);
+
+    auto filled_table = types::fill_fixed_base_table<CurveGroup, Endianness>(table);
+
+    std::vector<unit_type> cv(filled_table.length(), 0x00);
+    auto write_iter = cv.begin();
+    nil::crypto3::marshalling::status_type status = filled_table.write(write_iter, cv.size());
+    BOOST_CHECK(status == nil::crypto3::marshalling::status_type::success);
+
+    types::fixed_base_table<TTypeBase, CurveGroup> test_val_read;
+    auto read_iter = cv.begin();
+    status = test_val_read.read(read_iter, cv.size());
+    BOOST_CHECK(status == nil::crypto3::marshalling::status_type::success);
+
+    auto constructed_table = types::make_fixed_base_table<CurveGroup, Endianness>(test_val_read);
+
+    BOOST_CHECK_EQUAL(constructed_table.window(), table.window());
+    BOOST_CHECK(constructed_table.entries() == table.entries());
+
+    for (std::size_t i = 0; i < 4; ++i) {
+        auto scalar = nil::crypto3::algebra::random_element<scalar_field_type>();
+        BOOST_CHECK(constructed_table(scalar) == table(scalar));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(fixed_base_table_test_suite)
+
+BOOST_AUTO_TEST_CASE(fixed_base_table_bls12_381_g1) {
+    test_fixed_base_table<nil::crypto3::marshalling::option::big_endian,
+                          nil::crypto3::algebra::curves::bls12<381>::g1_type<>>(4);
+}
+
+BOOST_AUTO_TEST_CASE(fixed_base_table_bls12_381_g2) {
+    test_fixed_base_table<nil::crypto3::marshalling::option::big_endian,
+                          nil::crypto3::algebra::curves::bls12<381>::g2_type<>>(2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
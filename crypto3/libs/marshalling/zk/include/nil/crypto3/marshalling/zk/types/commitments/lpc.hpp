@@ -29,9 +29,13 @@
 #ifndef CRYPTO3_MARSHALLING_LPC_COMMITMENT_HPP
 #define CRYPTO3_MARSHALLING_LPC_COMMITMENT_HPP
 
+#include <cstdint>
 #include <ratio>
 #include <limits>
+#include <ostream>
+#include <stdexcept>
 #include <type_traits>
+#include <vector>
 
 #include <boost/assert.hpp>
 
@@ -286,6 +290,98 @@ namespace nil {
                     >;
                 };
 
+                // Writes a marshalled field to the stream. Fields of a bundle are written one after another without
+                // any framing, so a bundle may be written field by field with the same result.
+                template<typename Field>
+                nil::crypto3::marshalling::status_type write_marshalled_field(const Field &field, std::ostream &out) {
+                    std::vector<std::uint8_t> buffer(field.length());
+                    auto write_iter = buffer.begin();
+                    auto status = field.write(write_iter, buffer.size());
+                    out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+                    return status;
+                }
+
+                //std::map<std::size_t, bool> _batch_fixed;
+                template<typename Endianness, typename LPCScheme>
+                std::pair<
+                    nil::crypto3::marshalling::types::standard_size_t_array_list<nil::crypto3::marshalling::field_type<Endianness>>,
+                    nil::crypto3::marshalling::types::standard_size_t_array_list<nil::crypto3::marshalling::field_type<Endianness>>>
+                fill_batch_fixed(const LPCScheme &scheme) {
+                    using TTypeBase = nil::crypto3::marshalling::field_type<Endianness>;
+
+                    nil::crypto3::marshalling::types::standard_size_t_array_list<TTypeBase> filled_batch_fixed_keys;
+                    nil::crypto3::marshalling::types::standard_size_t_array_list<TTypeBase> filled_batch_fixed_values;
+                    for (const auto&[key, value]: scheme.get_batch_fixed()) {
+                        filled_batch_fixed_keys.value().push_back(
+                            nil::crypto3::marshalling::types::integral<TTypeBase, std::size_t>(key));
+                        // Here we convert the value, that is a 'bool' into size_t, which is not good.
+                        filled_batch_fixed_values.value().push_back(
+                            nil::crypto3::marshalling::types::integral<TTypeBase, std::size_t>(value));
+                    }
+                    return {filled_batch_fixed_keys, filled_batch_fixed_values};
+                }
+
+                // The polys_evaluator part of the state with empty polys keys and values. The committed polynomials
+                // are added batch by batch through visit_polys, so batches paged out to the spill file are read back
+                // one at a time.
+                template<typename Endianness, typename LPCScheme>
+                polys_evaluator<nil::crypto3::marshalling::field_type<Endianness>, typename LPCScheme::polys_evaluator_type>
+                fill_polys_evaluator_without_polys(const LPCScheme &scheme) {
+                    typename LPCScheme::polys_evaluator_type evaluator;
+                    evaluator._locked = scheme._locked;
+                    evaluator._points = scheme._points;
+                    evaluator._z = scheme._z;
+                    return fill_polys_evaluator<Endianness, typename LPCScheme::polys_evaluator_type>(evaluator);
+                }
+
+                template<typename Endianness, typename LPCScheme>
+                polys_evaluator<nil::crypto3::marshalling::field_type<Endianness>, typename LPCScheme::polys_evaluator_type>
+                fill_lpc_polys_evaluator(const LPCScheme &scheme) {
+                    using TTypeBase = nil::crypto3::marshalling::field_type<Endianness>;
+
+                    auto result = fill_polys_evaluator_without_polys<Endianness, LPCScheme>(scheme);
+                    auto &filled_polys_keys = std::get<0>(result.value()).value();
+                    auto &filled_polys_values = std::get<1>(result.value()).value();
+                    scheme.visit_polys([&](std::size_t index, const auto &polys) {
+                        filled_polys_keys.push_back(nil::crypto3::marshalling::types::integral<TTypeBase, std::size_t>(index));
+                        filled_polys_values.push_back(
+                            fill_polynomial_vector<Endianness, typename LPCScheme::polynomial_type>(polys));
+                    });
+                    return result;
+                }
+
+                // Writes the same bytes as fill_lpc_polys_evaluator(scheme), marshalling one batch of polynomials
+                // at a time.
+                template<typename Endianness, typename LPCScheme>
+                nil::crypto3::marshalling::status_type
+                write_lpc_polys_evaluator(const LPCScheme &scheme, std::ostream &out) {
+                    using TTypeBase = nil::crypto3::marshalling::field_type<Endianness>;
+                    using size_t_marshalling_type = nil::crypto3::marshalling::types::integral<TTypeBase, std::size_t>;
+
+                    const auto rest = fill_polys_evaluator_without_polys<Endianness, LPCScheme>(scheme);
+
+                    nil::crypto3::marshalling::types::standard_size_t_array_list<TTypeBase> filled_polys_keys;
+                    for (const auto &entry: scheme._polys) {
+                        filled_polys_keys.value().push_back(size_t_marshalling_type(entry.first));
+                    }
+                    auto status = write_marshalled_field(filled_polys_keys, out);
+                    // The element count of the polys values list, followed by the elements.
+                    status = status | write_marshalled_field(size_t_marshalling_type(filled_polys_keys.value().size()), out);
+                    scheme.visit_polys([&status, &out](std::size_t, const auto &polys) {
+                        status = status | write_marshalled_field(
+                            fill_polynomial_vector<Endianness, typename LPCScheme::polynomial_type>(polys), out);
+                    });
+
+                    status = status | write_marshalled_field(std::get<2>(rest.value()), out);
+                    status = status | write_marshalled_field(std::get<3>(rest.value()), out);
+                    status = status | write_marshalled_field(std::get<4>(rest.value()), out);
+                    status = status | write_marshalled_field(std::get<5>(rest.value()), out);
+                    status = status | write_marshalled_field(std::get<6>(rest.value()), out);
+                    return status;
+                }
+
+                // Throws if some merkle tree of the scheme keeps its top rows only, i.e. the scheme was loaded from
+                // compact state. Such a scheme can be saved with fill_compact_commitment_scheme only.
                 template<typename Endianness, typename LPCScheme>
                 typename commitment_scheme_state<nil::crypto3::marshalling::field_type<Endianness>, LPCScheme,
                                                  std::enable_if_t<nil::crypto3::zk::is_lpc<LPCScheme>>>::type
@@ -293,29 +389,24 @@ namespace nil {
                     using TTypeBase = nil::crypto3::marshalling::field_type<Endianness>;
                     using result_type = typename commitment_scheme_state<nil::crypto3::marshalling::field_type<Endianness>, LPCScheme>::type;
 
+                    if (scheme.has_partial_trees()) {
+                        throw std::invalid_argument("Commitment scheme with partial merkle trees must be saved as compact state");
+                    }
+
                     // std::map<std::size_t, precommitment_type> _trees;
                     nil::crypto3::marshalling::types::standard_size_t_array_list<TTypeBase> filled_trees_keys;
                     nil::crypto3::marshalling::types::standard_array_list<
                             TTypeBase,
                             typename precommitment_type<TTypeBase, LPCScheme>::type> filled_trees_values;
-                    for (const auto&[key, value]: scheme.get_trees()) {
+                    scheme.visit_trees([&](std::size_t key, const typename LPCScheme::precommitment_type &value) {
                         filled_trees_keys.value().push_back(nil::crypto3::marshalling::types::integral<TTypeBase, std::size_t>(key));
                         // Precommitment for LPC is a merkle tree. We may want to abstract away this part into a separate
                         // fill_precommitment function.
                         filled_trees_values.value().push_back(
                             fill_merkle_tree<typename LPCScheme::precommitment_type, Endianness>(value));
-                    }
+                    });
 
-                    //std::map<std::size_t, bool> _batch_fixed;
-                    nil::crypto3::marshalling::types::standard_size_t_array_list<TTypeBase> filled_batch_fixed_keys;
-                    nil::crypto3::marshalling::types::standard_size_t_array_list<TTypeBase> filled_batch_fixed_values;
-                    for (const auto&[key, value]: scheme.get_batch_fixed()) {
-                        filled_batch_fixed_keys.value().push_back(
-                            nil::crypto3::marshalling::types::integral<TTypeBase, std::size_t>(key));
-                        // Here we convert the value, that is a 'bool' into size_t, which is not good.
-                        filled_batch_fixed_values.value().push_back(
-                            nil::crypto3::marshalling::types::integral<TTypeBase, std::size_t>(value));
-                    }
+                    auto [filled_batch_fixed_keys, filled_batch_fixed_values] = fill_batch_fixed<Endianness, LPCScheme>(scheme);
 
                     return result_type(std::make_tuple(
                         filled_trees_keys,
@@ -325,11 +416,48 @@ namespace nil {
                         filled_batch_fixed_keys,
                         filled_batch_fixed_values,
                         fill_commitment_preprocessed_data<Endianness, LPCScheme>(scheme.get_fixed_polys_values()),
-                        fill_polys_evaluator<Endianness, typename LPCScheme::polys_evaluator_type>(
-                            static_cast<typename LPCScheme::polys_evaluator_type>(scheme))
+                        fill_lpc_polys_evaluator<Endianness, LPCScheme>(scheme)
                     ));
                 }
 
+                // Writes the same bytes as fill_commitment_scheme(scheme), but marshalls one merkle tree and one batch
+                // of polynomials at a time. Batches paged out under a memory budget are streamed from the spill file
+                // instead of being loaded all at once. A scheme with partial merkle trees is not written, see
+                // fill_commitment_scheme.
+                template<typename Endianness, typename LPCScheme>
+                nil::crypto3::marshalling::status_type
+                write_commitment_scheme(const LPCScheme &scheme, std::ostream &out) {
+                    using TTypeBase = nil::crypto3::marshalling::field_type<Endianness>;
+                    using size_t_marshalling_type = nil::crypto3::marshalling::types::integral<TTypeBase, std::size_t>;
+
+                    if (scheme.has_partial_trees()) {
+                        return nil::crypto3::marshalling::status_type::invalid_msg_data;
+                    }
+
+                    nil::crypto3::marshalling::types::standard_size_t_array_list<TTypeBase> filled_trees_keys;
+                    for (const auto &entry: scheme.get_trees()) {
+                        filled_trees_keys.value().push_back(size_t_marshalling_type(entry.first));
+                    }
+                    auto status = write_marshalled_field(filled_trees_keys, out);
+                    status = status | write_marshalled_field(size_t_marshalling_type(filled_trees_keys.value().size()), out);
+                    scheme.visit_trees([&status, &out](std::size_t, const typename LPCScheme::precommitment_type &tree) {
+                        status = status | write_marshalled_field(
+                            fill_merkle_tree<typename LPCScheme::precommitment_type, Endianness>(tree), out);
+                    });
+
+                    const auto [filled_batch_fixed_keys, filled_batch_fixed_values] =
+                        fill_batch_fixed<Endianness, LPCScheme>(scheme);
+                    status = status | write_marshalled_field(
+                        fill_commitment_params<Endianness, LPCScheme>(scheme.get_fri_params()), out);
+                    status = status | write_marshalled_field(
+                        field_element<TTypeBase, typename LPCScheme::value_type>(scheme.get_etha()), out);
+                    status = status | write_marshalled_field(filled_batch_fixed_keys, out);
+                    status = status | write_marshalled_field(filled_batch_fixed_values, out);
+                    status = status | write_marshalled_field(
+                        fill_commitment_preprocessed_data<Endianness, LPCScheme>(scheme.get_fixed_polys_values()), out);
+                    return status | write_lpc_polys_evaluator<Endianness, LPCScheme>(scheme, out);
+                }
+
                 template<typename Endianness, typename LPCScheme>
                 outcome::result<LPCScheme, nil::crypto3::marshalling::status_type>
                 make_commitment_scheme(
@@ -380,6 +508,195 @@ namespace nil {
                     return LPCScheme(evaluator, trees, fri_params, etha, batch_fixed, fixed_polys_values);
                 }
 
+                template <typename TTypeBase, typename CommitmentScheme, typename enable = void>
+                struct compact_commitment_scheme_state;
+
+                // First field of compact_commitment_scheme_state. The full state starts with the amount of trees, which
+                // never gets near this value, so the two formats can be told apart, see is_compact_commitment_scheme_state.
+                constexpr static const std::uint64_t compact_commitment_scheme_state_tag = 0x4c5043434f4d5054;    // "LPCCOMPT"
+
+                // Same as commitment_scheme_state, but only the top rows of every merkle tree are stored. The
+                // paths to the queried leaves are rebuilt from the committed polynomials when a proof is made,
+                // which makes the state a fraction of the size for large circuits.
+                template <typename TTypeBase, typename LPCScheme>
+                struct compact_commitment_scheme_state<TTypeBase, LPCScheme, std::enable_if_t<nil::crypto3::zk::is_lpc<LPCScheme>> > {
+                    using type = nil::crypto3::marshalling::types::bundle<
+                        TTypeBase,
+                        std::tuple<
+                            // compact_commitment_scheme_state_tag.
+                            nil::crypto3::marshalling::types::integral<TTypeBase, std::uint64_t>,
+                            // Keys of the trees.
+                            nil::crypto3::marshalling::types::standard_size_t_array_list<TTypeBase>,
+                            // Amount of stored nodes of each tree.
+                            nil::crypto3::marshalling::types::standard_size_t_array_list<TTypeBase>,
+                            // Top rows of all the trees one after another, each ending with the root.
+                            merkle_tree<TTypeBase, typename LPCScheme::precommitment_type>,
+                            // The rest is the same as in commitment_scheme_state.
+                            typename commitment_params<TTypeBase, LPCScheme>::type,
+                            field_element<TTypeBase, typename LPCScheme::value_type>,
+                            nil::crypto3::marshalling::types::standard_size_t_array_list<TTypeBase>,
+                            nil::crypto3::marshalling::types::standard_size_t_array_list<TTypeBase>,
+                            typename commitment_preprocessed_data<
+                                TTypeBase, LPCScheme,
+                                std::enable_if_t<nil::crypto3::zk::is_lpc<LPCScheme>>
+                            >::type,
+                            polys_evaluator<TTypeBase, typename LPCScheme::polys_evaluator_type>
+                        >
+                    >;
+                };
+
+                // Checks that the marshalled state in [first, first + size) starts with
+                // compact_commitment_scheme_state_tag.
+                template<typename Endianness, typename Iterator>
+                bool is_compact_commitment_scheme_state(Iterator first, std::size_t size) {
+                    nil::crypto3::marshalling::types::integral<nil::crypto3::marshalling::field_type<Endianness>, std::uint64_t> tag;
+                    return tag.read(first, size) == nil::crypto3::marshalling::status_type::success &&
+                        tag.value() == compact_commitment_scheme_state_tag;
+                }
+
+                // Keys, amounts of stored nodes and the concatenated top rows of the trees, the fields of
+                // compact_commitment_scheme_state that follow the tag.
+                template<typename Endianness, typename LPCScheme>
+                std::tuple<
+                    nil::crypto3::marshalling::types::standard_size_t_array_list<nil::crypto3::marshalling::field_type<Endianness>>,
+                    nil::crypto3::marshalling::types::standard_size_t_array_list<nil::crypto3::marshalling::field_type<Endianness>>,
+                    merkle_tree<nil::crypto3::marshalling::field_type<Endianness>, typename LPCScheme::precommitment_type>>
+                fill_tree_tops(const LPCScheme &scheme, std::size_t rows_to_discard) {
+                    using TTypeBase = nil::crypto3::marshalling::field_type<Endianness>;
+
+                    nil::crypto3::marshalling::types::standard_size_t_array_list<TTypeBase> filled_trees_keys;
+                    nil::crypto3::marshalling::types::standard_size_t_array_list<TTypeBase> filled_tops_sizes;
+                    merkle_tree<TTypeBase, typename LPCScheme::precommitment_type> filled_tops;
+                    for (const auto&[key, top]: scheme.get_tree_tops(rows_to_discard)) {
+                        filled_trees_keys.value().push_back(nil::crypto3::marshalling::types::integral<TTypeBase, std::size_t>(key));
+                        filled_tops_sizes.value().push_back(nil::crypto3::marshalling::types::integral<TTypeBase, std::size_t>(top.size()));
+                        for (const auto& node: top) {
+                            filled_tops.value().push_back(
+                                fill_merkle_node_value<typename LPCScheme::precommitment_type, Endianness>(node));
+                        }
+                    }
+                    return {filled_trees_keys, filled_tops_sizes, filled_tops};
+                }
+
+                // rows_to_discard is passed to containers::detail::merkle_tree_cache_size, i.e. all but the top
+                // (row_count - 1 - rows_to_discard) rows of each tree are dropped.
+                template<typename Endianness, typename LPCScheme>
+                typename compact_commitment_scheme_state<nil::crypto3::marshalling::field_type<Endianness>, LPCScheme,
+                                                         std::enable_if_t<nil::crypto3::zk::is_lpc<LPCScheme>>>::type
+                fill_compact_commitment_scheme(const LPCScheme &scheme, std::size_t rows_to_discard) {
+                    using TTypeBase = nil::crypto3::marshalling::field_type<Endianness>;
+                    using result_type = typename compact_commitment_scheme_state<TTypeBase, LPCScheme>::type;
+
+                    auto [filled_trees_keys, filled_tops_sizes, filled_tops] =
+                        fill_tree_tops<Endianness, LPCScheme>(scheme, rows_to_discard);
+
+                    auto [filled_batch_fixed_keys, filled_batch_fixed_values] = fill_batch_fixed<Endianness, LPCScheme>(scheme);
+
+                    return result_type(std::make_tuple(
+                        nil::crypto3::marshalling::types::integral<TTypeBase, std::uint64_t>(
+                            compact_commitment_scheme_state_tag),
+                        filled_trees_keys,
+                        filled_tops_sizes,
+                        filled_tops,
+                        fill_commitment_params<Endianness, LPCScheme>(scheme.get_fri_params()),
+                        field_element<TTypeBase, typename LPCScheme::value_type>(scheme.get_etha()),
+                        filled_batch_fixed_keys,
+                        filled_batch_fixed_values,
+                        fill_commitment_preprocessed_data<Endianness, LPCScheme>(scheme.get_fixed_polys_values()),
+                        fill_lpc_polys_evaluator<Endianness, LPCScheme>(scheme)
+                    ));
+                }
+
+                // Writes the same bytes as fill_compact_commitment_scheme(scheme, rows_to_discard), but marshalls one
+                // batch of polynomials at a time, see write_commitment_scheme.
+                template<typename Endianness, typename LPCScheme>
+                nil::crypto3::marshalling::status_type
+                write_compact_commitment_scheme(const LPCScheme &scheme, std::size_t rows_to_discard, std::ostream &out) {
+                    using TTypeBase = nil::crypto3::marshalling::field_type<Endianness>;
+
+                    auto [filled_trees_keys, filled_tops_sizes, filled_tops] =
+                        fill_tree_tops<Endianness, LPCScheme>(scheme, rows_to_discard);
+
+                    const auto [filled_batch_fixed_keys, filled_batch_fixed_values] =
+                        fill_batch_fixed<Endianness, LPCScheme>(scheme);
+                    auto status = write_marshalled_field(
+                        nil::crypto3::marshalling::types::integral<TTypeBase, std::uint64_t>(
+                            compact_commitment_scheme_state_tag), out);
+                    status = status | write_marshalled_field(filled_trees_keys, out);
+                    status = status | write_marshalled_field(filled_tops_sizes, out);
+                    status = status | write_marshalled_field(filled_tops, out);
+                    status = status | write_marshalled_field(
+                        fill_commitment_params<Endianness, LPCScheme>(scheme.get_fri_params()), out);
+                    status = status | write_marshalled_field(
+                        field_element<TTypeBase, typename LPCScheme::value_type>(scheme.get_etha()), out);
+                    status = status | write_marshalled_field(filled_batch_fixed_keys, out);
+                    status = status | write_marshalled_field(filled_batch_fixed_values, out);
+                    status = status | write_marshalled_field(
+                        fill_commitment_preprocessed_data<Endianness, LPCScheme>(scheme.get_fixed_polys_values()), out);
+                    return status | write_lpc_polys_evaluator<Endianness, LPCScheme>(scheme, out);
+                }
+
+                template<typename Endianness, typename LPCScheme>
+                outcome::result<LPCScheme, nil::crypto3::marshalling::status_type>
+                make_compact_commitment_scheme(
+                    typename compact_commitment_scheme_state<
+                        nil::crypto3::marshalling::field_type<Endianness>, LPCScheme,
+                        std::enable_if_t<nil::crypto3::zk::is_lpc<LPCScheme>>>::type& filled_commitment_scheme
+                ) {
+                    using TTypeBase = nil::crypto3::marshalling::field_type<Endianness>;
+
+                    if (std::get<0>(filled_commitment_scheme.value()).value() != compact_commitment_scheme_state_tag) {
+                        return nil::crypto3::marshalling::status_type::invalid_msg_data;
+                    }
+
+                    const auto& filled_trees_keys = std::get<1>(filled_commitment_scheme.value()).value();
+                    const auto& filled_tops_sizes = std::get<2>(filled_commitment_scheme.value()).value();
+                    const auto& filled_tops = std::get<3>(filled_commitment_scheme.value()).value();
+                    if (filled_trees_keys.size() != filled_tops_sizes.size()) {
+                        return nil::crypto3::marshalling::status_type::invalid_msg_data;
+                    }
+
+                    std::map<std::size_t, std::vector<typename LPCScheme::commitment_type>> tree_tops;
+                    std::size_t offset = 0;
+                    for (std::size_t i = 0; i < filled_trees_keys.size(); i++) {
+                        const std::size_t top_size = filled_tops_sizes[i].value();
+                        if (top_size == 0 || offset + top_size > filled_tops.size()) {
+                            return nil::crypto3::marshalling::status_type::invalid_msg_data;
+                        }
+                        auto& top = tree_tops[std::size_t(filled_trees_keys[i].value())];
+                        for (std::size_t j = 0; j < top_size; j++) {
+                            top.push_back(make_merkle_node_value<typename LPCScheme::precommitment_type, Endianness>(
+                                filled_tops[offset + j]));
+                        }
+                        offset += top_size;
+                    }
+                    if (offset != filled_tops.size()) {
+                        return nil::crypto3::marshalling::status_type::invalid_msg_data;
+                    }
+
+                    std::map<std::size_t, bool> batch_fixed;
+                    const auto& batch_fixed_keys = std::get<6>(filled_commitment_scheme.value()).value();
+                    const auto& batch_fixed_values = std::get<7>(filled_commitment_scheme.value()).value();
+                    if (batch_fixed_keys.size() != batch_fixed_values.size()) {
+                        return nil::crypto3::marshalling::status_type::invalid_msg_data;
+                    }
+                    for (std::size_t i = 0; i < batch_fixed_keys.size(); i++) {
+                        batch_fixed[std::size_t(batch_fixed_keys[i].value())] = bool(batch_fixed_values[i].value());
+                    }
+
+                    LPCScheme scheme(
+                        make_polys_evaluator<Endianness, typename LPCScheme::polys_evaluator_type>(
+                            std::get<9>(filled_commitment_scheme.value())),
+                        {},
+                        make_commitment_params<Endianness, LPCScheme>(std::get<4>(filled_commitment_scheme.value())),
+                        std::get<5>(filled_commitment_scheme.value()).value(),
+                        batch_fixed,
+                        make_commitment_preprocessed_data<Endianness, LPCScheme>(
+                            std::get<8>(filled_commitment_scheme.value())));
+                    scheme.set_tree_tops(tree_tops);
+                    return scheme;
+                }
+
                 template <typename TTypeBase, typename LPCScheme>
                 using initial_fri_proof_type = nil::crypto3::marshalling::types::bundle<
                     TTypeBase,
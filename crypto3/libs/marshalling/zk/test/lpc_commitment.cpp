@@ -33,7 +33,9 @@
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <filesystem>
 #include <regex>
+#include <sstream>
 
 #include <nil/marshalling/status_type.hpp>
 #include <nil/marshalling/field_type.hpp>
@@ -140,6 +142,7 @@ void test_lpc_state_recovery(const LPC& lpc_commitment_scheme) {
     auto write_iter = cv.begin();
     auto status = filled_lpc_scheme.write(write_iter, cv.size());
     BOOST_CHECK(status == nil::crypto3::marshalling::status_type::success);
+    BOOST_CHECK(!nil::crypto3::marshalling::types::is_compact_commitment_scheme_state<Endianness>(cv.begin(), cv.size()));
 
     typename nil::crypto3::marshalling::types::commitment_scheme_state<TTypeBase, LPC>::type test_val_read;
     auto read_iter = cv.begin();
@@ -149,6 +152,77 @@ void test_lpc_state_recovery(const LPC& lpc_commitment_scheme) {
             nil::crypto3::marshalling::types::make_commitment_scheme<Endianness, LPC>(test_val_read);
     BOOST_CHECK(constructed_val_read.has_value());
     BOOST_CHECK(lpc_commitment_scheme == constructed_val_read.value());
+
+    // Streaming the state must give the same bytes, also when the batches are in the spill file.
+    LPC spilled_scheme(lpc_commitment_scheme);
+    spilled_scheme.set_memory_budget(1, std::filesystem::temp_directory_path().string());
+    BOOST_CHECK(spilled_scheme.get_spilled_bytes() > 0);
+    for (const LPC* scheme : std::vector<const LPC*>{&lpc_commitment_scheme, &spilled_scheme}) {
+        std::ostringstream streamed;
+        status = nil::crypto3::marshalling::types::write_commitment_scheme<Endianness, LPC>(*scheme, streamed);
+        BOOST_CHECK(status == nil::crypto3::marshalling::status_type::success);
+        const std::string streamed_bytes = streamed.str();
+        BOOST_CHECK(std::vector<std::uint8_t>(streamed_bytes.begin(), streamed_bytes.end()) == cv);
+    }
+}
+
+// Same as test_lpc_state_recovery, but for the compact state that keeps only the top rows of the trees.
+template<typename Endianness, typename LPC>
+void test_compact_lpc_state_recovery(const LPC& lpc_commitment_scheme, std::size_t rows_to_discard) {
+    using TTypeBase = nil::crypto3::marshalling::field_type<Endianness>;
+
+    auto filled_lpc_scheme = nil::crypto3::marshalling::types::fill_compact_commitment_scheme<Endianness, LPC>(
+        lpc_commitment_scheme, rows_to_discard);
+
+    std::vector<std::uint8_t> cv;
+    cv.resize(filled_lpc_scheme.length(), 0x00);
+    auto write_iter = cv.begin();
+    auto status = filled_lpc_scheme.write(write_iter, cv.size());
+    BOOST_CHECK(status == nil::crypto3::marshalling::status_type::success);
+    BOOST_CHECK(nil::crypto3::marshalling::types::is_compact_commitment_scheme_state<Endianness>(cv.begin(), cv.size()));
+
+    typename nil::crypto3::marshalling::types::compact_commitment_scheme_state<TTypeBase, LPC>::type test_val_read;
+    auto read_iter = cv.begin();
+    status = test_val_read.read(read_iter, cv.size());
+    BOOST_CHECK(status == nil::crypto3::marshalling::status_type::success);
+    auto constructed_val_read =
+            nil::crypto3::marshalling::types::make_compact_commitment_scheme<Endianness, LPC>(test_val_read);
+    BOOST_CHECK(constructed_val_read.has_value());
+
+    LPC recovered_scheme = constructed_val_read.value();
+    BOOST_CHECK(recovered_scheme.has_partial_trees());
+    BOOST_CHECK(recovered_scheme.get_tree_tops(rows_to_discard) == lpc_commitment_scheme.get_tree_tops(rows_to_discard));
+
+    // The paths to the queried leaves are rebuilt from the polynomials, the proof must not change.
+    LPC full_scheme(lpc_commitment_scheme);
+    std::array<std::uint8_t, 96> x_data {};
+    typename LPC::transcript_type transcript(x_data);
+    typename LPC::transcript_type recovered_transcript(x_data);
+    BOOST_CHECK(recovered_scheme.proof_eval(recovered_transcript) == full_scheme.proof_eval(transcript));
+
+    // The full state would lack the dropped rows.
+    std::ostringstream full_state;
+    status = nil::crypto3::marshalling::types::write_commitment_scheme<Endianness, LPC>(recovered_scheme, full_state);
+    BOOST_CHECK(status != nil::crypto3::marshalling::status_type::success);
+    BOOST_CHECK_THROW((nil::crypto3::marshalling::types::fill_commitment_scheme<Endianness, LPC>(recovered_scheme)),
+                      std::invalid_argument);
+
+    // A state without the tag is not taken for a compact one.
+    std::get<0>(test_val_read.value()).value() = 0;
+    auto untagged_val_read =
+            nil::crypto3::marshalling::types::make_compact_commitment_scheme<Endianness, LPC>(test_val_read);
+    BOOST_CHECK(!untagged_val_read.has_value());
+
+    LPC spilled_scheme(lpc_commitment_scheme);
+    spilled_scheme.set_memory_budget(1, std::filesystem::temp_directory_path().string());
+    for (const LPC* scheme : std::vector<const LPC*>{&lpc_commitment_scheme, &spilled_scheme}) {
+        std::ostringstream streamed;
+        status = nil::crypto3::marshalling::types::write_compact_commitment_scheme<Endianness, LPC>(
+            *scheme, rows_to_discard, streamed);
+        BOOST_CHECK(status == nil::crypto3::marshalling::status_type::success);
+        const std::string streamed_bytes = streamed.str();
+        BOOST_CHECK(std::vector<std::uint8_t>(streamed_bytes.begin(), streamed_bytes.end()) == cv);
+    }
 }
 
 BOOST_AUTO_TEST_SUITE(marshalling_random)
@@ -282,6 +356,8 @@ BOOST_FIXTURE_TEST_CASE(batches_num_3_test, test_tools::random_test_initializer<
 
     test_lpc_proof<Endianness, lpc_scheme_type>(proof, fri_params);
     test_lpc_state_recovery<Endianness, lpc_scheme_type>(lpc_scheme_prover);
+    test_compact_lpc_state_recovery<Endianness, lpc_scheme_type>(lpc_scheme_prover, 0);
+    test_compact_lpc_state_recovery<Endianness, lpc_scheme_type>(lpc_scheme_prover, 16);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -206,17 +206,23 @@ namespace nil {
                     }
 
                     void eval_polys() {
-                        for(auto const &[k, poly] : _polys) {
-                            _z.set_batch_size(k, poly.size());
-                            auto const &point = _points.at(k);
+                        for (auto const &it : _polys) {
+                            eval_batch(it.first);
+                        }
+                    }
 
-                            BOOST_ASSERT(poly.size() == point.size() || point.size() == 1);
+                    // Evaluates the polynomials of batch k at their points, eval_polys does it for every batch.
+                    void eval_batch(std::size_t k) {
+                        auto const &poly = _polys.at(k);
+                        _z.set_batch_size(k, poly.size());
+                        auto const &point = _points.at(k);
 
-                            for (std::size_t i = 0; i < poly.size(); ++i) {
-                                _z.set_poly_points_number(k, i, point[i].size());
-                                for (std::size_t j = 0; j < point[i].size(); j++) {
-                                    _z.set(k, i, j, poly[i].evaluate(point[i][j]));
-                                }
+                        BOOST_ASSERT(poly.size() == point.size() || point.size() == 1);
+
+                        for (std::size_t i = 0; i < poly.size(); ++i) {
+                            _z.set_poly_points_number(k, i, point[i].size());
+                            for (std::size_t j = 0; j < point[i].size(); j++) {
+                                _z.set(k, i, j, poly[i].evaluate(point[i][j]));
                             }
                         }
                     }
@@ -397,6 +397,49 @@ namespace nil {
                     return (x_index + domain_size / FRI::m) % domain_size;
                 }
 
+                // Passes the values of f on the coset of leaf x_index to element_consumer in the order precommit
+                // hashes them.
+                template<typename FRI, typename ElementConsumer>
+                static void consume_coset(ElementConsumer &element_consumer,
+                                          const math::polynomial_dfs<typename FRI::field_type::value_type> &f,
+                                          const std::size_t coset_size, const std::size_t x_index) {
+                    const std::size_t domain_size = f.size();
+                    std::vector<std::array<std::size_t, FRI::m>> s_indices(coset_size / FRI::m);
+                    s_indices[0][0] = x_index;
+                    s_indices[0][1] = get_paired_index<FRI>(x_index, domain_size);
+
+                    element_consumer.consume(f[s_indices[0][0]]);
+                    element_consumer.consume(f[s_indices[0][1]]);
+
+                    std::size_t base_index = domain_size / (FRI::m * FRI::m);
+                    std::size_t prev_half_size = 1;
+                    std::size_t i = 1;
+                    while (i < coset_size / FRI::m) {
+                        for (std::size_t j = 0; j < prev_half_size; j++) {
+                            s_indices[i][0] = (base_index + s_indices[j][0]) % domain_size;
+                            s_indices[i][1] = get_paired_index<FRI>(s_indices[i][0], domain_size);
+
+                            element_consumer.consume(f[s_indices[i][0]]);
+                            element_consumer.consume(f[s_indices[i][1]]);
+
+                            i++;
+                        }
+                        base_index /= FRI::m;
+                        prev_half_size <<= 1;
+                    }
+                }
+
+                // Writes the values of the batch of codewords fs on the coset of leaf x_index in the order precommit
+                // hashes them, the cosets of all codewords one after another.
+                template<typename FRI, typename ContainerType>
+                static void fill_batch_leaf(detail::fri_field_element_consumer<FRI> &leaf, const ContainerType &fs,
+                                            const std::size_t coset_size, const std::size_t x_index) {
+                    auto& element_consumer = leaf.reset_cursor();
+                    for (const auto &f : fs) {
+                        consume_coset<FRI>(element_consumer, f, coset_size, x_index);
+                    }
+                }
+
                 template<typename FRI,
                     typename std::enable_if<
                         std::is_base_of<
@@ -516,31 +559,7 @@ namespace nil {
                     );
 
                     for (std::size_t x_index = 0; x_index < leafs_number; x_index++) {
-                        auto& element_consumer = y_data[x_index].reset_cursor();
-                        for (std::size_t polynom_index = 0; polynom_index < list_size; polynom_index++) {
-                            std::vector<std::array<std::size_t, FRI::m>> s_indices(coset_size / FRI::m);
-                            s_indices[0][0] = x_index;
-                            s_indices[0][1] = get_paired_index<FRI>(x_index, domain_size);
-
-                            element_consumer.consume(poly[polynom_index][s_indices[0][0]]);
-                            element_consumer.consume(poly[polynom_index][s_indices[0][1]]);
-
-                            std::size_t base_index = domain_size / (FRI::m * FRI::m);
-                            std::size_t prev_half_size = 1;
-                            std::size_t i = 1;
-                            while (i < coset_size / FRI::m) {
-                                for (std::size_t j = 0; j < prev_half_size; j++) {
-                                    s_indices[i][0] = (base_index + s_indices[j][0]) % domain_size;
-                                    s_indices[i][1] = get_paired_index<FRI>(s_indices[i][0], domain_size);
-                                    element_consumer.consume(poly[polynom_index][s_indices[i][0]]);
-                                    element_consumer.consume(poly[polynom_index][s_indices[i][1]]);
-
-                                    i++;
-                                }
-                                base_index /= FRI::m;
-                                prev_half_size <<= 1;
-                            }
-                        }
+                        fill_batch_leaf<FRI>(y_data[x_index], poly, coset_size, x_index);
                     }
 
                     return containers::make_merkle_tree<typename FRI::merkle_tree_hash_type, FRI::m>(y_data.begin(),
@@ -583,6 +602,26 @@ namespace nil {
                     return typename FRI::merkle_proof_type(tree, min_x_index);
                 }
 
+                // Same for a tree with discarded bottom rows, the leaves are taken again from the batch of codewords
+                // fs the tree was built from.
+                template<typename FRI>
+                static inline typename FRI::merkle_proof_type
+                make_proof_specialized(const std::size_t x_index, const std::size_t domain_size,
+                                       const typename FRI::merkle_tree_type &tree,
+                                       const std::vector<math::polynomial_dfs<typename FRI::field_type::value_type>> &fs,
+                                       const std::size_t fri_step) {
+                    if (tree.discarded_rows() == 0) {
+                        return make_proof_specialized<FRI>(x_index, domain_size, tree);
+                    }
+                    const std::size_t coset_size = 1 << fri_step;
+                    std::size_t min_x_index = std::min(x_index, get_paired_index<FRI>(x_index, domain_size));
+                    return typename FRI::merkle_proof_type(tree, min_x_index, [&fs, coset_size](std::size_t leaf_index) {
+                        detail::fri_field_element_consumer<FRI> leaf(coset_size * fs.size());
+                        fill_batch_leaf<FRI>(leaf, fs, coset_size, leaf_index);
+                        return leaf;
+                    });
+                }
+
                 template<typename FRI>
                 static inline std::size_t get_folded_index(std::size_t x_index, std::size_t domain_size,
                                                            const std::size_t fri_step) {
@@ -890,10 +929,13 @@ namespace nil {
                             }
                         }
 
-                        // Fill merkle proofs
-                        initial_proof[k].p = make_proof_specialized<FRI>(
-                                get_folded_index<FRI>(x_index, fri_params.D[0]->size(), fri_params.step_list[0]),
-                                fri_params.D[0]->size(), precommitments.at(k) );
+                        // Fill merkle proofs, the ones for trees with discarded rows are left to
+                        // query_phase_initial_proofs.
+                        if (precommitments.at(k).discarded_rows() == 0) {
+                            initial_proof[k].p = make_proof_specialized<FRI>(
+                                    get_folded_index<FRI>(x_index, fri_params.D[0]->size(), fri_params.step_list[0]),
+                                    fri_params.D[0]->size(), precommitments.at(k) );
+                        }
                     }
 
                     return std::move(initial_proof);
@@ -1019,6 +1061,7 @@ namespace nil {
                     std::map<std::size_t, std::vector<math::polynomial<typename FRI::field_type::value_type>>> g_coeffs =
                         convert_polynomials_to_coefficients<FRI, PolynomialType>(fri_params, g);
 
+                    std::vector<std::uint64_t> x_indices;
                     for (std::size_t query_id = 0; query_id < fri_params.lambda; query_id++) {
                         std::size_t domain_size = fri_params.D[0]->size();
                         typename FRI::field_type::value_type x = challenges[query_id];
@@ -1029,6 +1072,7 @@ namespace nil {
                         while (fri_params.D[0]->get_domain_element(x_index) != x) {
                             ++x_index;
                         }
+                        x_indices.push_back(x_index);
 
                         std::map<std::size_t, typename FRI::initial_proof_type>
                             initial_proof = build_initial_proof<FRI, PolynomialType>(
@@ -1037,6 +1081,54 @@ namespace nil {
 
                         proof.initial_proofs.emplace_back(std::move(initial_proof));
                     }
+
+                    // Trees with discarded rows, e.g. loaded from a compact commitment state, keep only their top rows.
+                    // The codewords of such a batch are computed once and only the paths to the queried leaves are
+                    // rebuilt from them, one batch at a time.
+                    const std::size_t domain_size = fri_params.D[0]->size();
+                    const std::size_t fri_step = fri_params.step_list[0];
+                    for (const auto &[k, tree] : precommitments) {
+                        if (tree.discarded_rows() == 0 || g.find(k) == g.end()) {
+                            continue;
+                        }
+                        std::vector<math::polynomial_dfs<typename FRI::field_type::value_type>> fs(g.at(k).size());
+                        for (std::size_t i = 0; i < fs.size(); i++) {
+                            if constexpr (std::is_same<
+                                    math::polynomial_dfs<typename FRI::field_type::value_type>,
+                                    PolynomialType>::value) {
+                                fs[i] = g.at(k)[i];
+                            } else {
+                                fs[i].from_coefficients(g.at(k)[i]);
+                            }
+                            if (fs[i].size() != domain_size) {
+                                fs[i].resize(domain_size, nullptr, fri_params.D[0]);
+                            }
+                        }
+
+                        std::size_t subtree_leaves = 1;
+                        for (std::size_t row = 0; row < tree.discarded_rows(); ++row) {
+                            subtree_leaves *= FRI::m;
+                        }
+                        if (fri_params.lambda * subtree_leaves >= tree.leaves()) {
+                            // The paths would rehash the whole tree several times, rebuild it once instead.
+                            const typename FRI::precommitment_type full_tree =
+                                precommit<FRI>(std::move(fs), fri_params.D[0], fri_step);
+                            if (full_tree.root() != tree.root()) {
+                                throw std::runtime_error("Rebuilt merkle tree does not match its stored top rows");
+                            }
+                            for (std::size_t query_id = 0; query_id < fri_params.lambda; query_id++) {
+                                proof.initial_proofs[query_id][k].p = make_proof_specialized<FRI>(
+                                    get_folded_index<FRI>(x_indices[query_id], domain_size, fri_step),
+                                    domain_size, full_tree);
+                            }
+                            continue;
+                        }
+                        for (std::size_t query_id = 0; query_id < fri_params.lambda; query_id++) {
+                            proof.initial_proofs[query_id][k].p = make_proof_specialized<FRI>(
+                                get_folded_index<FRI>(x_indices[query_id], domain_size, fri_step),
+                                domain_size, tree, fs, fri_step);
+                        }
+                    }
                     return proof;
                 }
 
@@ -0,0 +1,174 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2025 Nil Foundation AG
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_COMMITMENTS_SPILL_FILE_HPP
+#define CRYPTO3_ZK_COMMITMENTS_SPILL_FILE_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace commitments {
+                namespace detail {
+
+                    // Append-only scratch file for data that does not fit the memory budget of the prover.
+                    // Arrays are written one after another, each starting at a page boundary, and are read back
+                    // through a private mapping of their pages. The file is unlinked right after it is created,
+                    // so it is gone once the last owner closes it, also when the prover is killed.
+                    class spill_file {
+                    public:
+                        explicit spill_file(const std::string& directory) {
+                            std::string path = (directory.empty() ? std::string(".") : directory) + "/spill-XXXXXX";
+                            _fd = ::mkstemp(path.data());
+                            if (_fd < 0) {
+                                throw std::runtime_error("Can't create spill file in " + directory + ": " +
+                                                         std::strerror(errno));
+                            }
+                            ::unlink(path.c_str());
+                        }
+
+                        spill_file(const spill_file&) = delete;
+                        spill_file& operator=(const spill_file&) = delete;
+
+                        ~spill_file() {
+                            ::close(_fd);
+                        }
+
+                        // Writes count values and returns the offset to read them from.
+                        template<typename T>
+                        std::uint64_t append(const T* data, std::size_t count) {
+                            // Same requirement as for the mapped assignment table, values are stored as they are
+                            // laid out in memory.
+                            static_assert(std::is_standard_layout_v<T>);
+
+                            const std::uint64_t offset = _size;
+                            const char* bytes = reinterpret_cast<const char*>(data);
+                            std::uint64_t left = count * sizeof(T);
+                            while (left != 0) {
+                                const ssize_t written = ::pwrite(_fd, bytes, std::min<std::uint64_t>(left, 1 << 30),
+                                                                 static_cast<off_t>(_size));
+                                if (written < 0 && errno == EINTR) {
+                                    continue;
+                                }
+                                if (written <= 0) {
+                                    throw std::runtime_error(std::string("Can't write spill file: ") +
+                                                             std::strerror(errno));
+                                }
+                                bytes += written;
+                                left -= written;
+                                _size += written;
+                            }
+                            _size = (_size + page_size() - 1) / page_size() * page_size();
+                            return offset;
+                        }
+
+                        // Reads count values written at offset by append.
+                        template<typename T>
+                        void read(std::uint64_t offset, T* data, std::size_t count) const {
+                            static_assert(std::is_standard_layout_v<T>);
+
+                            const std::uint64_t bytes = count * sizeof(T);
+                            if (bytes == 0) {
+                                return;
+                            }
+                            void* mapping = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, _fd, static_cast<off_t>(offset));
+                            if (mapping == MAP_FAILED) {
+                                throw std::runtime_error(std::string("Can't map spill file: ") + std::strerror(errno));
+                            }
+                            ::madvise(mapping, bytes, MADV_SEQUENTIAL);
+                            std::memcpy(static_cast<void*>(data), mapping, bytes);
+                            ::munmap(mapping, bytes);
+                        }
+
+                        template<typename T>
+                        std::vector<T> read(std::uint64_t offset, std::size_t count) const {
+                            std::vector<T> result(count);
+                            read(offset, result.data(), count);
+                            return result;
+                        }
+
+                        // Bytes written so far, page padding included.
+                        std::uint64_t size() const {
+                            return _size;
+                        }
+
+                    private:
+                        static std::uint64_t page_size() {
+                            static const std::uint64_t size = static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE));
+                            return size;
+                        }
+
+                        int _fd;
+                        std::uint64_t _size = 0;
+                    };
+
+                    // The spill file an owner appends to. A copy of the owner starts with no file and creates its
+                    // own one on the first append, so copies used concurrently never write to the same file.
+                    // Data appended before the copy is read through the shared_ptr returned by get, the file is
+                    // removed when the last reader is gone.
+                    class spill_file_writer {
+                    public:
+                        spill_file_writer() = default;
+                        spill_file_writer(const spill_file_writer&) {}
+                        spill_file_writer(spill_file_writer&&) = default;
+
+                        spill_file_writer& operator=(const spill_file_writer& other) {
+                            if (this != &other) {
+                                _file.reset();
+                            }
+                            return *this;
+                        }
+                        spill_file_writer& operator=(spill_file_writer&&) = default;
+
+                        // Returns the file of this owner, it is created in directory the first time.
+                        std::shared_ptr<spill_file> get(const std::string& directory) {
+                            if (!_file) {
+                                _file = std::make_shared<spill_file>(directory);
+                            }
+                            return _file;
+                        }
+
+                    private:
+                        std::shared_ptr<spill_file> _file;
+                    };
+                }    // namespace detail
+            }        // namespace commitments
+        }            // namespace zk
+    }                // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_COMMITMENTS_SPILL_FILE_HPP
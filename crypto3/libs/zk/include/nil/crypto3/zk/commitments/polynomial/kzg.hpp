@@ -44,6 +44,7 @@
 #include <nil/crypto3/algebra/algorithms/pair.hpp>
 #include <nil/crypto3/algebra/multiexp/multiexp.hpp>
 #include <nil/crypto3/algebra/multiexp/policies.hpp>
+#include <nil/crypto3/algebra/multiexp/fixed_base.hpp>
 #include <nil/crypto3/algebra/random_element.hpp>
 #include <nil/crypto3/hash/block_to_field_elements_wrapper.hpp>
 
@@ -98,22 +99,14 @@ namespace nil {
                         params_type(std::size_t d) {
                             auto alpha = algebra::random_element<field_type>();
                             verification_key = verification_key_type::one() * alpha;
-                            commitment_key.resize(d);
-                            auto alpha_com = commitment_type::one();
-                            for (std::size_t i = 0; i < d; i++) {
-                                commitment_key[i] = alpha_com;
-                                alpha_com = alpha * alpha_com;
-                            }
+                            commitment_key = algebra::fixed_base_powers<typename curve_type::template g1_type<>>(
+                                commitment_type::one(), alpha, d);
                         }
 
                         params_type(std::size_t d, scalar_value_type alpha) {
                             verification_key = verification_key_type::one() * alpha;
-                            commitment_key.resize(d);
-                            auto alpha_com = commitment_type::one();
-                            for (std::size_t i = 0; i < d; i++) {
-                                commitment_key[i] = alpha_com;
-                                alpha_com = alpha * alpha_com;
-                            }
+                            commitment_key = algebra::fixed_base_powers<typename curve_type::template g1_type<>>(
+                                commitment_type::one(), alpha, d);
                         }
 
                         params_type(single_commitment_type ck, verification_key_type vk) :
@@ -275,33 +268,17 @@ namespace nil {
 
                         params_type(std::size_t d, std::size_t t) {
                             auto alpha = algebra::random_element<typename curve_type::scalar_field_type>();
-                            commitment_key.resize(d);
-                            verification_key.resize(t + 1);
-                            auto alpha_comm = single_commitment_type::one();
-                            for (std::size_t i = 0; i < d; ++i) {
-                                commitment_key[i] = alpha_comm;
-                                alpha_comm *= alpha;
-                            }
-                            auto alpha_ver = verification_key_type::one();
-                            for (std::size_t i = 0; i <= t; ++i) {
-                                verification_key[i] = alpha_ver;
-                                alpha_ver *= alpha;
-                            }
+                            commitment_key = algebra::fixed_base_powers<typename curve_type::template g1_type<>>(
+                                single_commitment_type::one(), alpha, d);
+                            verification_key = algebra::fixed_base_powers<typename curve_type::template g2_type<>>(
+                                verification_key_type::one(), alpha, t + 1);
                         }
 
                         params_type(std::size_t d, std::size_t t, scalar_value_type alpha) {
-                            commitment_key.resize(d);
-                            verification_key.resize(t + 1);
-                            auto alpha_comm = single_commitment_type::one();
-                            for (std::size_t i = 0; i < d; ++i) {
-                                commitment_key[i] = alpha_comm;
-                                alpha_comm = alpha * alpha_comm;
-                            }
-                            auto alpha_ver = verification_key_type::one();
-                            for (std::size_t i = 0; i <= t; ++i) {
-                                verification_key[i] = alpha_ver;
-                                alpha_ver = alpha * alpha_ver;
-                            }
+                            commitment_key = algebra::fixed_base_powers<typename curve_type::template g1_type<>>(
+                                single_commitment_type::one(), alpha, d);
+                            verification_key = algebra::fixed_base_powers<typename curve_type::template g2_type<>>(
+                                verification_key_type::one(), alpha, t + 1);
                         }
 
                         params_type(std::vector<single_commitment_type> commitment_key,
@@ -29,10 +29,18 @@
 #include <iostream>
 #include <fstream>
 #include <ios>
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
 
 #include <nil/crypto3/zk/snark/arithmetization/plonk/constraint_system.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/gate.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/assignment.hpp>
+#include <nil/crypto3/zk/snark/arithmetization/plonk/lookup_constraint.hpp>
+#include <nil/crypto3/zk/snark/arithmetization/plonk/lookup_gate.hpp>
+#include <nil/crypto3/zk/snark/arithmetization/plonk/lookup_table.hpp>
 
 #include <nil/crypto3/algebra/curves/alt_bn128.hpp>
 #include <nil/crypto3/algebra/curves/bls12.hpp>
@@ -83,6 +91,28 @@ Explanation:
    0
 
 The gate is enabled (with selector column) on rows from 1 to N-2.
+
+With --type synthetic a random, but always satisfied, circuit of the given
+shape is generated instead, to benchmark the prover on tables of any size.
+Witness columns are split into input columns, filled with random values,
+and output columns, one per constraint. Every constraint of every gate is
+
+  out(0) - c * in_1(r_1) * ... * in_d(r_d) - const(0) == 0
+
+with d = --gate-degree, random input columns, rotations r_k taken from
+--rotations, a random coefficient c and a random constant column (if there
+are any). Gate g is enabled by selector g % S, selector s is set on rows
+r = s (mod S) where all rotations stay inside the table.
+
+--copy-constraints-per-row random pairs of input cells are copy-constrained.
+Each of --lookup-tables tables takes one constant column with
+--lookup-table-size random values and a tag selector. Its lookup gate checks
+one reserved input column on a random --lookup-density share of rows.
+The first input columns are reserved for lookups, so there must be more
+input columns than lookup tables.
+
+The gate degree with selector is d + 1, pass a matching --max-quotient-chunks
+to the proof producer.
 )#" << std::endl;
 
     std::cout << desc << std::endl;
@@ -161,8 +191,8 @@ generate_circuit(
     selectors_assignment[0] = table[2];
 
     auto circuit_table = plonk_assignment_table<FieldType>(
-            plonk_private_assignment_table<FieldType>(private_assignment),
-    plonk_public_assignment_table<FieldType>(
+            std::make_shared<plonk_private_assignment_table<FieldType>>(private_assignment),
+            std::make_shared<plonk_public_assignment_table<FieldType>>(
                 public_input_assignment, constant_assignment, selectors_assignment));
     auto padded_rows = zk_padding<FieldType, plonk_column<FieldType>>(circuit_table, alg_rnd);
     BOOST_LOG_TRIVIAL(info) << "Rows after padding: " << padded_rows;
@@ -203,6 +233,235 @@ generate_circuit(
     return {cs, circuit_table};
 }
 
+struct synthetic_options {
+    std::size_t witness_columns;
+    std::size_t constant_columns;
+    std::size_t selector_columns;
+    std::size_t gates;
+    std::size_t constraints_per_gate;
+    std::size_t gate_degree;
+    std::string rotations;
+    double copy_constraints_per_row;
+    std::size_t lookup_tables;
+    std::size_t lookup_table_size;
+    double lookup_density;
+    std::uint32_t seed;
+};
+
+std::vector<std::int32_t> parse_rotations(std::string const& rotations)
+{
+    std::vector<std::int32_t> result;
+    std::stringstream stream(rotations);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        result.push_back(std::stoi(item));
+    }
+    return result;
+}
+
+// Layout of the synthetic circuit, see usage().
+struct synthetic_layout {
+    std::size_t input_columns;
+    std::size_t output_columns;
+    std::vector<std::int32_t> rotations;
+    std::size_t first_gate_row;
+    std::size_t last_gate_row;
+
+    synthetic_layout(synthetic_options const& opts, std::size_t rows) {
+        output_columns = opts.gates * opts.constraints_per_gate;
+        input_columns = opts.witness_columns > output_columns ? opts.witness_columns - output_columns : 0;
+        rotations = parse_rotations(opts.rotations);
+        std::int32_t min_rotation = 0, max_rotation = 0;
+        for (auto r : rotations) {
+            min_rotation = std::min(min_rotation, r);
+            max_rotation = std::max(max_rotation, r);
+        }
+        first_gate_row = -min_rotation;
+        last_gate_row = rows > std::size_t(max_rotation) ? rows - 1 - max_rotation : 0;
+    }
+
+    bool check(synthetic_options const& opts, std::size_t rows) const {
+        if (opts.gates == 0 || opts.constraints_per_gate == 0 || opts.gate_degree == 0 || opts.selector_columns == 0) {
+            BOOST_LOG_TRIVIAL(error) << "Gates, constraints per gate, gate degree and selector columns must be positive";
+            return false;
+        }
+        if (input_columns <= opts.lookup_tables) {
+            BOOST_LOG_TRIVIAL(error) << "Not enough witness columns: " << output_columns
+                << " output columns and more than " << opts.lookup_tables << " input columns are needed";
+            return false;
+        }
+        if (rotations.empty()) {
+            BOOST_LOG_TRIVIAL(error) << "At least one rotation is needed";
+            return false;
+        }
+        if (first_gate_row > last_gate_row || last_gate_row >= rows) {
+            BOOST_LOG_TRIVIAL(error) << "Not enough rows for rotations " << opts.rotations;
+            return false;
+        }
+        if (opts.lookup_tables > 0 && (opts.lookup_table_size == 0 || opts.lookup_table_size + 1 > rows)) {
+            BOOST_LOG_TRIVIAL(error) << "Lookup table size must be positive and less than the number of rows";
+            return false;
+        }
+        return true;
+    }
+};
+
+template<typename FieldType>
+std::pair<plonk_constraint_system<FieldType>, plonk_assignment_table<FieldType>>
+generate_synthetic_circuit(std::size_t rows, synthetic_options const& opts)
+{
+    using value_type = typename FieldType::value_type;
+    using variable_type = plonk_variable<value_type>;
+    using gate_type = plonk_gate<FieldType, plonk_constraint<FieldType>>;
+    using lookup_gate_type = plonk_lookup_gate<FieldType, plonk_lookup_constraint<FieldType>>;
+
+    synthetic_layout layout(opts, rows);
+
+    // Structure and values are drawn from separate generators, both seeded, so that the same options
+    // always give the same files.
+    std::mt19937_64 rng(opts.seed);
+    auto alg_rnd = nil::crypto3::random::algebraic_engine<FieldType>(opts.seed);
+    auto pick = [&rng](std::size_t n) {
+        return std::uniform_int_distribution<std::size_t>(0, n - 1)(rng);
+    };
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    const std::size_t lookup_tables = opts.lookup_tables;
+    const std::size_t constant_columns = opts.constant_columns + lookup_tables;
+    const std::size_t selector_columns = opts.selector_columns + 2 * lookup_tables;
+
+    std::vector<plonk_column<FieldType>> witnesses(opts.witness_columns, plonk_column<FieldType>(rows));
+    std::vector<plonk_column<FieldType>> constants(constant_columns, plonk_column<FieldType>(rows));
+    std::vector<plonk_column<FieldType>> selectors(selector_columns, plonk_column<FieldType>(rows, value_type::zero()));
+
+    for (std::size_t i = 0; i < layout.input_columns; i++) {
+        for (auto& cell : witnesses[i]) {
+            cell = alg_rnd();
+        }
+    }
+    for (std::size_t i = 0; i < opts.constant_columns; i++) {
+        for (auto& cell : constants[i]) {
+            cell = alg_rnd();
+        }
+    }
+
+    /* Lookup tables: constant column opts.constant_columns + t, tag selector opts.selector_columns + lookup_tables + t,
+       lookup gate selector opts.selector_columns + t, looked up values in input column t. */
+    std::vector<plonk_lookup_table<FieldType>> tables;
+    std::vector<lookup_gate_type> lookup_gates;
+    for (std::size_t t = 0; t < lookup_tables; t++) {
+        const std::size_t table_column = opts.constant_columns + t;
+        const std::size_t tag_selector = opts.selector_columns + lookup_tables + t;
+        const std::size_t gate_selector = opts.selector_columns + t;
+
+        // Row 0 is left out, like in the packed tables of the real circuits
+        for (std::size_t row = 1; row <= opts.lookup_table_size; row++) {
+            constants[table_column][row] = alg_rnd();
+            selectors[tag_selector][row] = value_type::one();
+        }
+        for (std::size_t row = 0; row < rows; row++) {
+            if (uniform(rng) < opts.lookup_density) {
+                selectors[gate_selector][row] = value_type::one();
+                witnesses[t][row] = constants[table_column][1 + pick(opts.lookup_table_size)];
+            }
+        }
+
+        plonk_lookup_table<FieldType> table(1, tag_selector);
+        table.append_option({variable_type(table_column, 0, true, variable_type::column_type::constant)});
+        tables.push_back(table);
+
+        plonk_lookup_constraint<FieldType> lookup_constraint;
+        lookup_constraint.table_id = t + 1;
+        lookup_constraint.lookup_input.push_back(variable_type(t, 0, true, variable_type::column_type::witness));
+        lookup_gates.push_back(lookup_gate_type(gate_selector, {lookup_constraint}));
+    }
+
+    /* Copy constraints between input cells not used by lookups. A cell takes part in at most one copy constraint,
+       so the copied values never conflict. */
+    std::vector<plonk_copy_constraint<FieldType>> copy_constraints;
+    const std::size_t copy_columns = layout.input_columns - lookup_tables;
+    const std::size_t copy_count = opts.copy_constraints_per_row * rows;
+    std::vector<bool> used(copy_columns * rows, false);
+    for (std::size_t i = 0; i < copy_count; i++) {
+        std::size_t from = pick(copy_columns * rows), to = pick(copy_columns * rows);
+        if (from == to || used[from] || used[to]) {
+            continue;
+        }
+        used[from] = used[to] = true;
+        std::size_t from_column = lookup_tables + from / rows, from_row = from % rows;
+        std::size_t to_column = lookup_tables + to / rows, to_row = to % rows;
+        witnesses[to_column][to_row] = witnesses[from_column][from_row];
+        copy_constraints.emplace_back(
+            variable_type(from_column, from_row, false, variable_type::column_type::witness),
+            variable_type(to_column, to_row, false, variable_type::column_type::witness));
+    }
+    BOOST_LOG_TRIVIAL(info) << "Copy constraints: " << copy_constraints.size();
+
+    for (std::size_t s = 0; s < opts.selector_columns; s++) {
+        for (std::size_t row = layout.first_gate_row; row <= layout.last_gate_row; row++) {
+            if (row % opts.selector_columns == s) {
+                selectors[s][row] = value_type::one();
+            }
+        }
+    }
+
+    /* Gates. Inputs are only read from input columns, so outputs are computed in one pass over the rows. */
+    std::vector<gate_type> gates;
+    std::size_t output_column = layout.input_columns;
+    for (std::size_t g = 0; g < opts.gates; g++) {
+        const std::size_t selector = g % opts.selector_columns;
+        std::vector<plonk_constraint<FieldType>> constraints;
+        for (std::size_t c = 0; c < opts.constraints_per_gate; c++, output_column++) {
+            const value_type coefficient = alg_rnd();
+            std::vector<variable_type> inputs;
+            for (std::size_t k = 0; k < opts.gate_degree; k++) {
+                inputs.emplace_back(pick(layout.input_columns), layout.rotations[pick(layout.rotations.size())],
+                                    true, variable_type::column_type::witness);
+            }
+            const bool has_constant = opts.constant_columns > 0;
+            const std::size_t constant_column = has_constant ? pick(opts.constant_columns) : 0;
+
+            typename plonk_constraint<FieldType>::term_type product(coefficient);
+            for (const auto& input : inputs) {
+                product = product * input;
+            }
+            plonk_constraint<FieldType> constraint =
+                variable_type(output_column, 0, true, variable_type::column_type::witness) - product;
+            if (has_constant) {
+                constraint -= variable_type(constant_column, 0, true, variable_type::column_type::constant);
+            }
+            constraints.push_back(constraint);
+
+            for (std::size_t row = 0; row < rows; row++) {
+                if (selectors[selector][row] == value_type::zero()) {
+                    witnesses[output_column][row] = alg_rnd();
+                    continue;
+                }
+                value_type value = coefficient;
+                for (const auto& input : inputs) {
+                    value *= witnesses[input.index][row + input.rotation];
+                }
+                if (has_constant) {
+                    value += constants[constant_column][row];
+                }
+                witnesses[output_column][row] = value;
+            }
+        }
+        gates.push_back(gate_type(selector, constraints));
+    }
+
+    auto circuit_table = plonk_assignment_table<FieldType>(
+        std::make_shared<plonk_private_assignment_table<FieldType>>(witnesses),
+        std::make_shared<plonk_public_assignment_table<FieldType>>(
+            std::vector<plonk_column<FieldType>>(), constants, selectors));
+    auto padded_rows = zk_padding<FieldType, plonk_column<FieldType>>(circuit_table, alg_rnd);
+    BOOST_LOG_TRIVIAL(info) << "Rows after padding: " << padded_rows;
+
+    plonk_constraint_system<FieldType> cs(gates, copy_constraints, lookup_gates, tables);
+
+    return {cs, circuit_table};
+}
+
 template<typename MarshallingType>
 bool encode_marshalling_to_file(
         const boost::filesystem::path& path,
@@ -211,9 +470,9 @@ bool encode_marshalling_to_file(
     std::vector<std::uint8_t> v;
     v.resize(data_for_marshalling.length(), 0x00);
     auto write_iter = v.begin();
-    nil::marshalling::status_type status = data_for_marshalling.write(write_iter, v.size());
+    nil::crypto3::marshalling::status_type status = data_for_marshalling.write(write_iter, v.size());
 
-    if (status != nil::marshalling::status_type::success) {
+    if (status != nil::crypto3::marshalling::status_type::success) {
         BOOST_LOG_TRIVIAL(error) << "Marshalled structure encoding failed";
         return false;
     }
@@ -229,23 +488,25 @@ bool encode_marshalling_to_file(
 
 struct circgen_options {
     std::string field;
+    std::string type;
     std::size_t rows;
     std::string a, b;
     boost::filesystem::path output_dir, circuit, assignment_table;
+    synthetic_options synthetic;
 };
 
 
 template<typename circuit_field>
 int run_main(circgen_options const& opts)
 {
-    using endianness = nil::marshalling::option::big_endian;
+    using endianness = nil::crypto3::marshalling::option::big_endian;
 
     using constraint_system = plonk_constraint_system<circuit_field>;
     using assignment_table = plonk_assignment_table<circuit_field>;
     using column = nil::crypto3::zk::snark::plonk_column<circuit_field>;
     using plonk_table = nil::crypto3::zk::snark::plonk_table<circuit_field, column>;
 
-    using marshalling_field_type = nil::marshalling::field_type<endianness>;
+    using marshalling_field_type = nil::crypto3::marshalling::field_type<endianness>;
     using mcs = nil::crypto3::marshalling::types::plonk_constraint_system<marshalling_field_type, constraint_system>;
     using mat = nil::crypto3::marshalling::types::plonk_assignment_table<marshalling_field_type, assignment_table>;
 
@@ -261,12 +522,25 @@ int run_main(circgen_options const& opts)
         }
     }
 
-    value_type a (integral_type(opts.a)), b (integral_type(opts.b));
+    std::pair<constraint_system, assignment_table> circuit;
+    if (opts.type == "fibonacci") {
+        value_type a (integral_type(opts.a)), b (integral_type(opts.b));
+
+        BOOST_LOG_TRIVIAL(info) << "Generating circuit and assignment table for " << opts.rows << " rows.";
+        BOOST_LOG_TRIVIAL(info) << "Public inputs: a = " << a << ", b = " << b;
 
-    BOOST_LOG_TRIVIAL(info) << "Generating circuit and assignment table for " << opts.rows << " rows.";
-    BOOST_LOG_TRIVIAL(info) << "Public inputs: a = " << a << ", b = " << b;
+        circuit = generate_circuit<circuit_field>(opts.rows, a, b);
+    } else if (opts.type == "synthetic") {
+        if (!synthetic_layout(opts.synthetic, opts.rows).check(opts.synthetic, opts.rows)) {
+            return 1;
+        }
+        BOOST_LOG_TRIVIAL(info) << "Generating synthetic circuit and assignment table for " << opts.rows << " rows.";
 
-    auto circuit = generate_circuit<circuit_field>(opts.rows, a, b);
+        circuit = generate_synthetic_circuit<circuit_field>(opts.rows, opts.synthetic);
+    } else {
+        BOOST_LOG_TRIVIAL(error) << "Unknown circuit type: '" << opts.type << "'";
+        return 1;
+    }
 
     mcs marshalled_cs = nil::crypto3::marshalling::types::fill_plonk_constraint_system<endianness>(circuit.first);
     mat marshalled_at = nil::crypto3::marshalling::types::fill_assignment_table<endianness, plonk_table>(opts.rows, circuit.second);
@@ -294,12 +568,25 @@ po::options_description define_options(circgen_options &opts)
     desc.add_options()
         ("help", "Print help")
         ("field", make_defaulted_option(opts.field), "Circuit field")
+        ("type", make_defaulted_option(opts.type), "Circuit type: fibonacci or synthetic")
         ("rows", make_defaulted_option(opts.rows), "Number of rows to generate")
         ("a", make_defaulted_option(opts.a), "Public input a")
         ("b", make_defaulted_option(opts.b), "Public input b")
         ("output-dir", make_defaulted_option(opts.output_dir), "Output directory")
         ("circuit", make_defaulted_option(opts.circuit), "Circuit filename")
         ("assignment", make_defaulted_option(opts.assignment_table), "Assignment table filename")
+        ("witness-columns", make_defaulted_option(opts.synthetic.witness_columns), "Synthetic: witness columns")
+        ("constant-columns", make_defaulted_option(opts.synthetic.constant_columns), "Synthetic: constant columns, besides lookup tables")
+        ("selector-columns", make_defaulted_option(opts.synthetic.selector_columns), "Synthetic: gate selector columns")
+        ("gates", make_defaulted_option(opts.synthetic.gates), "Synthetic: number of gates")
+        ("constraints-per-gate", make_defaulted_option(opts.synthetic.constraints_per_gate), "Synthetic: constraints of each gate")
+        ("gate-degree", make_defaulted_option(opts.synthetic.gate_degree), "Synthetic: degree of constraints, without selector")
+        ("rotations", make_defaulted_option(opts.synthetic.rotations), "Synthetic: comma separated rotations of gate inputs")
+        ("copy-constraints-per-row", make_defaulted_option(opts.synthetic.copy_constraints_per_row), "Synthetic: copy constraints per row")
+        ("lookup-tables", make_defaulted_option(opts.synthetic.lookup_tables), "Synthetic: number of lookup tables")
+        ("lookup-table-size", make_defaulted_option(opts.synthetic.lookup_table_size), "Synthetic: rows of each lookup table")
+        ("lookup-density", make_defaulted_option(opts.synthetic.lookup_density), "Synthetic: share of rows looked up in each table")
+        ("seed", make_defaulted_option(opts.synthetic.seed), "Synthetic: random seed")
         ;
 
     return desc;
@@ -311,12 +598,27 @@ int main(int argc, char *argv[])
 
     circgen_options opts {
         .field = "pallas",
+        .type = "fibonacci",
         .rows = 127,
         .a = "1",
         .b = "1",
         .output_dir = ".",
         .circuit = "circuit.crct",
-        .assignment_table = "assignment.tbl"
+        .assignment_table = "assignment.tbl",
+        .synthetic = {
+            .witness_columns = 8,
+            .constant_columns = 1,
+            .selector_columns = 2,
+            .gates = 2,
+            .constraints_per_gate = 2,
+            .gate_degree = 2,
+            .rotations = "-1,0,1",
+            .copy_constraints_per_row = 0.5,
+            .lookup_tables = 1,
+            .lookup_table_size = 64,
+            .lookup_density = 0.5,
+            .seed = 0
+        }
     };
 
     po::options_description desc = define_options(opts);
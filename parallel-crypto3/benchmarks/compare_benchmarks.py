@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+"""Compares placeholder_benchmark JSON results against a stored baseline.
+
+Results are matched by name (hash, table size, expand factor and thread count), so several result files, e.g.
+one per thread count, may be given on both sides. Exits with status 1 if any wall time, stage time or peak heap
+grew by more than the threshold, or any proof got larger.
+
+    compare_benchmarks.py --baseline baseline/*.json --current current/*.json --threshold 0.1
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_results(files):
+    results = {}
+    for file_name in files:
+        with open(file_name) as f:
+            for result in json.load(f)["results"]:
+                results[result["name"]] = result
+    return results
+
+
+def metrics(result):
+    yield "wall_seconds", result["wall_seconds"]
+    yield "peak_bytes", result["peak_bytes"]
+    for stage, values in result["stages"].items():
+        yield stage + ".seconds", values["seconds"]
+        yield stage + ".peak_bytes", values["peak_bytes"]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare placeholder benchmark results against a baseline")
+    parser.add_argument("--baseline", nargs="+", required=True, help="Baseline JSON files")
+    parser.add_argument("--current", nargs="+", required=True, help="Current JSON files")
+    parser.add_argument("--threshold", type=float, default=0.1,
+                        help="Relative growth of a time or a peak reported as a regression (default 0.1)")
+    parser.add_argument("--min-seconds", type=float, default=0.05,
+                        help="Times below this in the baseline are too noisy to compare (default 0.05)")
+    args = parser.parse_args()
+
+    baseline = load_results(args.baseline)
+    current = load_results(args.current)
+
+    regressions = []
+    print("{:<48} {:<28} {:>14} {:>14} {:>8}".format("benchmark", "metric", "baseline", "current", "change"))
+    for name in sorted(current):
+        if name not in baseline:
+            print("{:<48} not in baseline".format(name))
+            continue
+        old, new = baseline[name], current[name]
+        if not new["verified"]:
+            regressions.append((name, "verified", True, False))
+        if new["proof_size_bytes"] > old["proof_size_bytes"]:
+            regressions.append((name, "proof_size_bytes", old["proof_size_bytes"], new["proof_size_bytes"]))
+        old_metrics = dict(metrics(old))
+        for metric, value in metrics(new):
+            if metric not in old_metrics:
+                continue
+            old_value = old_metrics[metric]
+            if old_value == 0 or (metric.endswith("seconds") and old_value < args.min_seconds):
+                continue
+            change = value / old_value - 1
+            print("{:<48} {:<28} {:>14.6g} {:>14.6g} {:>+7.1f}%".format(name, metric, old_value, value, 100 * change))
+            if change > args.threshold:
+                regressions.append((name, metric, old_value, value))
+    for name in sorted(set(baseline) - set(current)):
+        print("{:<48} missing in current results".format(name))
+
+    if regressions:
+        print("\nRegressions:")
+        for name, metric, old_value, value in regressions:
+            print("  {} {}: {} -> {}".format(name, metric, old_value, value))
+        return 1
+    print("\nNo regressions")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,395 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2025 Nil Foundation AG
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// End-to-end placeholder benchmark: preprocess, prove and verify a synthetic circuit for every combination
+// of table size, FRI expand factor and hash, and write the results as JSON. Thread count is fixed for the whole
+// process, run the benchmark once per thread count. See README.md for the options and the comparison script.
+//
+
+#define BOOST_TEST_MODULE placeholder_benchmark
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/mpl/list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/algebra/curves/pallas.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/pallas.hpp>
+#include <nil/crypto3/hash/keccak.hpp>
+#include <nil/crypto3/hash/poseidon.hpp>
+#include <nil/crypto3/hash/sha2.hpp>
+#include <nil/crypto3/random/algebraic_engine.hpp>
+
+#include <nil/crypto3/zk/commitments/polynomial/fri.hpp>
+#include <nil/crypto3/zk/commitments/polynomial/lpc.hpp>
+#include <nil/crypto3/zk/snark/arithmetization/plonk/padding.hpp>
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/params.hpp>
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/preprocessor.hpp>
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/prover.hpp>
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/verifier.hpp>
+
+#include <nil/crypto3/marshalling/zk/types/placeholder/proof.hpp>
+
+#include <nil/actor/core/thread_pool.hpp>
+
+#include <nil/crypto3/bench/memory_stats.hpp>
+#include <nil/crypto3/bench/memory_stats_new_delete.hpp>
+
+using namespace nil::crypto3;
+using namespace nil::crypto3::zk;
+using namespace nil::crypto3::zk::snark;
+
+// Options are passed after "--" on the command line, e.g.
+//   placeholder_benchmark -- --rows-log 16,18 --expand-factors 2,3 --threads 16 --output bench.json
+struct benchmark_config {
+    std::vector<std::size_t> rows_log = {10};
+    std::vector<std::size_t> expand_factors = {2};
+    std::vector<std::string> hashes;    // empty means all
+    std::size_t threads = std::thread::hardware_concurrency();
+    std::size_t witness_columns = 15;
+    std::size_t lambda = 9;
+    std::size_t repeat = 1;
+    std::string output = "placeholder_benchmark.json";
+
+    bool runs_hash(const std::string& name) const {
+        return hashes.empty() || std::find(hashes.begin(), hashes.end(), name) != hashes.end();
+    }
+};
+
+struct stage_result {
+    double seconds;
+    std::int64_t peak_bytes;
+};
+
+struct benchmark_result {
+    std::string name;
+    std::string hash;
+    std::size_t rows_log;
+    std::size_t expand_factor;
+    std::size_t threads;
+    std::size_t witness_columns;
+    double wall_seconds;
+    std::vector<std::pair<std::string, stage_result>> stages;
+    std::int64_t peak_bytes;
+    std::size_t proof_size;
+    bool verified;
+};
+
+benchmark_config& config() {
+    static benchmark_config instance;
+    return instance;
+}
+
+std::vector<benchmark_result>& results() {
+    static std::vector<benchmark_result> instance;
+    return instance;
+}
+
+template<typename T>
+std::vector<T> parse_list(const std::string& value) {
+    std::vector<T> list;
+    std::stringstream stream(value);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        std::stringstream item_stream(item);
+        T parsed;
+        item_stream >> parsed;
+        list.push_back(parsed);
+    }
+    return list;
+}
+
+void write_json(std::ostream& out, const benchmark_config& cfg, const std::vector<benchmark_result>& all_results) {
+    out << "{\n  \"benchmark\": \"placeholder\",\n  \"threads\": " << cfg.threads
+        << ",\n  \"peak_rss_bytes\": " << bench::memory_stats::peak_rss_bytes()
+        << ",\n  \"results\": [";
+    for (std::size_t i = 0; i < all_results.size(); i++) {
+        const auto& r = all_results[i];
+        out << (i == 0 ? "\n" : ",\n")
+            << "    {\"name\": \"" << r.name << "\", \"hash\": \"" << r.hash << "\""
+            << ", \"rows_log\": " << r.rows_log
+            << ", \"expand_factor\": " << r.expand_factor
+            << ", \"threads\": " << r.threads
+            << ", \"witness_columns\": " << r.witness_columns
+            << ", \"wall_seconds\": " << r.wall_seconds
+            << ", \"peak_bytes\": " << r.peak_bytes
+            << ", \"proof_size_bytes\": " << r.proof_size
+            << ", \"verified\": " << (r.verified ? "true" : "false")
+            << ", \"stages\": {";
+        for (std::size_t j = 0; j < r.stages.size(); j++) {
+            out << (j == 0 ? "" : ", ") << "\"" << r.stages[j].first << "\": {\"seconds\": " << r.stages[j].second.seconds
+                << ", \"peak_bytes\": " << r.stages[j].second.peak_bytes << "}";
+        }
+        out << "}}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+// Parses the options and sizes the thread pools before anything uses them, writes the results at the end.
+struct benchmark_fixture {
+    benchmark_fixture() {
+        auto& suite = boost::unit_test::framework::master_test_suite();
+        auto& cfg = config();
+        for (int i = 1; i + 1 < suite.argc; i += 2) {
+            const std::string key = suite.argv[i], value = suite.argv[i + 1];
+            if (key == "--rows-log") {
+                cfg.rows_log = parse_list<std::size_t>(value);
+            } else if (key == "--expand-factors") {
+                cfg.expand_factors = parse_list<std::size_t>(value);
+            } else if (key == "--hashes") {
+                cfg.hashes = parse_list<std::string>(value);
+            } else if (key == "--threads") {
+                cfg.threads = std::stoul(value);
+            } else if (key == "--witness-columns") {
+                cfg.witness_columns = std::stoul(value);
+            } else if (key == "--lambda") {
+                cfg.lambda = std::stoul(value);
+            } else if (key == "--repeat") {
+                cfg.repeat = std::max<std::size_t>(1, std::stoul(value));
+            } else if (key == "--output") {
+                cfg.output = value;
+            } else {
+                BOOST_TEST_MESSAGE("Unknown benchmark option " << key);
+            }
+        }
+        ThreadPool::get_instance(ThreadPool::PoolLevel::LOW, cfg.threads);
+        ThreadPool::get_instance(ThreadPool::PoolLevel::HIGH, cfg.threads);
+        ThreadPool::get_instance(ThreadPool::PoolLevel::LASTPOOL, cfg.threads);
+        bench::memory_stats::instance().enable();
+    }
+
+    ~benchmark_fixture() {
+        std::ofstream out(config().output);
+        write_json(out, config(), results());
+        std::cout << "Benchmark results written to " << config().output << std::endl;
+    }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE(benchmark_fixture);
+
+//---------------------------------------------------------------------------//
+// Synthetic circuit: random columns w_0 and w_1, every other witness column is
+//   w_k(0) = w_{k-2}(0) * w_{k-1}(-1)
+// on rows 1 .. usable_rows - 1 (one gate, one selector). Every 16th row w_0 is copy-constrained
+// to w_1 on the next row.
+//---------------------------------------------------------------------------//
+template<typename FieldType>
+struct synthetic_circuit {
+    using value_type = typename FieldType::value_type;
+    using variable_type = plonk_variable<value_type>;
+
+    plonk_assignment_table<FieldType> table;
+    plonk_constraint_system<FieldType> constraint_system;
+    std::size_t usable_rows;
+    std::size_t table_rows;
+
+    synthetic_circuit(std::size_t rows_log, std::size_t witness_columns) {
+        BOOST_ASSERT(witness_columns >= 3);
+        random::algebraic_engine<FieldType> alg_rnd;
+        usable_rows = (std::size_t(1) << rows_log) - 1;
+
+        std::vector<plonk_column<FieldType>> witnesses(witness_columns, plonk_column<FieldType>(usable_rows));
+        std::vector<plonk_column<FieldType>> selectors(1, plonk_column<FieldType>(usable_rows, value_type::one()));
+        selectors[0][0] = value_type::zero();
+
+        std::vector<plonk_copy_constraint<FieldType>> copy_constraints;
+        for (std::size_t row = 0; row < usable_rows; row++) {
+            witnesses[0][row] = alg_rnd();
+            if (row > 0 && (row - 1) % 16 == 0) {
+                witnesses[1][row] = witnesses[0][row - 1];
+                copy_constraints.emplace_back(
+                    variable_type(0, row - 1, false, variable_type::column_type::witness),
+                    variable_type(1, row, false, variable_type::column_type::witness));
+            } else {
+                witnesses[1][row] = alg_rnd();
+            }
+            for (std::size_t k = 2; k < witness_columns; k++) {
+                witnesses[k][row] = row == 0 ? alg_rnd() : witnesses[k - 2][row] * witnesses[k - 1][row - 1];
+            }
+        }
+
+        std::vector<plonk_constraint<FieldType>> constraints;
+        for (std::size_t k = 2; k < witness_columns; k++) {
+            constraints.push_back(
+                variable_type(k, 0, true, variable_type::column_type::witness) -
+                variable_type(k - 2, 0, true, variable_type::column_type::witness) *
+                variable_type(k - 1, -1, true, variable_type::column_type::witness));
+        }
+
+        table = plonk_assignment_table<FieldType>(
+            std::make_shared<plonk_private_assignment_table<FieldType>>(witnesses),
+            std::make_shared<plonk_public_assignment_table<FieldType>>(
+                std::vector<plonk_column<FieldType>>(), std::vector<plonk_column<FieldType>>(), selectors));
+        table_rows = zk_padding<FieldType, plonk_column<FieldType>>(table, alg_rnd);
+
+        constraint_system = plonk_constraint_system<FieldType>(
+            {plonk_gate<FieldType, plonk_constraint<FieldType>>(0, constraints)}, copy_constraints);
+    }
+};
+
+using field_type = algebra::curves::pallas::base_field_type;
+
+struct keccak_256_case {
+    using hash_type = hashes::keccak_1600<256>;
+    static constexpr const char* name = "keccak_256";
+};
+
+struct sha2_256_case {
+    using hash_type = hashes::sha2<256>;
+    static constexpr const char* name = "sha2_256";
+};
+
+struct poseidon_case {
+    using hash_type = hashes::poseidon<hashes::detail::pasta_poseidon_policy<field_type>>;
+    static constexpr const char* name = "poseidon";
+};
+
+using hash_cases = boost::mpl::list<keccak_256_case, sha2_256_case, poseidon_case>;
+
+template<typename HashType>
+benchmark_result run_placeholder(const synthetic_circuit<field_type>& circuit,
+                                 std::size_t rows_log, std::size_t expand_factor) {
+    using circuit_params = placeholder_circuit_params<field_type>;
+    using transcript_type = transcript::fiat_shamir_heuristic_sequential<HashType>;
+    using lpc_params_type = commitments::list_polynomial_commitment_params<HashType, HashType, 2>;
+    using lpc_type = commitments::list_polynomial_commitment<field_type, lpc_params_type>;
+    using lpc_scheme_type = commitments::lpc_commitment_scheme<lpc_type>;
+    using placeholder_params_type = placeholder_params<circuit_params, lpc_scheme_type>;
+    using policy_type = zk::snark::detail::placeholder_policy<field_type, placeholder_params_type>;
+    using proof_type = placeholder_proof<field_type, placeholder_params_type>;
+    using endianness = nil::crypto3::marshalling::option::big_endian;
+
+    const auto& cfg = config();
+    benchmark_result result{};
+    result.rows_log = rows_log;
+    result.expand_factor = expand_factor;
+    result.threads = cfg.threads;
+    result.witness_columns = cfg.witness_columns;
+
+    plonk_table_description<field_type> desc(
+        circuit.table.witnesses_amount(), circuit.table.public_inputs_amount(),
+        circuit.table.constants_amount(), circuit.table.selectors_amount(),
+        circuit.usable_rows, circuit.table_rows);
+    typename policy_type::constraint_system_type constraint_system(circuit.constraint_system);
+    typename lpc_type::fri_type::params_type fri_params(1, rows_log, cfg.lambda, expand_factor);
+
+    auto run_stage = [&result](const char* name, const std::function<void()>& stage) {
+        bench::memory_scope memory(name);
+        const auto start = std::chrono::steady_clock::now();
+        stage();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        result.stages.emplace_back(name, stage_result{elapsed.count(), memory.peak_live_bytes()});
+    };
+
+    bench::memory_scope total_memory("total");
+    const auto start = std::chrono::steady_clock::now();
+
+    lpc_scheme_type lpc_scheme(fri_params);
+    std::optional<typename placeholder_public_preprocessor<field_type, placeholder_params_type>::preprocessed_data_type>
+        public_data;
+    std::optional<typename placeholder_private_preprocessor<field_type, placeholder_params_type>::preprocessed_data_type>
+        private_data;
+    std::optional<proof_type> proof;
+
+    run_stage("preprocess_public", [&]() {
+        public_data.emplace(placeholder_public_preprocessor<field_type, placeholder_params_type>::process(
+            constraint_system, circuit.table.public_table(), desc, lpc_scheme));
+    });
+    run_stage("preprocess_private", [&]() {
+        private_data.emplace(placeholder_private_preprocessor<field_type, placeholder_params_type>::process(
+            constraint_system, circuit.table.private_table(), desc));
+    });
+    run_stage("prove", [&]() {
+        proof.emplace(placeholder_prover<field_type, placeholder_params_type>::process(
+            *public_data, std::move(*private_data), desc, constraint_system, lpc_scheme));
+    });
+    run_stage("verify", [&]() {
+        lpc_scheme_type verifier_lpc_scheme(fri_params);
+        result.verified = placeholder_verifier<field_type, placeholder_params_type>::process(
+            public_data->common_data, *proof, desc, constraint_system, verifier_lpc_scheme);
+    });
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    result.wall_seconds = elapsed.count();
+    result.peak_bytes = total_memory.peak_live_bytes();
+    result.proof_size = nil::crypto3::marshalling::types::fill_placeholder_proof<endianness, proof_type>(
+        *proof, fri_params).length();
+    return result;
+}
+
+BOOST_AUTO_TEST_SUITE(placeholder_benchmark_suite)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(placeholder_end_to_end, HashCase, hash_cases) {
+    const auto& cfg = config();
+    if (!cfg.runs_hash(HashCase::name)) {
+        return;
+    }
+    for (std::size_t rows_log : cfg.rows_log) {
+        const synthetic_circuit<field_type> circuit(rows_log, cfg.witness_columns);
+        for (std::size_t expand_factor : cfg.expand_factors) {
+            std::stringstream name;
+            name << HashCase::name << "/rows_2^" << rows_log << "/expand_" << expand_factor
+                 << "/threads_" << cfg.threads;
+
+            // Times and peaks are the minimum over the repetitions, which is the least noisy estimate.
+            benchmark_result best;
+            for (std::size_t i = 0; i < cfg.repeat; i++) {
+                benchmark_result current =
+                    run_placeholder<typename HashCase::hash_type>(circuit, rows_log, expand_factor);
+                BOOST_CHECK(current.verified);
+                if (i == 0) {
+                    best = std::move(current);
+                    continue;
+                }
+                best.wall_seconds = std::min(best.wall_seconds, current.wall_seconds);
+                best.peak_bytes = std::min(best.peak_bytes, current.peak_bytes);
+                best.verified = best.verified && current.verified;
+                for (std::size_t s = 0; s < best.stages.size(); s++) {
+                    best.stages[s].second.seconds =
+                        std::min(best.stages[s].second.seconds, current.stages[s].second.seconds);
+                    best.stages[s].second.peak_bytes =
+                        std::min(best.stages[s].second.peak_bytes, current.stages[s].second.peak_bytes);
+                }
+            }
+            best.name = name.str();
+            best.hash = HashCase::name;
+            std::cout << best.name << ": " << best.wall_seconds << " s, peak heap "
+                      << best.peak_bytes / (1024 * 1024) << " MiB, proof " << best.proof_size << " bytes" << std::endl;
+            results().push_back(std::move(best));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
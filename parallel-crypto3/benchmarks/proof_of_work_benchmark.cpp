@@ -0,0 +1,93 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE proof_of_work_benchmark
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/algebra/curves/pallas.hpp>
+#include <nil/crypto3/hash/keccak.hpp>
+#include <nil/crypto3/hash/poseidon.hpp>
+#include <nil/crypto3/hash/sha2.hpp>
+
+#include <nil/crypto3/zk/commitments/detail/polynomial/proof_of_work.hpp>
+#include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
+
+using namespace nil::crypto3;
+
+// Reports single-thread nonces/second of evaluating grinding candidates, then the wall time of a full parallel
+// grinding run.
+template<typename Hash>
+void run_grinding_benchmark(const std::string &name, std::size_t nonces, std::size_t grinding_bits) {
+    using pow_type = zk::commitments::proof_of_work<Hash, std::uint32_t>;
+    using transcript_type = typename pow_type::transcript_type;
+    using clock = std::chrono::high_resolution_clock;
+
+    transcript_type transcript;
+    transcript(pow_type::to_byte_array(0xC0FFEEu));
+
+    std::uint32_t sink = 0;
+    auto start = clock::now();
+    for (std::uint32_t nonce = 0; nonce < nonces; ++nonce) {
+        transcript_type tmp_transcript = transcript;
+        tmp_transcript(pow_type::to_byte_array(nonce));
+        sink += tmp_transcript.template int_challenge<std::uint32_t>();
+    }
+    double candidate_seconds = std::chrono::duration<double>(clock::now() - start).count();
+
+    start = clock::now();
+    transcript_type grinding_transcript = transcript;
+    pow_type::generate(grinding_transcript, grinding_bits);
+    double generate_seconds = std::chrono::duration<double>(clock::now() - start).count();
+
+    std::cout << name << ":\n"
+              << std::fixed << std::setprecision(0)
+              << "  single thread: " << nonces / candidate_seconds << " nonces/s\n"
+              << std::setprecision(3)
+              << "  generate(" << grinding_bits << " bits) on " << ThreadPool::get_instance(ThreadPool::PoolLevel::LOW).get_pool_size()
+              << " threads: " << generate_seconds << " seconds\n"
+              << "  (checksum " << sink << ")\n\n";
+}
+
+BOOST_AUTO_TEST_SUITE(proof_of_work_benchmark_test_suite)
+
+BOOST_AUTO_TEST_CASE(grinding_keccak_benchmark) {
+    run_grinding_benchmark<hashes::keccak_1600<256>>("keccak_1600<256>", 1 << 18, 20);
+}
+
+BOOST_AUTO_TEST_CASE(grinding_sha256_benchmark) {
+    run_grinding_benchmark<hashes::sha2<256>>("sha2<256>", 1 << 18, 20);
+}
+
+BOOST_AUTO_TEST_CASE(grinding_poseidon_benchmark) {
+    using field_type = algebra::curves::pallas::base_field_type;
+    using poseidon_type = hashes::poseidon<hashes::detail::pasta_poseidon_policy<field_type>>;
+    run_grinding_benchmark<poseidon_type>("poseidon<pallas>", 1 << 14, 16);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
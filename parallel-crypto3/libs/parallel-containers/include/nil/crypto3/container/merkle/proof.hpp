@@ -105,6 +105,7 @@ namespace nil {
                                                                                          _path(path){};
 
                     merkle_proof_impl(const merkle_tree<hash_type, arity> &tree, const std::size_t leaf_idx) {
+                        BOOST_ASSERT_MSG(tree.discarded_rows() == 0, "Leaves are needed for a partial merkle tree");
                         _root = tree.root();
                         _path.resize(tree.row_count() - 1);
                         _li = leaf_idx;
@@ -131,6 +132,73 @@ namespace nil {
                         }
                     }
 
+                    // Proof for a tree with discarded bottom rows, leaf_generator(i) returns the data of leaf i.
+                    // The discarded part of the path is rebuilt from the leaves of the subtree under the lowest
+                    // stored node, only arity^discarded_rows leaves are rehashed.
+                    template<typename LeafGenerator>
+                    merkle_proof_impl(const merkle_tree<hash_type, arity> &tree, const std::size_t leaf_idx,
+                                      const LeafGenerator &leaf_generator) {
+                        _root = tree.root();
+                        _path.resize(tree.row_count() - 1);
+                        _li = leaf_idx;
+
+                        const std::size_t discarded_rows = tree.discarded_rows();
+                        std::size_t subtree_leaves = 1;
+                        for (std::size_t row = 0; row < discarded_rows; ++row) {
+                            subtree_leaves *= arity;
+                        }
+                        std::size_t subtree_first = leaf_idx - leaf_idx % subtree_leaves;
+
+                        // Discarded rows of the subtree one after another, from the leaves up.
+                        std::vector<value_type> subtree;
+                        if (discarded_rows > 0) {
+                            subtree.reserve(detail::merkle_tree_length(subtree_leaves, arity));
+                            for (std::size_t i = 0; i < subtree_leaves; ++i) {
+                                subtree.push_back(
+                                    static_cast<value_type>(crypto3::hash<hash_type>(leaf_generator(subtree_first + i))));
+                            }
+                            std::size_t row_begin = 0;
+                            for (std::size_t row = 1, row_size = subtree_leaves; row < discarded_rows; ++row) {
+                                for (std::size_t i = 0; i < row_size; i += arity) {
+                                    subtree.push_back(
+                                        detail::merkle_node_hasher<hash_type, arity>::process(subtree.begin() + row_begin + i));
+                                }
+                                row_begin += row_size;
+                                row_size /= arity;
+                            }
+                        }
+
+                        std::size_t cur_leaf = leaf_idx;
+                        std::size_t row_len = tree.leaves();
+                        std::size_t subtree_row_begin = 0;
+                        std::size_t tree_row_begin = 0;
+                        for (std::size_t row = 0; row + 1 < tree.row_count(); ++row) {
+                            const std::size_t cur_leaf_pos = cur_leaf % arity;
+                            const std::size_t begin_this_arity = cur_leaf - cur_leaf_pos;
+                            typename layer_type::iterator a_itr = _path[row].begin();
+                            for (std::size_t i = 0; i < arity; ++i) {
+                                if (i == cur_leaf_pos) {
+                                    continue;
+                                }
+                                if (row < discarded_rows) {
+                                    *a_itr++ = path_element_type(
+                                        subtree[subtree_row_begin + begin_this_arity + i - subtree_first], i);
+                                } else {
+                                    *a_itr++ = path_element_type(tree[tree_row_begin + begin_this_arity + i], i);
+                                }
+                            }
+                            if (row < discarded_rows) {
+                                subtree_row_begin += subtree_leaves;
+                                subtree_leaves /= arity;
+                                subtree_first /= arity;
+                            } else {
+                                tree_row_begin += row_len;
+                            }
+                            cur_leaf /= arity;
+                            row_len /= arity;
+                        }
+                    }
+
                     template<typename Hashable, typename HashType = typename NodeType::hash_type>
                     bool validate(const Hashable &a) const {
                         using hash_type = typename NodeType::hash_type;
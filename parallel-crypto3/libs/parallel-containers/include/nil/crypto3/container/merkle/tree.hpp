@@ -31,6 +31,8 @@
 #error "You're mixing parallel and non-parallel crypto3 versions"
 #endif
 
+#include <algorithm>
+#include <stdexcept>
 #include <vector>
 #include <cmath>
 
@@ -41,6 +43,8 @@
 
 #include <nil/crypto3/hash/type_traits.hpp>
 #include <nil/crypto3/hash/algorithm/hash.hpp>
+#include <nil/crypto3/hash/sha2.hpp>
+#include <nil/crypto3/hash/detail/sha2/sha2_256_hash_pairs.hpp>
 #include <nil/crypto3/container/merkle/node.hpp>
 
 #include <nil/actor/core/thread_pool.hpp>
@@ -53,22 +57,41 @@ namespace nil {
                 // returns next highest power of two from a given number if it is not
                 // already a power of two.
                 inline size_t next_pow2(size_t n) {
-                    return std::pow(2, std::ceil(std::log(n)));
+                    size_t result = 1;
+                    while (result < n) {
+                        result <<= 1;
+                    }
+                    return result;
                 }
 
                 // find power of 2 of a number which is power of 2
                 inline size_t log2_pow2(size_t n) {
-                    return next_pow2(n);
+                    size_t result = 0;
+                    while ((size_t(1) << result) < n) {
+                        ++result;
+                    }
+                    return result;
+                }
+
+                // Checks that n is base^k for some integer k >= 0.
+                inline bool is_power_of(size_t n, size_t base) {
+                    if (n == 0 || base < 2) {
+                        return n == 1;
+                    }
+                    while (n % base == 0) {
+                        n /= base;
+                    }
+                    return n == 1;
                 }
 
                 // Row_Count calculation given the number of _leaves in the tree and the branches.
                 inline size_t merkle_tree_row_count(size_t leafs, size_t branches) {
-                    // Optimization
-                    if (branches == 2) {
-                        return std::log2(leafs) + 1;
-                    } else {
-                        return round(std::log(leafs) / std::log(branches)) + 1;
+                    size_t row_count = 1;
+                    while (leafs > 1) {
+                        leafs /= branches;
+                        ++row_count;
                     }
+                    return row_count;
                 }
 
                 // Tree length calculation given the number of _leaves in the tree and the branches.
@@ -198,40 +221,60 @@ namespace nil {
                     typedef typename container_type::reverse_iterator reverse_iterator;
                     typedef typename container_type::const_reverse_iterator const_reverse_iterator;
 
-                    merkle_tree_impl() : _size(0), _leaves(0), _rc(0) {};
+                    merkle_tree_impl() : _size(0), _leaves(0), _rc(0), _discarded_rows(0) {};
 
                     ~merkle_tree_impl() = default;
 
                     merkle_tree_impl(size_t n) :
                             _size(detail::merkle_tree_length(n, Arity)), _leaves(n),
-                            _rc(detail::merkle_tree_row_count(n, Arity)) {
-                        BOOST_ASSERT_MSG(pow(Arity, round(std::log(n) / std::log(Arity))) == n,
+                            _rc(detail::merkle_tree_row_count(n, Arity)), _discarded_rows(0) {
+                        BOOST_ASSERT_MSG(detail::is_power_of(n, Arity),
                                          "Wrong leaves number, it must be a power of Arity.");
                     }
 
                     merkle_tree_impl(const merkle_tree_impl &x) :
-                            _hashes(x._hashes), _size(x._size), _leaves(x._leaves), _rc(x._rc) {
+                            _hashes(x._hashes), _size(x._size), _leaves(x._leaves), _rc(x._rc),
+                            _discarded_rows(x._discarded_rows) {
                     }
 
                     merkle_tree_impl(const merkle_tree_impl &x, const allocator_type &a) : _hashes(x.hashes(), a),
                                                                                            _size(x._size),
                                                                                            _leaves(x._leaves),
-                                                                                           _rc(x._rc) {}
+                                                                                           _rc(x._rc),
+                                                                                           _discarded_rows(x._discarded_rows) {}
 
-                    merkle_tree_impl(const std::initializer_list<value_type> &il) : _hashes(il) {
+                    merkle_tree_impl(const std::initializer_list<value_type> &il) : _hashes(il), _discarded_rows(0) {
                         set_leaves(detail::merkle_tree_leaves(std::distance(il.begin(), il.end()), Arity));
                         set_row_count(detail::merkle_tree_row_count(_leaves, Arity));
                         set_complete_size(detail::merkle_tree_length(_leaves, Arity));
                     }
 
                     template<typename Iterator, typename std::enable_if<std::is_same<typename Iterator::value_type, value_type>::value, bool>::type = true>
-                    merkle_tree_impl(Iterator first, Iterator last) : _hashes(first, last) {
+                    merkle_tree_impl(Iterator first, Iterator last) : _hashes(first, last), _discarded_rows(0) {
                         set_leaves(detail::merkle_tree_leaves(std::distance(first, last), Arity));
                         set_row_count(detail::merkle_tree_row_count(_leaves, Arity));
                         set_complete_size(detail::merkle_tree_length(_leaves, Arity));
                     }
 
-                    merkle_tree_impl(const std::initializer_list<value_type> &il, const allocator_type &a) : _hashes(il, a) {
+                    // Tree of the given number of leaves with the bottom rows discarded, [first, last) being the
+                    // stored top rows, see discard_rows. Throws if they are not whole rows of such a tree.
+                    template<typename Iterator, typename std::enable_if<std::is_same<typename Iterator::value_type, value_type>::value, bool>::type = true>
+                    merkle_tree_impl(size_t leaves, Iterator first, Iterator last) :
+                            _hashes(first, last), _size(detail::merkle_tree_length(leaves, Arity)), _leaves(leaves),
+                            _rc(detail::merkle_tree_row_count(leaves, Arity)), _discarded_rows(0) {
+                        if (!detail::is_power_of(leaves, Arity) || _hashes.empty()) {
+                            throw std::invalid_argument("Wrong merkle tree top");
+                        }
+                        while (_discarded_rows + 1 < _rc && _hashes.size() + discarded_size() < _size) {
+                            ++_discarded_rows;
+                        }
+                        if (_hashes.size() + discarded_size() != _size) {
+                            throw std::invalid_argument("Merkle tree top does not consist of whole rows");
+                        }
+                    }
+
+                    merkle_tree_impl(const std::initializer_list<value_type> &il, const allocator_type &a) :
+                            _hashes(il, a), _discarded_rows(0) {
                         set_leaves(detail::merkle_tree_leaves(std::distance(il.begin(), il.end()), Arity));
                         set_row_count(detail::merkle_tree_row_count(_leaves, Arity));
                         set_complete_size(detail::merkle_tree_length(_leaves, Arity));
@@ -240,15 +283,20 @@ namespace nil {
                     merkle_tree_impl(merkle_tree_impl &&x)
                     BOOST_NOEXCEPT(std::is_nothrow_move_constructible<allocator_type>::value):
                             _hashes(x._hashes),
-                            _size(x._size), _leaves(x._leaves), _rc(x._rc) {
+                            _size(x._size), _leaves(x._leaves), _rc(x._rc), _discarded_rows(x._discarded_rows) {
                     }
 
                     merkle_tree_impl(merkle_tree_impl &&x, const allocator_type &a) :
-                            _hashes(x.hashes(), a), _size(x._size), _leaves(x._leaves), _rc(x._rc) {
+                            _hashes(x.hashes(), a), _size(x._size), _leaves(x._leaves), _rc(x._rc),
+                            _discarded_rows(x._discarded_rows) {
                     }
 
                     merkle_tree_impl &operator=(const merkle_tree_impl &x) {
-                        _hashes = x.hashes();
+                        _hashes = x._hashes;
+                        _size = x._size;
+                        _leaves = x._leaves;
+                        _rc = x._rc;
+                        _discarded_rows = x._discarded_rows;
                         return *this;
                     }
 
@@ -257,11 +305,12 @@ namespace nil {
                         _size = x._size;
                         _leaves = x._leaves;
                         _rc = x._rc;
+                        _discarded_rows = x._discarded_rows;
                         return *this;
                     }
 
                     bool operator==(const merkle_tree_impl &rhs) const {
-                        return _hashes == rhs._hashes;
+                        return _discarded_rows == rhs._discarded_rows && _hashes == rhs._hashes;
                     }
 
                     bool operator!=(const merkle_tree_impl &rhs) const {
@@ -430,16 +479,45 @@ namespace nil {
                         std::swap(_leaves, other.leaves());
                         std::swap(_rc, other.row_count());
                         std::swap(_size, other.size());
+                        std::swap(_discarded_rows, other._discarded_rows);
                     }
 
                     value_type root() const BOOST_NOEXCEPT {
-                        BOOST_ASSERT_MSG(_size == _hashes.size(), "MerkleTree not fulfilled");
-                        return _hashes[_size - 1];
+                        BOOST_ASSERT_MSG(_size == _hashes.size() + discarded_size(), "MerkleTree not fulfilled");
+                        return _hashes.back();
                     }
 
                     value_type root() BOOST_NOEXCEPT {
-                        BOOST_ASSERT_MSG(_size == _hashes.size(), "MerkleTree not fulfilled");
-                        return _hashes[_size - 1];
+                        BOOST_ASSERT_MSG(_size == _hashes.size() + discarded_size(), "MerkleTree not fulfilled");
+                        return _hashes.back();
+                    }
+
+                    // Drops the bottom rows, the leaves being the first one, the way merkle_tree_cache_size
+                    // counts them. At least the root row is kept. Proofs for such a tree are built with the leaves
+                    // passed once again, see merkle_proof_impl.
+                    void discard_rows(size_t rows) {
+                        BOOST_ASSERT_MSG(_size == _hashes.size() + discarded_size(), "MerkleTree not fulfilled");
+                        if (_rc < 2) {
+                            return;
+                        }
+                        rows = std::min(rows, _rc - 1);
+                        if (rows <= _discarded_rows) {
+                            return;
+                        }
+                        const size_t erased = rows_length(rows) - discarded_size();
+                        _hashes.erase(_hashes.begin(), _hashes.begin() + erased);
+                        _hashes.shrink_to_fit();
+                        _discarded_rows = rows;
+                    }
+
+                    // Number of bottom rows that are not stored, 0 for a complete tree.
+                    size_t discarded_rows() const {
+                        return _discarded_rows;
+                    }
+
+                    // Number of nodes in the rows that are not stored.
+                    size_t discarded_size() const {
+                        return rows_length(_discarded_rows);
                     }
 
                     size_t row_count() const {
@@ -463,6 +541,15 @@ namespace nil {
                     }
 
                 protected:
+                    // Number of nodes in the bottom rows.
+                    size_t rows_length(size_t rows) const {
+                        size_t len = 0;
+                        for (size_t row = 0, row_size = _leaves; row < rows; ++row, row_size /= Arity) {
+                            len += row_size;
+                        }
+                        return len;
+                    }
+
                     container_type _hashes;
 
                     size_t _size;
@@ -475,6 +562,7 @@ namespace nil {
                     //
                     // Internally, this code considers only the _rc.
                     size_t _rc;
+                    size_t _discarded_rows;
                 };
 
                 template<typename T, typename LeafIterator>
@@ -486,32 +574,181 @@ namespace nil {
                     return accumulators::extract::hash<T>(acc);
                 }
 
+                // Hashes Arity consecutive child nodes into their parent. Arity 2 and 4 are unrolled,
+                // they are the only ones used by FRI and LPC.
+                template<typename HashType, std::size_t Arity>
+                struct merkle_node_hasher {
+                    template<typename NodeIterator>
+                    static typename HashType::digest_type process(NodeIterator first) {
+                        return generate_hash<HashType>(first, first + Arity);
+                    }
+                };
+
+                template<typename HashType>
+                struct merkle_node_hasher<HashType, 2> {
+                    template<typename NodeIterator>
+                    static typename HashType::digest_type process(NodeIterator first) {
+                        accumulator_set<HashType> acc;
+                        crypto3::hash<HashType>(first[0], acc);
+                        crypto3::hash<HashType>(first[1], acc);
+                        return accumulators::extract::hash<HashType>(acc);
+                    }
+                };
+
+                template<typename HashType>
+                struct merkle_node_hasher<HashType, 4> {
+                    template<typename NodeIterator>
+                    static typename HashType::digest_type process(NodeIterator first) {
+                        accumulator_set<HashType> acc;
+                        crypto3::hash<HashType>(first[0], acc);
+                        crypto3::hash<HashType>(first[1], acc);
+                        crypto3::hash<HashType>(first[2], acc);
+                        crypto3::hash<HashType>(first[3], acc);
+                        return accumulators::extract::hash<HashType>(acc);
+                    }
+                };
+
+                // Number of leaves hashed and reduced together before moving on, chosen so that a tile
+                // and all its parents stay in L1/L2 cache for 32-byte digests.
+                constexpr static const std::size_t MERKLE_TILE_LEAVES = 1 << 10;
+
+                // Subtrees smaller than this are not worth a separate thread pool task.
+                constexpr static const std::size_t MERKLE_MIN_SUBTREE_LEAVES = 1 << 8;
+
+                // Returns the offsets of each row inside the level-major node storage.
+                template<std::size_t Arity>
+                std::vector<std::size_t> merkle_tree_row_offsets(std::size_t leaves, std::size_t row_count) {
+                    std::vector<std::size_t> offsets(row_count, 0);
+                    std::size_t row_size = leaves;
+                    for (std::size_t row = 1; row < row_count; ++row, row_size /= Arity) {
+                        offsets[row] = offsets[row - 1] + row_size;
+                    }
+                    return offsets;
+                }
+
+                // Returns the largest number of rows r such that Arity^(r - 1) <= max_leaves and
+                // the subtree still fits into a tree of row_count rows.
+                template<std::size_t Arity>
+                std::size_t merkle_subtree_row_count(std::size_t max_leaves, std::size_t row_count) {
+                    std::size_t rows = 1;
+                    std::size_t leaves = 1;
+                    while (rows < row_count && leaves * Arity <= max_leaves) {
+                        leaves *= Arity;
+                        ++rows;
+                    }
+                    return rows;
+                }
+
+                // Computes nodes [begin, begin + count) of the given row from the previous row.
+                template<typename NodeType, std::size_t Arity>
+                void merkle_hash_row_segment(merkle_tree_impl<NodeType, Arity> &tree,
+                                             const std::vector<std::size_t> &row_offsets,
+                                             std::size_t row, std::size_t begin, std::size_t count) {
+                    typedef typename NodeType::hash_type hash_type;
+
+                    auto children = tree.begin() + row_offsets[row - 1] + begin * Arity;
+                    auto parent = tree.begin() + row_offsets[row] + begin;
+                    if constexpr (std::is_same<hash_type, hashes::sha2<256>>::value && Arity == 2) {
+                        // Parents of a row are independent, compress them several at once.
+                        hashes::detail::sha2_256_hash_pairs(children, count, parent);
+                        return;
+                    }
+                    for (std::size_t i = 0; i < count; ++i, children += Arity) {
+                        *parent++ = merkle_node_hasher<hash_type, Arity>::process(children);
+                    }
+                }
+
+                // Builds rows [0, subtree_rows) of the subtree whose leftmost leaf is leaf_begin. Leaves
+                // are processed in tiles, each tile being reduced as far up as it goes while still in cache.
+                template<typename NodeType, std::size_t Arity, typename LeafIterator>
+                void merkle_build_subtree(merkle_tree_impl<NodeType, Arity> &tree,
+                                          const std::vector<std::size_t> &row_offsets, LeafIterator first,
+                                          std::size_t leaf_begin, std::size_t subtree_rows) {
+                    typedef typename NodeType::hash_type hash_type;
+                    typedef typename NodeType::value_type value_type;
+
+                    const std::size_t tile_rows = merkle_subtree_row_count<Arity>(MERKLE_TILE_LEAVES, subtree_rows);
+                    std::size_t tile_leaves = 1;
+                    for (std::size_t row = 1; row < tile_rows; ++row) {
+                        tile_leaves *= Arity;
+                    }
+                    std::size_t subtree_leaves = tile_leaves;
+                    for (std::size_t row = tile_rows; row < subtree_rows; ++row) {
+                        subtree_leaves *= Arity;
+                    }
+
+                    for (std::size_t tile_begin = leaf_begin; tile_begin < leaf_begin + subtree_leaves;
+                         tile_begin += tile_leaves) {
+                        LeafIterator leaf = std::next(first, tile_begin);
+                        auto node = tree.begin() + tile_begin;
+                        for (std::size_t i = 0; i < tile_leaves; ++i, ++leaf, ++node) {
+                            *node = static_cast<value_type>(crypto3::hash<hash_type>(*leaf));
+                        }
+
+                        std::size_t begin = tile_begin, count = tile_leaves;
+                        for (std::size_t row = 1; row < tile_rows; ++row) {
+                            begin /= Arity;
+                            count /= Arity;
+                            merkle_hash_row_segment(tree, row_offsets, row, begin, count);
+                        }
+                    }
+
+                    std::size_t begin = leaf_begin, count = subtree_leaves;
+                    for (std::size_t row = 1; row < subtree_rows; ++row) {
+                        begin /= Arity;
+                        count /= Arity;
+                        if (row >= tile_rows) {
+                            merkle_hash_row_segment(tree, row_offsets, row, begin, count);
+                        }
+                    }
+                }
+
+                // Builds the tree by splitting it into independent subtrees, one thread pool task each,
+                // so that every task works on its own contiguous leaf range without per-row barriers.
+                // Only the few rows above the subtree roots are built after joining.
                 template<typename T, std::size_t Arity, typename LeafIterator>
                 merkle_tree_impl<T, Arity> make_merkle_tree(LeafIterator first, LeafIterator last) {
-                    typedef T node_type;
-                    typedef typename node_type::hash_type hash_type;
-                    typedef typename node_type::value_type value_type;
-                    typedef typename std::iterator_traits<LeafIterator>::value_type leaf_value_type;
+                    const std::size_t leaves = std::distance(first, last);
 
-                    merkle_tree_impl<T, Arity> ret(std::distance(first, last));
+                    merkle_tree_impl<T, Arity> ret(leaves);
                     ret.resize(ret.complete_size());
 
-                    nil::crypto3::parallel_transform(first, last, ret.begin(), [](const leaf_value_type& leaf) {
-                        return static_cast<value_type>(crypto3::hash<hash_type>(leaf));
-                    });
+                    const std::size_t row_count = ret.row_count();
+                    const std::vector<std::size_t> row_offsets = merkle_tree_row_offsets<Arity>(leaves, row_count);
+
+                    // Aim for a few subtrees per worker to even out the load, but don't go below
+                    // the minimal subtree size.
+                    auto &thread_pool = ThreadPool::get_instance(ThreadPool::PoolLevel::LOW);
+                    const std::size_t target_subtrees = 4 * thread_pool.get_pool_size();
+                    const std::size_t max_subtree_leaves =
+                        std::max(MERKLE_MIN_SUBTREE_LEAVES, leaves / std::max(target_subtrees, std::size_t(1)));
+                    const std::size_t subtree_rows = merkle_subtree_row_count<Arity>(max_subtree_leaves, row_count);
 
-                    std::size_t row_idx = ret.leaves(), row_size = row_idx / Arity;
-                    typename merkle_tree_impl<T, Arity>::iterator it = ret.begin();
+                    std::size_t subtree_leaves = 1;
+                    for (std::size_t row = 1; row < subtree_rows; ++row) {
+                        subtree_leaves *= Arity;
+                    }
+                    const std::size_t subtree_count = leaves / subtree_leaves;
 
-                    std::size_t next_row_start_index = std::distance(first, last);
+                    if (subtree_count == 1) {
+                        merkle_build_subtree(ret, row_offsets, first, 0, subtree_rows);
+                    } else {
+                        std::vector<std::future<void>> futures;
+                        futures.reserve(subtree_count);
+                        for (std::size_t subtree = 0; subtree < subtree_count; ++subtree) {
+                            futures.emplace_back(thread_pool.post<void>(
+                                [&ret, &row_offsets, first, subtree, subtree_leaves, subtree_rows]() {
+                                    merkle_build_subtree(ret, row_offsets, first, subtree * subtree_leaves,
+                                                         subtree_rows);
+                                }));
+                        }
+                        wait_for_all(std::move(futures));
+                    }
 
-                    for (size_t row_number = 1; row_number < ret.row_count(); ++row_number, row_size /= Arity) {
-                        nil::crypto3::parallel_for(0, row_size, [&ret, it, next_row_start_index](std::size_t index) {
-                            ret[next_row_start_index + index] = generate_hash<hash_type>(
-                                it + index * Arity, it + (index + 1) * Arity);
-                        });
-                        next_row_start_index += row_size;
-                        it += row_size * Arity;
+                    std::size_t row_size = subtree_count;
+                    for (std::size_t row = subtree_rows; row < row_count; ++row) {
+                        row_size /= Arity;
+                        merkle_hash_row_segment(ret, row_offsets, row, 0, row_size);
                     }
                     return ret;
                 }
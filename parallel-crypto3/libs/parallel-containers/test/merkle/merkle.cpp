@@ -253,6 +253,55 @@ void testing_hash_template(std::vector<Element> data, std::string result) {
     BOOST_CHECK(result == std::to_string(tree.root()));
 }
 
+template<typename Hash, size_t Arity>
+void testing_parallel_build_template(std::size_t leaf_number) {
+    auto data = generate_random_data<std::uint8_t, 4>(leaf_number);
+    merkle_tree<Hash, Arity> tree = make_merkle_tree<Hash, Arity>(data.begin(), data.end());
+
+    // Reference tree, built row by row.
+    std::vector<typename Hash::digest_type> expected;
+    for (const auto &leaf : data) {
+        expected.emplace_back(nil::crypto3::hash<Hash>(leaf));
+    }
+    for (std::size_t row_begin = 0, row_size = leaf_number; row_size > 1; row_begin += row_size, row_size /= Arity) {
+        for (std::size_t i = 0; i < row_size / Arity; ++i) {
+            expected.emplace_back(containers::detail::generate_hash<Hash>(expected.begin() + row_begin + i * Arity,
+                                                              expected.begin() + row_begin + (i + 1) * Arity));
+        }
+    }
+
+    BOOST_CHECK_EQUAL(tree.size(), expected.size());
+    BOOST_CHECK_EQUAL(tree.row_count(), containers::detail::merkle_tree_row_count(leaf_number, Arity));
+    BOOST_CHECK(std::equal(tree.begin(), tree.end(), expected.begin(), expected.end()));
+}
+
+template<typename Hash, size_t Arity>
+void testing_partial_tree_template(std::size_t leaf_number) {
+    auto data = generate_random_data<std::uint8_t, 4>(leaf_number);
+    merkle_tree<Hash, Arity> tree = make_merkle_tree<Hash, Arity>(data.begin(), data.end());
+    auto leaf_generator = [&data](std::size_t i) { return data[i]; };
+
+    for (std::size_t rows = 1; rows <= tree.row_count(); ++rows) {
+        merkle_tree<Hash, Arity> partial_tree = tree;
+        partial_tree.discard_rows(rows);
+        BOOST_CHECK_EQUAL(partial_tree.discarded_rows(), std::min(rows, tree.row_count() - 1));
+        BOOST_CHECK_EQUAL(partial_tree.size() + partial_tree.discarded_size(), tree.size());
+        BOOST_CHECK(partial_tree.root() == tree.root());
+        BOOST_CHECK(std::equal(partial_tree.begin(), partial_tree.end(), tree.end() - partial_tree.size()));
+        // The same tree restored from its top rows.
+        BOOST_CHECK((merkle_tree<Hash, Arity>(leaf_number, partial_tree.begin(), partial_tree.end()) == partial_tree));
+
+        for (std::size_t leaf_idx = 0; leaf_idx < leaf_number; leaf_idx += 7) {
+            merkle_proof<Hash, Arity> proof(tree, leaf_idx);
+            merkle_proof<Hash, Arity> partial_proof(partial_tree, leaf_idx, leaf_generator);
+            BOOST_CHECK(proof == partial_proof);
+            BOOST_CHECK(partial_proof.validate(data[leaf_idx]));
+        }
+    }
+    // Nodes that are not whole top rows.
+    BOOST_CHECK_THROW((merkle_tree<Hash, Arity>(leaf_number, tree.end() - 2, tree.end())), std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_SUITE(containers_merkltree_test)
 
 using curve_type = algebra::curves::pallas;
@@ -363,4 +412,23 @@ BOOST_AUTO_TEST_CASE(merkletree_hash_test_2) {
     testing_hash_template<hashes::sha2<256>, 3>(v, "6831d4d32538bedaa7a51970ac10474d5884701c840781f0a434e5b6868d4b73");
 }
 
+BOOST_AUTO_TEST_CASE(merkletree_parallel_build_test) {
+    BOOST_CHECK_EQUAL(containers::detail::next_pow2(5), 8);
+    BOOST_CHECK_EQUAL(containers::detail::log2_pow2(16), 4);
+    BOOST_CHECK_EQUAL(containers::detail::merkle_tree_row_count(1 << 20, 4), 11);
+    BOOST_CHECK(containers::detail::is_power_of(729, 3));
+    BOOST_CHECK(!containers::detail::is_power_of(24, 2));
+
+    testing_parallel_build_template<hashes::sha2<256>, 2>(1);
+    testing_parallel_build_template<hashes::sha2<256>, 2>(1 << 14);
+    testing_parallel_build_template<hashes::keccak_1600<256>, 4>(1 << 14);
+    testing_parallel_build_template<hashes::sha2<256>, 3>(19683);
+}
+
+BOOST_AUTO_TEST_CASE(merkletree_partial_tree_test) {
+    testing_partial_tree_template<hashes::sha2<256>, 2>(1 << 10);
+    testing_partial_tree_template<hashes::keccak_1600<256>, 4>(1 << 8);
+    testing_partial_tree_template<hashes::sha2<256>, 3>(243);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -134,6 +134,11 @@ namespace nil {
                     return omega;
                 }
 
+                // Powers omega^{-i} for i in [0, m), the table used by the inverse FFT.
+                const std::vector<field_value_type> &get_inverse_powers() const {
+                    return fft_cache->second;
+                }
+
                 field_value_type get_domain_element(const std::size_t idx) override {
                     return omega.pow(idx);
                 }
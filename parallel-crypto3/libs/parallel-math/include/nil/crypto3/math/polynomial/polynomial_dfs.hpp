@@ -176,6 +176,10 @@ namespace nil {
                     return val;
                 }
 
+                const container_type& get_storage() const {
+                    return val;
+                }
+
                 iterator begin() BOOST_NOEXCEPT {
                     return val.begin();
                 }
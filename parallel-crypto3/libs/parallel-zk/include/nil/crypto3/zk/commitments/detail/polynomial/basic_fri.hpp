@@ -363,6 +363,10 @@ namespace nil {
                     >;
                 }    // namespace detail
 
+                // Bottom rows of the FRI round trees dropped right after the commit. Only lambda leaves are ever
+                // opened, the proof for each one rehashes the 2^FRI_DISCARDED_MERKLE_ROWS leaves under it.
+                constexpr static const std::size_t FRI_DISCARDED_MERKLE_ROWS = 6;
+
                 template<typename FRI,
                     typename std::enable_if<
                         std::is_base_of<
@@ -404,6 +408,56 @@ namespace nil {
                     return (x_index + domain_size / FRI::m) % domain_size;
                 }
 
+                // Passes the values of f on the coset of leaf x_index to element_consumer in the order precommit
+                // hashes them.
+                template<typename FRI, typename ElementConsumer>
+                static void consume_coset(ElementConsumer &element_consumer,
+                                          const math::polynomial_dfs<typename FRI::field_type::value_type> &f,
+                                          const std::size_t coset_size, const std::size_t x_index) {
+                    const std::size_t domain_size = f.size();
+                    std::vector<std::array<std::size_t, FRI::m>> s_indices(coset_size / FRI::m);
+                    s_indices[0][0] = x_index;
+                    s_indices[0][1] = get_paired_index<FRI>(x_index, domain_size);
+
+                    element_consumer.consume(f[s_indices[0][0]]);
+                    element_consumer.consume(f[s_indices[0][1]]);
+
+                    std::size_t base_index = domain_size / (FRI::m * FRI::m);
+                    std::size_t prev_half_size = 1;
+                    std::size_t i = 1;
+                    while (i < coset_size / FRI::m) {
+                        for (std::size_t j = 0; j < prev_half_size; j++) {
+                            s_indices[i][0] = (base_index + s_indices[j][0]) % domain_size;
+                            s_indices[i][1] = get_paired_index<FRI>(s_indices[i][0], domain_size);
+
+                            element_consumer.consume(f[s_indices[i][0]]);
+                            element_consumer.consume(f[s_indices[i][1]]);
+
+                            i++;
+                        }
+                        base_index /= FRI::m;
+                        prev_half_size <<= 1;
+                    }
+                }
+
+                // Writes the values of f on the coset of leaf x_index in the order precommit hashes them.
+                template<typename FRI>
+                static void fill_leaf(detail::fri_field_element_consumer<FRI> &leaf,
+                                      const math::polynomial_dfs<typename FRI::field_type::value_type> &f,
+                                      const std::size_t coset_size, const std::size_t x_index) {
+                    consume_coset<FRI>(leaf.reset_cursor(), f, coset_size, x_index);
+                }
+
+                // Same for the leaf of a batch of codewords, the cosets of all of them one after another.
+                template<typename FRI, typename ContainerType>
+                static void fill_batch_leaf(detail::fri_field_element_consumer<FRI> &leaf, const ContainerType &fs,
+                                            const std::size_t coset_size, const std::size_t x_index) {
+                    auto& element_consumer = leaf.reset_cursor();
+                    for (const auto &f : fs) {
+                        consume_coset<FRI>(element_consumer, f, coset_size, x_index);
+                    }
+                }
+
                 template<typename FRI,
                     typename std::enable_if<
                         std::is_base_of<
@@ -432,30 +486,7 @@ namespace nil {
                     );
 
                     for (std::size_t x_index = 0; x_index < leafs_number; x_index++) {
-                        std::vector<std::array<std::size_t, FRI::m>> s_indices(coset_size / FRI::m);
-                        s_indices[0][0] = x_index;
-                        s_indices[0][1] = get_paired_index<FRI>(x_index, domain_size);
-
-                        auto& element_consumer = y_data[x_index].reset_cursor();
-                        element_consumer.consume(f[s_indices[0][0]]);
-                        element_consumer.consume(f[s_indices[0][1]]);
-
-                        std::size_t base_index = domain_size / (FRI::m * FRI::m);
-                        std::size_t prev_half_size = 1;
-                        std::size_t i = 1;
-                        while (i < coset_size / FRI::m) {
-                            for (std::size_t j = 0; j < prev_half_size; j++) {
-                                s_indices[i][0] = (base_index + s_indices[j][0]) % domain_size;
-                                s_indices[i][1] = get_paired_index<FRI>(s_indices[i][0], domain_size);
-
-                                element_consumer.consume(f[s_indices[i][0]]);
-                                element_consumer.consume(f[s_indices[i][1]]);
-
-                                i++;
-                            }
-                            base_index /= FRI::m;
-                            prev_half_size <<= 1;
-                        }
+                        fill_leaf<FRI>(y_data[x_index], f, coset_size, x_index);
                     }
 
                     return containers::make_merkle_tree<typename FRI::merkle_tree_hash_type, FRI::m>(y_data.begin(),
@@ -522,32 +553,8 @@ namespace nil {
                         detail::fri_field_element_consumer<FRI>(coset_size * list_size)
                     );
 
-                    parallel_for(0, leafs_number, [&y_data, &poly, domain_size, coset_size, list_size](std::size_t x_index) {
-                        auto& element_consumer = y_data[x_index].reset_cursor();
-                        for (std::size_t polynom_index = 0; polynom_index < list_size; polynom_index++) {
-                            std::vector<std::array<std::size_t, FRI::m>> s_indices(coset_size / FRI::m);
-                            s_indices[0][0] = x_index;
-                            s_indices[0][1] = get_paired_index<FRI>(x_index, domain_size);
-
-                            element_consumer.consume(poly[polynom_index][s_indices[0][0]]);
-                            element_consumer.consume(poly[polynom_index][s_indices[0][1]]);
-
-                            std::size_t base_index = domain_size / (FRI::m * FRI::m);
-                            std::size_t prev_half_size = 1;
-                            std::size_t i = 1;
-                            while (i < coset_size / FRI::m) {
-                                for (std::size_t j = 0; j < prev_half_size; j++) {
-                                    s_indices[i][0] = (base_index + s_indices[j][0]) % domain_size;
-                                    s_indices[i][1] = get_paired_index<FRI>(s_indices[i][0], domain_size);
-                                    element_consumer.consume(poly[polynom_index][s_indices[i][0]]);
-                                    element_consumer.consume(poly[polynom_index][s_indices[i][1]]);
-
-                                    i++;
-                                }
-                                base_index /= FRI::m;
-                                prev_half_size <<= 1;
-                            }
-                        }
+                    parallel_for(0, leafs_number, [&y_data, &poly, coset_size](std::size_t x_index) {
+                        fill_batch_leaf<FRI>(y_data[x_index], poly, coset_size, x_index);
                     });
 
                     return containers::make_merkle_tree<typename FRI::merkle_tree_hash_type, FRI::m>(y_data.begin(),
@@ -590,6 +597,45 @@ namespace nil {
                     return typename FRI::merkle_proof_type(tree, min_x_index);
                 }
 
+                // Same for a tree with discarded bottom rows, the leaves are taken again from the codeword f the
+                // tree was built from.
+                template<typename FRI>
+                static inline typename FRI::merkle_proof_type
+                make_proof_specialized(const std::size_t x_index, const std::size_t domain_size,
+                                       const typename FRI::merkle_tree_type &tree,
+                                       const math::polynomial_dfs<typename FRI::field_type::value_type> &f,
+                                       const std::size_t fri_step) {
+                    if (tree.discarded_rows() == 0) {
+                        return make_proof_specialized<FRI>(x_index, domain_size, tree);
+                    }
+                    const std::size_t coset_size = 1 << fri_step;
+                    std::size_t min_x_index = std::min(x_index, get_paired_index<FRI>(x_index, domain_size));
+                    return typename FRI::merkle_proof_type(tree, min_x_index, [&f, coset_size](std::size_t leaf_index) {
+                        detail::fri_field_element_consumer<FRI> leaf(coset_size);
+                        fill_leaf<FRI>(leaf, f, coset_size, leaf_index);
+                        return leaf;
+                    });
+                }
+
+                // Same for a tree built from a batch of codewords fs.
+                template<typename FRI>
+                static inline typename FRI::merkle_proof_type
+                make_proof_specialized(const std::size_t x_index, const std::size_t domain_size,
+                                       const typename FRI::merkle_tree_type &tree,
+                                       const std::vector<math::polynomial_dfs<typename FRI::field_type::value_type>> &fs,
+                                       const std::size_t fri_step) {
+                    if (tree.discarded_rows() == 0) {
+                        return make_proof_specialized<FRI>(x_index, domain_size, tree);
+                    }
+                    const std::size_t coset_size = 1 << fri_step;
+                    std::size_t min_x_index = std::min(x_index, get_paired_index<FRI>(x_index, domain_size));
+                    return typename FRI::merkle_proof_type(tree, min_x_index, [&fs, coset_size](std::size_t leaf_index) {
+                        detail::fri_field_element_consumer<FRI> leaf(coset_size * fs.size());
+                        fill_batch_leaf<FRI>(leaf, fs, coset_size, leaf_index);
+                        return leaf;
+                    });
+                }
+
                 template<typename FRI>
                 static inline std::size_t get_folded_index(std::size_t x_index, std::size_t domain_size,
                                                            const std::size_t fri_step) {
@@ -734,49 +780,76 @@ namespace nil {
                     typename FRI::transcript_type &transcript)
                 {
                     PROFILE_SCOPE("Basic FRI commit phase");
+                    constexpr bool is_dfs = std::is_same<
+                        math::polynomial_dfs<typename FRI::field_type::value_type>, PolynomialType>::value;
+
+                    // Query phase reads the codewords of rounds 1 .. step_list.size() - 1 only, the entries of
+                    // combined_Q and of the final polynomial are left empty to keep round indices.
                     std::vector<PolynomialType> fs;
                     std::vector<typename FRI::precommitment_type> fri_trees;
                     typename FRI::commitments_part_of_proof commitments_proof;
 
-                    auto f = combined_Q;
+                    // Folding buffer reused by all rounds. Codewords are folded in place, round 0 folds
+                    // combined_Q directly into it.
+                    PolynomialType f;
                     auto precommitment = combined_Q_precommitment;
                     std::size_t t = 0;
 
                     for (std::size_t i = 0; i < fri_params.step_list.size(); i++) {
-                        fs.push_back(f);
+                        fs.push_back(i == 0 ? PolynomialType() : f);
                         fri_trees.push_back(precommitment);
                         commitments_proof.fri_roots.push_back(commit<FRI>(precommitment));
                         transcript(commit<FRI>(precommitment));
-                        for (std::size_t step_i = 0; step_i < fri_params.step_list[i]; ++step_i, ++t) {
-                            typename FRI::field_type::value_type alpha = transcript.template challenge<typename FRI::field_type>();
-                            // Calculate next f
-                            if constexpr (std::is_same<math::polynomial_dfs<typename FRI::field_type::value_type>,
-                                    PolynomialType>::value) {
-                                f = commitments::detail::fold_polynomial<typename FRI::field_type>(f, alpha,
-                                                                                                   fri_params.D[t]);
-                            } else {
+
+                        // All challenges of the round are squeezed one after another, nothing is absorbed
+                        // in between.
+                        std::vector<typename FRI::field_type::value_type> alphas(fri_params.step_list[i]);
+                        for (auto &alpha : alphas) {
+                            alpha = transcript.template challenge<typename FRI::field_type>();
+                        }
+
+                        // Calculate next f
+                        if constexpr (is_dfs) {
+                            // All steps of the round in one pass over the codeword.
+                            const PolynomialType &round_input = i == 0 ? combined_Q : f;
+                            auto &storage = f.get_storage();
+                            commitments::detail::fold_polynomial_steps<typename FRI::field_type>(
+                                round_input.get_storage(), storage, alphas, fri_params.D[t]);
+                            PolynomialType folded(storage.size() - 1, 0);
+                            folded.get_storage().swap(storage);
+                            f.swap(folded);
+                        } else {
+                            if (i == 0) {
+                                f = combined_Q;
+                            }
+                            for (const auto &alpha : alphas) {
                                 f = commitments::detail::fold_polynomial<typename FRI::field_type>(f, alpha);
                             }
                         }
+                        t += fri_params.step_list[i];
+
                         if (i != fri_params.step_list.size() - 1) {
                             const auto& D = fri_params.D[t];
-                            if constexpr (std::is_same<math::polynomial_dfs<typename FRI::field_type::value_type>,
-                                    PolynomialType>::value) {
+                            if constexpr (is_dfs) {
                                 if (f.size() != D->size()) {
                                     f.resize(D->size(), nullptr, D);
                                 }
                             }
                             precommitment = precommit<FRI>(f, D, fri_params.step_list[i + 1]);
+                            if constexpr (is_dfs) {
+                                // The codeword stays in fs until the query phase, the bottom of the tree can be
+                                // rebuilt from it for the queried leaves only.
+                                precommitment.discard_rows(FRI_DISCARDED_MERKLE_ROWS);
+                            }
                         }
                     }
-                    fs.push_back(f);
-                    if constexpr (std::is_same<math::polynomial_dfs<typename FRI::field_type::value_type>, PolynomialType>::value) {
+                    if constexpr (is_dfs) {
                         commitments_proof.final_polynomial = math::polynomial<typename FRI::field_type::value_type>(f.coefficients());
                     } else {
                         commitments_proof.final_polynomial = f;
                     }
 
-                    return std::make_tuple(fs, fri_trees, commitments_proof);
+                    return std::make_tuple(std::move(fs), std::move(fri_trees), std::move(commitments_proof));
                 }
 
                 /** @brief Convert a set of polynomials from DFS form into coefficients form, parallel version */
@@ -913,10 +986,13 @@ namespace nil {
                             }
                         }
 
-                        // Fill merkle proofs
-                        initial_proof[k].p = make_proof_specialized<FRI>(
-                                get_folded_index<FRI>(x_index, fri_params.D[0]->size(), fri_params.step_list[0]),
-                                fri_params.D[0]->size(), precommitments.at(k) );
+                        // Fill merkle proofs, the ones for trees with discarded rows are left to
+                        // query_phase_initial_proofs.
+                        if (precommitments.at(k).discarded_rows() == 0) {
+                            initial_proof[k].p = make_proof_specialized<FRI>(
+                                    get_folded_index<FRI>(x_index, fri_params.D[0]->size(), fri_params.step_list[0]),
+                                    fri_params.D[0]->size(), precommitments.at(k) );
+                        }
                     }
 
                     return std::move(initial_proof);
@@ -940,9 +1016,16 @@ namespace nil {
                         domain_size = fri_params.D[t]->size();
                         x_index %= domain_size;
 
-                        round_proofs[i].p = make_proof_specialized<FRI>(
-                                get_folded_index<FRI>(x_index, domain_size, fri_params.step_list[i]),
-                                domain_size, fri_trees[i]);
+                        if constexpr (std::is_same<math::polynomial_dfs<typename FRI::field_type::value_type>,
+                                PolynomialType>::value) {
+                            round_proofs[i].p = make_proof_specialized<FRI>(
+                                    get_folded_index<FRI>(x_index, domain_size, fri_params.step_list[i]),
+                                    domain_size, fri_trees[i], fs[i], fri_params.step_list[i]);
+                        } else {
+                            round_proofs[i].p = make_proof_specialized<FRI>(
+                                    get_folded_index<FRI>(x_index, domain_size, fri_params.step_list[i]),
+                                    domain_size, fri_trees[i]);
+                        }
 
                         t += fri_params.step_list[i];
                         if (i < fri_params.step_list.size() - 1) {
@@ -1043,8 +1126,9 @@ namespace nil {
                     std::map<std::size_t, std::vector<math::polynomial<typename FRI::field_type::value_type>>> g_coeffs =
                         convert_polynomials_to_coefficients<FRI, PolynomialType>(fri_params, g);
 
+                    std::vector<std::uint64_t> x_indices(fri_params.lambda);
                     parallel_for(0, fri_params.lambda,
-                        [&proof, &fri_params, &precommitments, &g_coeffs, &g, &challenges](std::size_t query_id) {
+                        [&proof, &fri_params, &precommitments, &g_coeffs, &g, &challenges, &x_indices](std::size_t query_id) {
 
                         std::size_t domain_size = fri_params.D[0]->size();
                         typename FRI::field_type::value_type x = challenges[query_id];
@@ -1055,6 +1139,7 @@ namespace nil {
                         while (fri_params.D[0]->get_domain_element(x_index) != x) {
                             ++x_index;
                         }
+                        x_indices[query_id] = x_index;
 
                         std::map<std::size_t, typename FRI::initial_proof_type>
                             initial_proof = build_initial_proof<FRI, PolynomialType>(
@@ -1063,6 +1148,58 @@ namespace nil {
                         proof.initial_proofs[query_id] = std::move(initial_proof);
                     }, ThreadPool::PoolLevel::HIGH);
 
+                    // Trees with discarded rows, e.g. loaded from a compact commitment state, keep only their top rows.
+                    // The codewords of such a batch are computed once and only the paths to the queried leaves are
+                    // rebuilt from them, one batch at a time.
+                    const std::size_t domain_size = fri_params.D[0]->size();
+                    const std::size_t fri_step = fri_params.step_list[0];
+                    for (const auto &entry : precommitments) {
+                        const std::size_t k = entry.first;
+                        const typename FRI::precommitment_type &tree = entry.second;
+                        if (tree.discarded_rows() == 0 || g.find(k) == g.end()) {
+                            continue;
+                        }
+                        std::vector<math::polynomial_dfs<typename FRI::field_type::value_type>> fs(g.at(k).size());
+                        parallel_for(0, fs.size(), [&fs, &g, &fri_params, k](std::size_t i) {
+                            if constexpr (std::is_same<
+                                    math::polynomial_dfs<typename FRI::field_type::value_type>,
+                                    PolynomialType>::value) {
+                                fs[i] = g.at(k)[i];
+                            } else {
+                                fs[i].from_coefficients(g.at(k)[i]);
+                            }
+                            if (fs[i].size() != fri_params.D[0]->size()) {
+                                fs[i].resize(fri_params.D[0]->size(), nullptr, fri_params.D[0]);
+                            }
+                        }, ThreadPool::PoolLevel::HIGH);
+
+                        std::size_t subtree_leaves = 1;
+                        for (std::size_t row = 0; row < tree.discarded_rows(); ++row) {
+                            subtree_leaves *= FRI::m;
+                        }
+                        if (fri_params.lambda * subtree_leaves >= tree.leaves()) {
+                            // The paths would rehash the whole tree several times, rebuild it once instead.
+                            const typename FRI::precommitment_type full_tree =
+                                precommit<FRI>(std::move(fs), fri_params.D[0], fri_step);
+                            if (full_tree.root() != tree.root()) {
+                                throw std::runtime_error("Rebuilt merkle tree does not match its stored top rows");
+                            }
+                            parallel_for(0, fri_params.lambda, [&proof, &full_tree, &x_indices, domain_size, fri_step, k]
+                                    (std::size_t query_id) {
+                                proof.initial_proofs[query_id][k].p = make_proof_specialized<FRI>(
+                                    get_folded_index<FRI>(x_indices[query_id], domain_size, fri_step),
+                                    domain_size, full_tree);
+                            }, ThreadPool::PoolLevel::HIGH);
+                            continue;
+                        }
+                        parallel_for(0, fri_params.lambda, [&proof, &tree, &fs, &x_indices, domain_size, fri_step, k]
+                                (std::size_t query_id) {
+                            proof.initial_proofs[query_id][k].p = make_proof_specialized<FRI>(
+                                get_folded_index<FRI>(x_indices[query_id], domain_size, fri_step),
+                                domain_size, tree, fs, fri_step);
+                        }, ThreadPool::PoolLevel::HIGH);
+                    }
+
                     return proof;
                 }
 
@@ -0,0 +1,85 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef PARALLEL_CRYPTO3_ZK_BATCH_NORMALIZE_HPP
+#define PARALLEL_CRYPTO3_ZK_BATCH_NORMALIZE_HPP
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <nil/crypto3/algebra/multiexp/batch_normalize.hpp>
+
+#include <nil/actor/core/thread_pool.hpp>
+#include <nil/actor/core/parallelization_utils.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace commitments {
+                namespace detail {
+
+                    // Same as algebra::batch_normalize, every worker runs Montgomery's trick over its own
+                    // chunk, so there is one inversion per chunk instead of one per point.
+                    template<typename InputRange>
+                    void parallel_batch_normalize(InputRange &points) {
+                        using curve_element_type = typename InputRange::value_type;
+
+                        if constexpr (!std::is_same_v<typename curve_element_type::coordinates,
+                                                      algebra::curves::coordinates::affine>) {
+                            wait_for_all(parallel_run_in_chunks<void>(
+                                points.size(),
+                                [&points](std::size_t begin, std::size_t end) {
+                                    algebra::detail::batch_normalize_range(points.begin() + begin,
+                                                                           points.begin() + end);
+                                },
+                                ThreadPool::PoolLevel::LOW));
+                        }
+                    }
+
+                    // Same as algebra::batch_to_affine.
+                    template<typename InputRange>
+                    auto parallel_batch_to_affine(const InputRange &points) {
+                        using curve_element_type = typename InputRange::value_type;
+                        using affine_value_type = decltype(std::declval<const curve_element_type &>().to_affine());
+
+                        std::vector<affine_value_type> result(points.size());
+                        wait_for_all(parallel_run_in_chunks<void>(
+                            points.size(),
+                            [&points, &result](std::size_t begin, std::size_t end) {
+                                std::vector<curve_element_type> normalized(points.begin() + begin,
+                                                                           points.begin() + end);
+                                algebra::batch_normalize(normalized);
+                                for (std::size_t i = begin; i < end; ++i) {
+                                    result[i] = normalized[i - begin].to_affine();
+                                }
+                            },
+                            ThreadPool::PoolLevel::LOW));
+                        return result;
+                    }
+                }    // namespace detail
+            }        // namespace commitments
+        }            // namespace zk
+    }                // namespace crypto3
+}    // namespace nil
+
+#endif    // PARALLEL_CRYPTO3_ZK_BATCH_NORMALIZE_HPP
@@ -0,0 +1,85 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef PARALLEL_CRYPTO3_ZK_FIXED_BASE_BATCH_EXP_HPP
+#define PARALLEL_CRYPTO3_ZK_FIXED_BASE_BATCH_EXP_HPP
+
+#include <vector>
+
+#include <nil/crypto3/algebra/multiexp/batch_normalize.hpp>
+#include <nil/crypto3/algebra/multiexp/fixed_base.hpp>
+
+#include <nil/actor/core/thread_pool.hpp>
+#include <nil/actor/core/parallelization_utils.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace commitments {
+                namespace detail {
+
+                    // Same as algebra::fixed_base_batch_exp, every worker multiplies its own chunk of scalars
+                    // and normalizes it with one inversion per chunk.
+                    template<typename GroupType, typename InputRange>
+                    std::vector<typename GroupType::value_type> parallel_fixed_base_batch_exp(
+                            const algebra::fixed_base_table<GroupType> &table, const InputRange &scalars) {
+                        std::vector<typename GroupType::value_type> result(std::size(scalars));
+
+                        wait_for_all(parallel_run_in_chunks<void>(
+                            result.size(),
+                            [&table, &scalars, &result](std::size_t begin, std::size_t end) {
+                                for (std::size_t i = begin; i < end; ++i) {
+                                    result[i] = table(scalars[i]);
+                                }
+                                algebra::detail::batch_normalize_range(result.begin() + begin, result.begin() + end);
+                            },
+                            ThreadPool::PoolLevel::LOW));
+
+                        return result;
+                    }
+
+                    // base * alpha^i for i in [0, n), e.g. the commitment key of a structured reference string.
+                    template<typename GroupType>
+                    std::vector<typename GroupType::value_type> parallel_fixed_base_powers(
+                            const typename GroupType::value_type &base,
+                            const typename GroupType::curve_type::scalar_field_type::value_type &alpha,
+                            std::size_t n) {
+                        using scalar_field_type = typename GroupType::curve_type::scalar_field_type;
+
+                        std::vector<typename scalar_field_type::value_type> powers(n);
+                        typename scalar_field_type::value_type power = scalar_field_type::value_type::one();
+                        for (std::size_t i = 0; i < n; ++i) {
+                            powers[i] = power;
+                            power *= alpha;
+                        }
+
+                        algebra::fixed_base_table<GroupType> table(
+                            base, algebra::get_fixed_base_window_size(scalar_field_type::modulus_bits, n));
+                        return parallel_fixed_base_batch_exp(table, powers);
+                    }
+                }    // namespace detail
+            }        // namespace commitments
+        }            // namespace zk
+    }                // namespace crypto3
+}    // namespace nil
+
+#endif    // PARALLEL_CRYPTO3_ZK_FIXED_BASE_BATCH_EXP_HPP
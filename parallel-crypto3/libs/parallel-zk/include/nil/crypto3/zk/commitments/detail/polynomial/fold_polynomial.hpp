@@ -37,6 +37,7 @@
 #include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
 #include <nil/crypto3/math/polynomial/lagrange_interpolation.hpp>
 #include <nil/crypto3/math/domains/evaluation_domain.hpp>
+#include <nil/crypto3/math/domains/basic_radix2_domain.hpp>
 #include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
 
 #include <nil/crypto3/container/merkle/tree.hpp>
@@ -44,6 +45,9 @@
 
 #include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
 
+#include <nil/actor/core/thread_pool.hpp>
+#include <nil/actor/core/parallelization_utils.hpp>
+
 namespace nil {
     namespace crypto3 {
         namespace zk {
@@ -69,6 +73,82 @@ namespace nil {
                         return f_folded;
                     }
 
+                    /**
+                     * Folds the codeword f over domain 2^alphas.size() times in a single pass, one FRI folding
+                     * step per challenge, and writes the result of size domain->size() / 2^alphas.size() into
+                     * f_folded. f and f_folded may be the same vector, then the codeword is folded in place.
+                     *
+                     * Every output element depends only on the 2^alphas.size() inputs congruent to it modulo the
+                     * output size, so the groups are folded independently through all steps. Inverse twiddles
+                     * of every step are read from the inverse powers table of the domain, and the 1/2 factors of
+                     * all steps are applied once at the end.
+                     */
+                    template<typename FieldType>
+                    void fold_polynomial_steps(
+                            const std::vector<typename FieldType::value_type> &f,
+                            std::vector<typename FieldType::value_type> &f_folded,
+                            const std::vector<typename FieldType::value_type> &alphas,
+                            std::shared_ptr<math::evaluation_domain<FieldType>> domain) {
+                        using value_type = typename FieldType::value_type;
+
+                        const std::size_t steps = alphas.size();
+                        const std::size_t group_size = std::size_t(1) << steps;
+                        const std::size_t n = domain->size();
+                        const std::size_t folded_size = n / group_size;
+                        BOOST_ASSERT(f.size() == n);
+                        BOOST_ASSERT(folded_size * group_size == n);
+
+                        // omega^{-i} for i < n / 2, the largest index any step needs.
+                        std::vector<value_type> local_inverse_powers;
+                        const std::vector<value_type> *inverse_powers = nullptr;
+                        if (auto radix2_domain = std::dynamic_pointer_cast<math::basic_radix2_domain<FieldType>>(domain)) {
+                            inverse_powers = &radix2_domain->get_inverse_powers();
+                        } else {
+                            math::detail::create_fft_cache<FieldType>(
+                                n / 2, domain->get_domain_element(n - 1), local_inverse_powers);
+                            inverse_powers = &local_inverse_powers;
+                        }
+
+                        value_type scale = value_type::one();
+                        const value_type two_inversed = value_type(2u).inversed();
+                        for (std::size_t step = 0; step < steps; ++step) {
+                            scale *= two_inversed;
+                        }
+
+                        const bool in_place = &f == &f_folded;
+                        if (!in_place) {
+                            f_folded.resize(folded_size);
+                        }
+
+                        wait_for_all(parallel_run_in_chunks<void>(
+                            folded_size,
+                            [&f, &f_folded, &alphas, inverse_powers, &scale, steps, group_size, folded_size]
+                            (std::size_t begin, std::size_t end) {
+                                std::vector<value_type> group(group_size);
+                                for (std::size_t i = begin; i < end; ++i) {
+                                    for (std::size_t j = 0; j < group_size; ++j) {
+                                        group[j] = f[i + j * folded_size];
+                                    }
+                                    for (std::size_t step = 0; step < steps; ++step) {
+                                        const std::size_t half = group_size >> (step + 1);
+                                        for (std::size_t j = 0; j < half; ++j) {
+                                            // Position i + j * folded_size in the codeword of this step, whose
+                                            // generator is omega^{2^step}.
+                                            const value_type &twiddle = (*inverse_powers)[(i + j * folded_size) << step];
+                                            const value_type sum = group[j] + group[j + half];
+                                            const value_type diff = group[j] - group[j + half];
+                                            group[j] = sum + alphas[step] * twiddle * diff;
+                                        }
+                                    }
+                                    f_folded[i] = group[0] * scale;
+                                }
+                            }, ThreadPool::PoolLevel::LOW));
+
+                        if (in_place) {
+                            f_folded.resize(folded_size);
+                        }
+                    }
+
                     template<typename FieldType>
                     math::polynomial_dfs<typename FieldType::value_type>
                     fold_polynomial(math::polynomial_dfs<typename FieldType::value_type> &f,
@@ -80,20 +160,9 @@ namespace nil {
                         //  + (one - alpha / (offset * (omega^i)) ) * codeword[len(codeword)//2 + i] ) for i in
                         //  range(len(codeword)//2)]
                         math::polynomial_dfs<typename FieldType::value_type> f_folded(
-                                domain->size() / 2 - 1, domain->size() / 2, FieldType::value_type::zero());
+                                domain->size() / 2 - 1, 0);
 
-                        constexpr typename FieldType::value_type two_inversed =
-                            typename FieldType::value_type(2u).inversed();
-                        typename FieldType::value_type omega_inversed = domain->get_domain_element(domain->size() - 1);
-
-                        typename FieldType::value_type acc = alpha;
-
-                        for (std::size_t i = 0; i <= f_folded.degree(); i++) {
-                            f_folded[i] = two_inversed * (
-                                    (typename FieldType::value_type(1u) + acc) * f[i] +
-                                    (typename FieldType::value_type(1u) - acc) * f[domain->size() / 2 + i]);
-                            acc *= omega_inversed;
-                        }
+                        fold_polynomial_steps<FieldType>(f.get_storage(), f_folded.get_storage(), {alpha}, domain);
 
                         return f_folded;
                     }
@@ -0,0 +1,89 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef PARALLEL_CRYPTO3_ZK_GRINDING_HPP
+#define PARALLEL_CRYPTO3_ZK_GRINDING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <vector>
+
+#include <nil/actor/core/thread_pool.hpp>
+#include <nil/actor/core/parallelization_utils.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace commitments {
+                namespace detail {
+
+                    // Number of consecutive candidates a worker takes at once. Small enough that
+                    // all workers stop shortly after a solution is found, large enough to keep
+                    // the shared counter off the hot path.
+                    constexpr static const std::size_t GRINDING_BATCH_SIZE = 1 << 10;
+
+                    // Searches offsets 0, 1, 2, ... for one satisfying is_solution, on all workers of the
+                    // LOW pool. Workers take batches from a shared counter instead of fixed blocks, so
+                    // there is no barrier between blocks and every worker stops as soon as any of them
+                    // succeeds. Returns the offset found first.
+                    template<typename Predicate>
+                    std::size_t parallel_grinding_search(const Predicate &is_solution) {
+                        auto &thread_pool = ThreadPool::get_instance(ThreadPool::PoolLevel::LOW);
+
+                        std::atomic<bool> challenge_found = false;
+                        std::atomic<std::size_t> next_batch = 0;
+                        std::size_t pow_value_offset = 0;
+
+                        std::vector<std::future<void>> futures;
+                        for (std::size_t worker = 0; worker < thread_pool.get_pool_size(); ++worker) {
+                            futures.emplace_back(thread_pool.post<void>(
+                                [&is_solution, &challenge_found, &next_batch, &pow_value_offset]() {
+                                    while (!challenge_found.load(std::memory_order_relaxed)) {
+                                        std::size_t batch_start =
+                                            next_batch.fetch_add(GRINDING_BATCH_SIZE, std::memory_order_relaxed);
+                                        for (std::size_t i = batch_start; i < batch_start + GRINDING_BATCH_SIZE; ++i) {
+                                            if (challenge_found.load(std::memory_order_relaxed)) {
+                                                break;
+                                            }
+                                            if (is_solution(i)) {
+                                                bool expected = false;
+                                                if (challenge_found.compare_exchange_strong(expected, true)) {
+                                                    pow_value_offset = i;
+                                                }
+                                                break;
+                                            }
+                                        }
+                                    }
+                                }));
+                        }
+                        wait_for_all(std::move(futures));
+
+                        return pow_value_offset;
+                    }
+                }    // namespace detail
+            }        // namespace commitments
+        }            // namespace zk
+    }                // namespace crypto3
+}    // namespace nil
+
+#endif    // PARALLEL_CRYPTO3_ZK_GRINDING_HPP
@@ -37,6 +37,7 @@
 #include <nil/crypto3/random/algebraic_engine.hpp>
 #include <nil/crypto3/marshalling/algebra/types/field_element.hpp>
 #include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
+#include <nil/crypto3/zk/commitments/detail/polynomial/grinding.hpp>
 
 #include <nil/actor/core/thread_pool.hpp>
 #include <nil/actor/core/parallelization_utils.hpp>
@@ -67,40 +68,13 @@ namespace nil {
                         output_type mask = grinding_bits > 0 ? ( 1ULL << grinding_bits ) - 1 : 0;
                         output_type pow_seed = std::rand();
 
-                        /* Enough work for ~ two minutes on 48 cores, keccak<512> */
-                        std::size_t per_block = 1 << 30;
-
-                        std::atomic<bool> challenge_found = false;
-                        std::atomic<std::size_t> pow_value_offset;
-
-                        while( true ) {
-                            wait_for_all(parallel_run_in_chunks<void>(
-                                per_block,
-                                [&transcript, &pow_seed, &challenge_found, &pow_value_offset, &mask](std::size_t pow_start, std::size_t pow_finish) {
-                                    std::size_t i = pow_start;
-                                    while ( i < pow_finish ) {
-                                        if (challenge_found) {
-                                            break;
-                                        }
-                                        transcript_type tmp_transcript = transcript;
-                                        tmp_transcript(to_byte_array(pow_seed + i));
-                                        OutType pow_result = tmp_transcript.template int_challenge<OutType>();
-                                        if ( ((pow_result & mask) == 0) && !challenge_found ) {
-                                            bool expected = false;
-                                            if (challenge_found.compare_exchange_strong(expected, true)) {
-                                                pow_value_offset = i;
-                                            }
-                                            break;
-                                        }
-                                        ++i;
-                                    }
-                                }, ThreadPool::PoolLevel::LOW));
-
-                            if (challenge_found) {
-                                break;
-                            }
-                            pow_seed += per_block;
-                        }
+                        std::size_t pow_value_offset = detail::parallel_grinding_search(
+                            [&transcript, &pow_seed, &mask](std::size_t i) {
+                                transcript_type tmp_transcript = transcript;
+                                tmp_transcript(to_byte_array(pow_seed + i));
+                                OutType pow_result = tmp_transcript.template int_challenge<OutType>();
+                                return (pow_result & mask) == 0;
+                            });
 
                         transcript(to_byte_array(pow_seed + (std::size_t)pow_value_offset));
                         transcript.template int_challenge<OutType>();
@@ -138,40 +112,13 @@ namespace nil {
                                 ((integral_type(1) << GrindingBits) - 1) << (FieldType::modulus_bits - GrindingBits)
                                 : 0);
 
-                        /* Enough work for ~ two minutes on 48 cores, poseidon<pallas> */
-                        std::size_t per_block = 1 << 23;
-
-                        std::atomic<bool> challenge_found = false;
-                        std::atomic<std::size_t> pow_value_offset;
-
-                        while( true ) {
-                            wait_for_all(parallel_run_in_chunks<void>(
-                                per_block,
-                                [&transcript, &pow_seed, &challenge_found, &pow_value_offset, &mask](std::size_t pow_start, std::size_t pow_finish) {
-                                    std::size_t i = pow_start;
-                                    while ( i < pow_finish ) {
-                                        if (challenge_found) {
-                                            break;
-                                        }
-                                        transcript_type tmp_transcript = transcript;
-                                        tmp_transcript(pow_seed + i);
-                                        integral_type pow_result = integral_type(tmp_transcript.template challenge<FieldType>().data);
-                                        if ( ((pow_result & mask) == 0) && !challenge_found ) {
-                                            bool expected = false;
-                                            if (challenge_found.compare_exchange_strong(expected, true)) {
-                                                pow_value_offset = i;
-                                            }
-                                            break;
-                                        }
-                                        ++i;
-                                    }
-                                }, ThreadPool::PoolLevel::LOW));
-
-                            if (challenge_found) {
-                                break;
-                            }
-                            pow_seed += per_block;
-                        }
+                        std::size_t pow_value_offset = detail::parallel_grinding_search(
+                            [&transcript, &pow_seed, &mask](std::size_t i) {
+                                transcript_type tmp_transcript = transcript;
+                                tmp_transcript(pow_seed + i);
+                                integral_type pow_result = integral_type(tmp_transcript.template challenge<FieldType>().data);
+                                return (pow_result & mask) == 0;
+                            });
 
                         transcript(pow_seed + (std::size_t)pow_value_offset);
                         transcript.template challenge<FieldType>();
@@ -57,6 +57,8 @@
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
 
 #include <nil/crypto3/zk/commitments/batched_commitment.hpp>
+#include <nil/crypto3/zk/commitments/detail/polynomial/batch_normalize.hpp>
+#include <nil/crypto3/zk/commitments/detail/polynomial/fixed_base_batch_exp.hpp>
 
 using namespace nil::crypto3::math;
 
@@ -102,22 +104,14 @@ namespace nil {
                         params_type(std::size_t d) {
                             auto alpha = algebra::random_element<field_type>();
                             verification_key = verification_key_type::one() * alpha;
-                            commitment_key.resize(d);
-                            auto alpha_com = commitment_type::one();
-                            for (std::size_t i = 0; i < d; i++) {
-                                commitment_key[i] = alpha_com;
-                                alpha_com = alpha * alpha_com;
-                            }
+                            commitment_key = detail::parallel_fixed_base_powers<typename curve_type::template g1_type<>>(
+                                commitment_type::one(), alpha, d);
                         }
 
                         params_type(std::size_t d, scalar_value_type alpha) {
                             verification_key = verification_key_type::one() * alpha;
-                            commitment_key.resize(d);
-                            auto alpha_com = commitment_type::one();
-                            for (std::size_t i = 0; i < d; i++) {
-                                commitment_key[i] = alpha_com;
-                                alpha_com = alpha * alpha_com;
-                            }
+                            commitment_key = detail::parallel_fixed_base_powers<typename curve_type::template g1_type<>>(
+                                commitment_type::one(), alpha, d);
                         }
 
                         params_type(single_commitment_type ck, verification_key_type vk) :
@@ -279,33 +273,17 @@ namespace nil {
 
                         params_type(std::size_t d, std::size_t t) {
                             auto alpha = algebra::random_element<typename curve_type::scalar_field_type>();
-                            commitment_key.resize(d);
-                            verification_key.resize(t + 1);
-                            auto alpha_comm = single_commitment_type::one();
-                            for (std::size_t i = 0; i < d; ++i) {
-                                commitment_key[i] = alpha_comm;
-                                alpha_comm *= alpha;
-                            }
-                            auto alpha_ver = verification_key_type::one();
-                            for (std::size_t i = 0; i <= t; ++i) {
-                                verification_key[i] = alpha_ver;
-                                alpha_ver *= alpha;
-                            }
+                            commitment_key = detail::parallel_fixed_base_powers<typename curve_type::template g1_type<>>(
+                                single_commitment_type::one(), alpha, d);
+                            verification_key = detail::parallel_fixed_base_powers<typename curve_type::template g2_type<>>(
+                                verification_key_type::one(), alpha, t + 1);
                         }
 
                         params_type(std::size_t d, std::size_t t, scalar_value_type alpha) {
-                            commitment_key.resize(d);
-                            verification_key.resize(t + 1);
-                            auto alpha_comm = single_commitment_type::one();
-                            for (std::size_t i = 0; i < d; ++i) {
-                                commitment_key[i] = alpha_comm;
-                                alpha_comm = alpha * alpha_comm;
-                            }
-                            auto alpha_ver = verification_key_type::one();
-                            for (std::size_t i = 0; i <= t; ++i) {
-                                verification_key[i] = alpha_ver;
-                                alpha_ver = alpha * alpha_ver;
-                            }
+                            commitment_key = detail::parallel_fixed_base_powers<typename curve_type::template g1_type<>>(
+                                single_commitment_type::one(), alpha, d);
+                            verification_key = detail::parallel_fixed_base_powers<typename curve_type::template g2_type<>>(
+                                verification_key_type::one(), alpha, t + 1);
                         }
 
                         params_type(std::vector<single_commitment_type> commitment_key,
@@ -452,6 +430,7 @@ namespace nil {
                         BOOST_ASSERT(polys[i].size() <= params.commitment_key.size());
                         commitments[i] = commit_one<CommitmentSchemeType>(params, polys[i]);
                     }
+                    nil::crypto3::zk::commitments::detail::parallel_batch_normalize(commitments);
                     return commitments;
                 }
 
@@ -470,6 +449,7 @@ namespace nil {
                         BOOST_ASSERT(polys[i].size() <= params.commitment_key.size());
                         commitments[i] = commit_one<CommitmentSchemeType>(params, polys[i]);
                     }
+                    nil::crypto3::zk::commitments::detail::parallel_batch_normalize(commitments);
                     return commitments;
                 }
 
@@ -749,13 +729,18 @@ namespace nil {
                         this->_ind_commitments[index] = {};
                         this->state_commited(index);
 
-                        std::vector<std::uint8_t> result;
                         for (std::size_t i = 0; i < this->_polys[index].size(); ++i) {
                             BOOST_ASSERT(this->_polys[index][i].degree() <= _params.commitment_key.size());
-                            auto single_commitment = nil::crypto3::zk::algorithms::commit_one<CommitmentSchemeType>(
+                            this->_ind_commitments[index].push_back(
+                                nil::crypto3::zk::algorithms::commit_one<CommitmentSchemeType>(
                                     _params,
-                                    this->_polys[index][i]);
-                            this->_ind_commitments[index].push_back(single_commitment);
+                                    this->_polys[index][i]));
+                        }
+                        // Packing normalized points takes no inversions.
+                        nil::crypto3::zk::commitments::detail::parallel_batch_normalize(this->_ind_commitments[index]);
+
+                        std::vector<std::uint8_t> result;
+                        for (const auto& single_commitment : this->_ind_commitments[index]) {
                             nil::crypto3::marshalling::status_type status;
                             std::vector<uint8_t> single_commitment_bytes =
                                     nil::crypto3::marshalling::pack<endianness>(single_commitment, status);
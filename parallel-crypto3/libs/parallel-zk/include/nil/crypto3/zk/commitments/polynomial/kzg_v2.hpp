@@ -56,6 +56,7 @@
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
 
 #include <nil/crypto3/zk/commitments/batched_commitment.hpp>
+#include <nil/crypto3/zk/commitments/detail/polynomial/batch_normalize.hpp>
 #include <nil/crypto3/zk/detail/field_element_consumer.hpp>
 
 using namespace nil::crypto3::math;
@@ -206,6 +207,8 @@ namespace nil {
                                     this->_polys[index][i]);
                             this->_ind_commitments[index][i] = single_commitment;
                         });
+                        // Packing normalized points takes no inversions.
+                        nil::crypto3::zk::commitments::detail::parallel_batch_normalize(this->_ind_commitments[index]);
                         std::vector<std::uint8_t> result;
                         for (const auto& single_commitment : this->_ind_commitments[index]) {
                             nil::crypto3::marshalling::status_type status;
@@ -34,6 +34,17 @@
 #error "You're mixing parallel and non-parallel crypto3 versions"
 #endif
 
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
 #include <nil/crypto3/math/polynomial/lagrange_interpolation.hpp>
 
@@ -42,6 +53,7 @@
 
 #include <nil/crypto3/zk/commitments/batched_commitment.hpp>
 #include <nil/crypto3/zk/commitments/detail/polynomial/basic_fri.hpp>
+#include <nil/crypto3/zk/commitments/detail/polynomial/spill_file.hpp>
 
 #include <nil/actor/core/thread_pool.hpp>
 #include <nil/actor/core/parallelization_utils.hpp>
@@ -87,6 +99,178 @@ namespace nil {
                     std::map<std::size_t, bool> _batch_fixed;
                     preprocessed_data_type _fixed_polys_values;
 
+                    // Location of a committed batch in a spill file, see set_memory_budget.
+                    struct spilled_batch {
+                        // Only read once written, copies of the scheme share it.
+                        std::shared_ptr<const detail::spill_file> file;
+                        std::vector<std::uint64_t> poly_offsets;
+                        std::vector<std::size_t> poly_sizes;
+                        std::vector<std::size_t> poly_degrees;
+                        std::uint64_t tree_offset;
+                        std::size_t tree_size;
+                        std::size_t tree_leaves;
+                        std::size_t tree_discarded_rows;
+                        commitment_type root;
+                    };
+                    std::size_t _memory_budget = 0;
+                    std::string _spill_directory;
+                    // File this scheme spills new batches to, every copy of the scheme gets its own one.
+                    detail::spill_file_writer _spill_file;
+                    std::map<std::size_t, spilled_batch> _spilled_batches;
+                    // Batches whose polynomials and tree are only in the spill file at the moment.
+                    std::set<std::size_t> _paged_out;
+
+                    std::map<std::size_t, commitment_type> tree_roots() const {
+                        std::map<std::size_t, commitment_type> roots;
+                        for (const auto &[index, tree] : _trees) {
+                            roots[index] = _paged_out.count(index) ? _spilled_batches.at(index).root : tree.root();
+                        }
+                        return roots;
+                    }
+
+                    // Bytes of the polynomials and the merkle tree of a committed batch.
+                    std::size_t batch_bytes(std::size_t index) const {
+                        std::size_t bytes = 0;
+                        for (const auto& poly : this->_polys.at(index)) {
+                            bytes += poly.size() * sizeof(value_type);
+                        }
+                        const auto& tree = _trees.at(index);
+                        return bytes + std::distance(tree.begin(), tree.end()) * sizeof(typename precommitment_type::value_type);
+                    }
+
+                    std::vector<polynomial_type> read_spilled_polys(std::size_t index) const {
+                        const spilled_batch& batch = _spilled_batches.at(index);
+                        std::vector<polynomial_type> polys;
+                        polys.reserve(batch.poly_sizes.size());
+                        for (std::size_t i = 0; i < batch.poly_sizes.size(); ++i) {
+                            if constexpr (std::is_same<math::polynomial_dfs<value_type>, polynomial_type>::value) {
+                                polys.emplace_back(batch.poly_degrees[i], batch.poly_sizes[i]);
+                            } else {
+                                polys.emplace_back(batch.poly_sizes[i]);
+                            }
+                            batch.file->read(batch.poly_offsets[i], &*polys.back().begin(), batch.poly_sizes[i]);
+                        }
+                        return polys;
+                    }
+
+                    // Drops the polynomials and the tree of a committed batch from memory, they are written to the
+                    // spill file the first time.
+                    void page_out(std::size_t index) {
+                        auto& polys = this->_polys.at(index);
+                        auto& tree = _trees.at(index);
+                        if (_spilled_batches.find(index) == _spilled_batches.end()) {
+                            const std::shared_ptr<detail::spill_file> file = _spill_file.get(_spill_directory);
+                            spilled_batch batch;
+                            batch.file = file;
+                            for (const auto& poly : polys) {
+                                batch.poly_offsets.push_back(file->append(&*poly.begin(), poly.size()));
+                                batch.poly_sizes.push_back(poly.size());
+                                if constexpr (std::is_same<math::polynomial_dfs<value_type>, polynomial_type>::value) {
+                                    batch.poly_degrees.push_back(poly.degree());
+                                } else {
+                                    batch.poly_degrees.push_back(0);
+                                }
+                            }
+                            batch.tree_size = std::distance(tree.begin(), tree.end());
+                            batch.tree_offset = file->append(&*tree.begin(), batch.tree_size);
+                            batch.tree_leaves = tree.leaves();
+                            batch.tree_discarded_rows = tree.discarded_rows();
+                            batch.root = tree.root();
+                            _spilled_batches[index] = std::move(batch);
+                        }
+                        polys = std::vector<polynomial_type>(polys.size());
+                        tree = precommitment_type();
+                        _paged_out.insert(index);
+                    }
+
+                    precommitment_type read_spilled_tree(std::size_t index) const {
+                        const spilled_batch& batch = _spilled_batches.at(index);
+                        auto nodes = batch.file->template read<typename precommitment_type::value_type>(
+                            batch.tree_offset, batch.tree_size);
+                        return precommitment_type(batch.tree_leaves, nodes.begin(), nodes.end());
+                    }
+
+                    void page_in(std::size_t index) {
+                        if (_paged_out.erase(index) == 0) {
+                            return;
+                        }
+                        this->_polys[index] = read_spilled_polys(index);
+                        _trees[index] = read_spilled_tree(index);
+                    }
+
+                    // Pages out the largest committed batches until the rest fits the budget.
+                    void enforce_memory_budget() {
+                        if (_memory_budget == 0) {
+                            return;
+                        }
+                        std::size_t resident = get_resident_batch_bytes();
+                        while (resident > _memory_budget) {
+                            std::size_t largest = 0, largest_bytes = 0;
+                            for (const auto &[index, tree] : _trees) {
+                                if (_paged_out.count(index) == 0 && batch_bytes(index) > largest_bytes) {
+                                    largest = index;
+                                    largest_bytes = batch_bytes(index);
+                                }
+                            }
+                            if (largest_bytes == 0) {
+                                break;
+                            }
+                            page_out(largest);
+                            resident -= largest_bytes;
+                        }
+                    }
+
+                    // Calls f with groups of batch indices whose polynomials and trees are in memory. All resident
+                    // batches come in the first group, then every paged out batch is brought in and handed over
+                    // on its own, and paged out again afterwards if the budget is exceeded.
+                    template<typename F>
+                    void for_each_batch_group(F f) {
+                        std::vector<std::size_t> resident;
+                        for (const auto& it : this->_polys) {
+                            if (_paged_out.count(it.first) == 0) {
+                                resident.push_back(it.first);
+                            }
+                        }
+                        const std::vector<std::size_t> paged_out(_paged_out.begin(), _paged_out.end());
+                        if (!resident.empty()) {
+                            f(resident);
+                        }
+                        for (std::size_t index : paged_out) {
+                            page_in(index);
+                            f(std::vector<std::size_t>{index});
+                            enforce_memory_budget();
+                        }
+                    }
+
+                    // Initial proofs of the query phase, batch group after batch group.
+                    typename fri_type::initial_proofs_batch_type build_initial_proofs(
+                            const std::vector<typename fri_type::field_type::value_type>& challenges) {
+                        if (_paged_out.empty()) {
+                            return nil::crypto3::zk::algorithms::query_phase_initial_proofs<fri_type, polynomial_type>(
+                                this->_trees, this->_fri_params, this->_polys, challenges);
+                        }
+                        typename fri_type::initial_proofs_batch_type initial_proofs;
+                        initial_proofs.initial_proofs.resize(_fri_params.lambda);
+                        for_each_batch_group([this, &challenges, &initial_proofs](const std::vector<std::size_t>& group) {
+                            std::map<std::size_t, precommitment_type> trees;
+                            std::map<std::size_t, std::vector<polynomial_type>> polys;
+                            for (std::size_t index : group) {
+                                trees[index] = std::move(_trees.at(index));
+                                polys[index] = std::move(this->_polys.at(index));
+                            }
+                            auto part = nil::crypto3::zk::algorithms::query_phase_initial_proofs<fri_type, polynomial_type>(
+                                trees, this->_fri_params, polys, challenges);
+                            for (std::size_t index : group) {
+                                _trees[index] = std::move(trees.at(index));
+                                this->_polys[index] = std::move(polys.at(index));
+                            }
+                            for (std::size_t query_id = 0; query_id < _fri_params.lambda; ++query_id) {
+                                initial_proofs.initial_proofs[query_id].merge(part.initial_proofs[query_id]);
+                            }
+                        });
+                        return initial_proofs;
+                    }
+
                 public:
                     // Getters for the upper fields. Used from marshalling only so far.
                     const std::map<std::size_t, precommitment_type>& get_trees() const {return _trees;}
@@ -95,6 +279,119 @@ namespace nil {
                     const std::map<std::size_t, bool>& get_batch_fixed() const {return _batch_fixed;}
                     const preprocessed_data_type& get_fixed_polys_values() const {return _fixed_polys_values;}
 
+                    // Nodes of the top rows of every tree, the root being the last one. rows_to_discard has the
+                    // meaning of containers::detail::merkle_tree_cache_size, the leaves are never included.
+                    // Trees that already lack more rows, see set_tree_tops, are returned as they are.
+                    std::map<std::size_t, std::vector<commitment_type>> get_tree_tops(std::size_t rows_to_discard) const {
+                        std::map<std::size_t, std::vector<commitment_type>> result;
+                        visit_trees([&result, rows_to_discard](std::size_t index, const precommitment_type& tree) {
+                            std::size_t top_size = 1;
+                            if (tree.row_count() > 1) {
+                                top_size = std::min(tree.size(), containers::detail::merkle_tree_cache_size(
+                                    tree.leaves(), precommitment_type::arity,
+                                    std::min(rows_to_discard, tree.row_count() - 2)));
+                            }
+                            result[index] = std::vector<commitment_type>(tree.end() - top_size, tree.end());
+                        });
+                        return result;
+                    }
+
+                    // Calls f(index, tree) for every merkle tree in get_trees(), in the same order. A tree that is
+                    // in the spill file is read for the call only, resident trees are passed as they are.
+                    template<typename F>
+                    void visit_trees(F f) const {
+                        for (const auto &[index, tree] : _trees) {
+                            if (_paged_out.count(index) != 0) {
+                                f(index, read_spilled_tree(index));
+                            } else {
+                                f(index, tree);
+                            }
+                        }
+                    }
+
+                    // Same as visit_trees for the polynomials of every batch.
+                    template<typename F>
+                    void visit_polys(F f) const {
+                        for (const auto &[index, polys] : this->_polys) {
+                            if (_paged_out.count(index) != 0) {
+                                f(index, read_spilled_polys(index));
+                            } else {
+                                f(index, polys);
+                            }
+                        }
+                    }
+
+                    // Used from marshalling of the compact state, replaces the trees by their top rows. The bottom rows
+                    // are rebuilt from the committed polynomials for the queried leaves only, see
+                    // algorithms::query_phase_initial_proofs.
+                    void set_tree_tops(const std::map<std::size_t, std::vector<commitment_type>>& tree_tops) {
+                        const std::size_t leaves = _fri_params.D[0]->size() >> _fri_params.step_list.front();
+                        for (const auto &[index, top] : tree_tops) {
+                            if (top.empty()) {
+                                throw std::invalid_argument("LPC: empty merkle tree top");
+                            }
+                            _trees[index] = precommitment_type(leaves, top.begin(), top.end());
+                        }
+                    }
+
+                    // True if some tree keeps its top rows only, such a scheme can be saved as compact state only.
+                    bool has_partial_trees() const {
+                        for (const auto &[index, tree] : _trees) {
+                            const std::size_t discarded_rows = _paged_out.count(index) != 0
+                                ? _spilled_batches.at(index).tree_discarded_rows : tree.discarded_rows();
+                            if (discarded_rows != 0) {
+                                return true;
+                            }
+                        }
+                        return false;
+                    }
+
+                    /** Keeps the committed batches, polynomials together with their merkle trees, within memory_budget
+                     *  bytes. The largest batches are moved to a scratch file in spill_directory and paged back one at
+                     *  a time by eval_polys, prepare_combined_Q and the query phase, so the resident batches exceed the
+                     *  budget by at most one batch. 0 keeps everything in memory.
+                     */
+                    void set_memory_budget(std::size_t memory_budget, const std::string& spill_directory = ".") {
+                        _memory_budget = memory_budget;
+                        _spill_directory = spill_directory;
+                        enforce_memory_budget();
+                    }
+
+                    std::size_t get_memory_budget() const {
+                        return _memory_budget;
+                    }
+
+                    // Bytes of the committed batches that are in memory.
+                    std::size_t get_resident_batch_bytes() const {
+                        std::size_t bytes = 0;
+                        for (const auto &[index, tree] : _trees) {
+                            if (_paged_out.count(index) == 0) {
+                                bytes += batch_bytes(index);
+                            }
+                        }
+                        return bytes;
+                    }
+
+                    // Bytes of the committed batches that have been written to spill files.
+                    std::size_t get_spilled_bytes() const {
+                        std::size_t bytes = 0;
+                        for (const auto &[index, batch] : _spilled_batches) {
+                            for (std::size_t size : batch.poly_sizes) {
+                                bytes += size * sizeof(value_type);
+                            }
+                            bytes += batch.tree_size * sizeof(typename precommitment_type::value_type);
+                        }
+                        return bytes;
+                    }
+
+                    // Brings all batches back to memory, marshalling works on resident batches only.
+                    void load_spilled_batches() {
+                        const std::vector<std::size_t> paged_out(_paged_out.begin(), _paged_out.end());
+                        for (std::size_t index : paged_out) {
+                            page_in(index);
+                        }
+                    }
+
                     // We must set it in verifier, taking this value from common data.
                     void set_fixed_polys_values(const preprocessed_data_type& value) {_fixed_polys_values = value;}
 
@@ -128,9 +425,16 @@ namespace nil {
                         for(auto const&[index, fixed]: _batch_fixed) {
                             if (!fixed)
                                 continue;
-                            result[index] = {};
-                            for (const auto& poly: this->_polys.at(index)){
-                                result[index].push_back(poly.evaluate(etha));
+                            auto& values = result[index];
+                            auto evaluate = [&etha, &values](const std::vector<polynomial_type>& polys) {
+                                for (const auto& poly: polys){
+                                    values.push_back(poly.evaluate(etha));
+                                }
+                            };
+                            if (_paged_out.count(index) != 0) {
+                                evaluate(read_spilled_polys(index));
+                            } else {
+                                evaluate(this->_polys.at(index));
                             }
                         }
                         return result;
@@ -146,7 +450,9 @@ namespace nil {
 
                         _trees[index] = nil::crypto3::zk::algorithms::precommit<fri_type>(
                             this->_polys[index], _fri_params.D[0], _fri_params.step_list.front());
-                        return _trees[index].root();
+                        const commitment_type root = _trees[index].root();
+                        enforce_memory_budget();
+                        return root;
                     }
 
                     // Should be done after commitment.
@@ -168,14 +474,18 @@ namespace nil {
                     }
 
                     void eval_polys_and_add_roots_to_transcipt(transcript_type &transcript) {
-                        this->eval_polys();
+                        for_each_batch_group([this](const std::vector<std::size_t>& group) {
+                            for (std::size_t index : group) {
+                                this->eval_batch(index);
+                            }
+                        });
 
                         BOOST_ASSERT(this->_points.size() == this->_polys.size());
                         BOOST_ASSERT(this->_points.size() == this->_z.get_batches_num());
 
-                        // For each batch we have a merkle tree.
-                        for (auto const& it: this->_trees) {
-                            transcript(it.second.root());
+                        // For each batch we have a merkle tree, only the roots are needed here.
+                        for (auto const& [index, root]: tree_roots()) {
+                            transcript(root);
                         }
                     }
 
@@ -189,10 +499,7 @@ namespace nil {
                     lpc_proof_type proof_eval_lpc_proof(
                             const polynomial_type& combined_Q,
                             const std::vector<typename fri_type::field_type::value_type>& challenges) {
-
-                        typename fri_type::initial_proofs_batch_type initial_proofs =
-                            nil::crypto3::zk::algorithms::query_phase_initial_proofs<fri_type, polynomial_type>(
-                            this->_trees, this->_fri_params, this->_polys, challenges);
+                        typename fri_type::initial_proofs_batch_type initial_proofs = build_initial_proofs(challenges);
                         return {this->_z, initial_proofs};
                     }
 
@@ -252,13 +559,41 @@ namespace nil {
 
                     typename fri_type::proof_type commit_and_fri_proof(
                             const polynomial_type& combined_Q, transcript_type &transcript) {
-
                         precommitment_type combined_Q_precommitment = nil::crypto3::zk::algorithms::precommit<fri_type>(
                             combined_Q,
                             _fri_params.D[0],
                             _fri_params.step_list.front()
                         );
 
+                        if (!_paged_out.empty()) {
+                            // Same steps as algorithms::proof_eval, with the initial proofs built batch by batch.
+                            typename fri_type::proof_type fri_proof;
+                            std::vector<precommitment_type> fri_trees;
+                            std::vector<polynomial_type> fs;
+                            typename fri_type::commitments_part_of_proof commitments_proof;
+                            std::tie(fs, fri_trees, commitments_proof) =
+                                nil::crypto3::zk::algorithms::commit_phase<fri_type, polynomial_type>(
+                                    combined_Q, combined_Q_precommitment, _fri_params, transcript);
+                            fri_proof.proof_of_work = nil::crypto3::zk::algorithms::run_grinding<fri_type>(
+                                _fri_params, transcript);
+
+                            const auto challenges =
+                                transcript.template challenges<typename fri_type::field_type>(_fri_params.lambda);
+                            auto initial_proofs = build_initial_proofs(challenges);
+                            auto round_proofs = nil::crypto3::zk::algorithms::query_phase_round_proofs<
+                                    fri_type, polynomial_type>(
+                                _fri_params, fri_trees, fs, commitments_proof.final_polynomial, challenges);
+                            fri_proof.query_proofs.resize(_fri_params.lambda);
+                            for (std::size_t query_id = 0; query_id < _fri_params.lambda; query_id++) {
+                                fri_proof.query_proofs[query_id] = {
+                                    std::move(initial_proofs.initial_proofs[query_id]),
+                                    std::move(round_proofs.round_proofs[query_id])};
+                            }
+                            fri_proof.fri_roots = std::move(commitments_proof.fri_roots);
+                            fri_proof.final_polynomial = std::move(commitments_proof.final_polynomial);
+                            return fri_proof;
+                        }
+
                         typename fri_type::proof_type fri_proof = nil::crypto3::zk::algorithms::proof_eval<
                                 fri_type, polynomial_type>(
                             this->_polys,
@@ -283,140 +618,145 @@ namespace nil {
                             std::size_t starting_power = 0) {
                         this->build_points_map();
 
-                        typename field_type::value_type theta_acc = theta.pow(starting_power);
                         polynomial_type combined_Q;
-                        math::polynomial<value_type> V;
 
                         auto points = this->get_unique_points();
                         math::polynomial<value_type> combined_Q_normal;
 
-                        std::vector<math::polynomial<value_type>> Q_normals(points.size());
-
-                        // We need to pre-compute what power of theta is the starting power for each itertion
-                        // of the loop over the points.
-                        std::vector<std::size_t> theta_powers;
-
-                        // Write point and back indices into a vector, so it's easier to parallelize.
-                        std::vector<std::pair<std::size_t, std::size_t>> point_batch_pairs;
-
-                        // An array of the same size as point_batch_pairs, showing starting power of theta for
-                        // each entry of 'point_batch_pairs'.
-                        std::vector<std::size_t> theta_powers_for_each_batch;
+                        const std::vector<std::size_t> batches = this->_z.get_batches();
+                        std::map<std::size_t, std::size_t> batch_positions;
+                        for (std::size_t batch_idx = 0; batch_idx < batches.size(); ++batch_idx) {
+                            batch_positions[batches[batch_idx]] = batch_idx;
+                        }
 
-                        theta_powers.push_back(starting_power);
+                        // We need to pre-compute what power of theta is the starting power for each point and batch,
+                        // the polynomials are taken point by point, and batch by batch for each point.
+                        std::vector<std::vector<std::size_t>> theta_powers_for_each_batch(
+                            points.size(), std::vector<std::size_t>(batches.size()));
                         std::size_t current_power = starting_power;
                         for (std::size_t point_index = 0; point_index < points.size(); ++point_index) {
-                            for(std::size_t batch_idx = 0; batch_idx < this->_z.get_batches().size(); ++batch_idx) {
-                                point_batch_pairs.push_back({point_index, batch_idx});
-                                theta_powers_for_each_batch.push_back(current_power);
+                            for (std::size_t batch_idx = 0; batch_idx < batches.size(); ++batch_idx) {
+                                theta_powers_for_each_batch[point_index][batch_idx] = current_power;
 
-                                std::size_t i = this->_z.get_batches()[batch_idx];
+                                std::size_t i = batches[batch_idx];
                                 for(std::size_t j = 0; j < this->_z.get_batch_size(i); j++) {
                                     if (this->_points_map[i][j].find(points[point_index]) != this->_points_map[i][j].end())
                                         current_power++;
                                 }
                             }
-                            theta_powers.push_back(current_power);
-                        }
-
-                        // If PolynomialType is DFS type, we need to convert this->polys to coefficients form,
-                        // otherwise we do nothing. After this block polys_coefficients_ptr must be used,
-                        // it will point to this->_polys if no conversion is required, or to polys_coefficients
-                        // if conversion was required.
-                        std::map<std::size_t, std::vector<math::polynomial<value_type>>> polys_coefficients;
-                        std::map<std::size_t, std::vector<math::polynomial<value_type>>>* polys_coefficients_ptr;
-
-                        if constexpr(std::is_same<math::polynomial_dfs<value_type>, PolynomialType>::value ) {
-                            // Convert this->_polys to coefficients form.
-                            std::vector<std::pair<std::size_t, std::size_t>> indices;
-                            for (const auto& [i, V]: this->_polys) {
-                                polys_coefficients[i].resize(V.size());
-                                for (std::size_t j = 0; j < V.size(); ++j) {
-                                    indices.push_back({i, j});
-                                }
-                            }
-
-                            parallel_for(0, indices.size(), [this, &indices, &polys_coefficients](std::size_t i) {
-                                polys_coefficients[indices[i].first][indices[i].second] =
-                                    this->_polys[indices[i].first][indices[i].second].coefficients();
-                            }, ThreadPool::PoolLevel::HIGH);
-
-                            polys_coefficients_ptr = &polys_coefficients;
-                        } else {
-                            polys_coefficients_ptr = &this->_polys;
+                        }
+                        std::vector<std::size_t> theta_powers = {current_power};
+                        for(std::size_t i : batches) {
+                            theta_powers.push_back(theta_powers.back() + this->_z.get_batch_size(i));
                         }
 
-                        std::vector<std::vector<math::polynomial<value_type>>> Q_normal_parts(
-                            points.size(), std::vector<math::polynomial<value_type>>(this->_z.get_batches().size()));
+                        // Numerators of the quotients for every point and for _etha. Division by (x - point) is linear,
+                        // so batches paged out by the memory budget are added one by one and divided in the end.
+                        std::vector<math::polynomial<value_type>> Q_normals(points.size());
+                        std::vector<math::polynomial<value_type>> fixed_Q_normals(batches.size());
+
+                        for_each_batch_group([&](const std::vector<std::size_t>& group) {
+                            // If PolynomialType is DFS type, we need to convert this->polys to coefficients form,
+                            // otherwise we do nothing. After this block polys_coefficients_ptr must be used,
+                            // it will point to this->_polys if no conversion is required, or to polys_coefficients
+                            // if conversion was required.
+                            std::map<std::size_t, std::vector<math::polynomial<value_type>>> polys_coefficients;
+                            std::map<std::size_t, std::vector<math::polynomial<value_type>>>* polys_coefficients_ptr;
+
+                            if constexpr(std::is_same<math::polynomial_dfs<value_type>, PolynomialType>::value ) {
+                                // Convert this->_polys to coefficients form.
+                                std::vector<std::pair<std::size_t, std::size_t>> indices;
+                                for (std::size_t i : group) {
+                                    polys_coefficients[i].resize(this->_polys[i].size());
+                                    for (std::size_t j = 0; j < this->_polys[i].size(); ++j) {
+                                        indices.push_back({i, j});
+                                    }
+                                }
 
-                        parallel_for(0, point_batch_pairs.size(),
-                            [this, &points, &theta, &theta_powers, polys_coefficients_ptr, &point_batch_pairs, &Q_normal_parts, &theta_powers_for_each_batch]
-                                (std::size_t point_batch_index) {
-                            typename field_type::value_type theta_acc = theta.pow(theta_powers_for_each_batch[point_batch_index]);
-                            std::size_t point_index = point_batch_pairs[point_batch_index].first;
-                            auto const &point = points[point_index];
+                                parallel_for(0, indices.size(), [this, &indices, &polys_coefficients](std::size_t i) {
+                                    polys_coefficients[indices[i].first][indices[i].second] =
+                                        this->_polys[indices[i].first][indices[i].second].coefficients();
+                                }, ThreadPool::PoolLevel::HIGH);
 
-                            std::size_t i = this->_z.get_batches()[point_batch_pairs[point_batch_index].second];
-                            for(std::size_t j = 0; j < this->_z.get_batch_size(i); j++) {
-                                auto iter = this->_points_map[i][j].find(point);
-                                if (iter == this->_points_map[i][j].end())
-                                    continue;
+                                polys_coefficients_ptr = &polys_coefficients;
+                            } else {
+                                polys_coefficients_ptr = &this->_polys;
+                            }
 
-                                math::polynomial<value_type> g_normal = (*polys_coefficients_ptr)[i][j];
-                                g_normal *= theta_acc;
-                                Q_normal_parts[point_index][point_batch_pairs[point_batch_index].second] += g_normal;
-                                Q_normal_parts[point_index][point_batch_pairs[point_batch_index].second] -=
-                                    this->_z.get(i, j, iter->second) * theta_acc;
-                                theta_acc *= theta;
+                            // Point and batch indices of the group in a vector, so it's easier to parallelize,
+                            // the batches of every point are consecutive.
+                            std::vector<std::pair<std::size_t, std::size_t>> point_batch_pairs;
+                            for (std::size_t point_index = 0; point_index < points.size(); ++point_index) {
+                                for (std::size_t i : group) {
+                                    point_batch_pairs.push_back({point_index, batch_positions.at(i)});
+                                }
                             }
-                        }, ThreadPool::PoolLevel::HIGH);
+                            std::vector<math::polynomial<value_type>> Q_normal_parts(point_batch_pairs.size());
 
-                        parallel_for(0, points.size(), [this, &points, &Q_normals, &Q_normal_parts](std::size_t point_index) {
-                            math::polynomial<value_type>& Q_normal = Q_normals[point_index];
+                            parallel_for(0, point_batch_pairs.size(),
+                                [this, &points, &theta, polys_coefficients_ptr, &point_batch_pairs, &Q_normal_parts, &theta_powers_for_each_batch, &batches]
+                                    (std::size_t point_batch_index) {
+                                auto [point_index, batch_idx] = point_batch_pairs[point_batch_index];
+                                typename field_type::value_type theta_acc =
+                                    theta.pow(theta_powers_for_each_batch[point_index][batch_idx]);
+                                auto const &point = points[point_index];
 
-                            for(std::size_t batch_index = 0; batch_index < this->_z.get_batches().size(); ++batch_index) {
-                                Q_normal += Q_normal_parts[point_index][batch_index];
-                            }
-                            auto const &point = points[point_index];
-                            math::polynomial<value_type> V = {-point, 1};
-                            Q_normal = Q_normal / V;
-                        }, ThreadPool::PoolLevel::HIGH);
+                                std::size_t i = batches[batch_idx];
+                                for(std::size_t j = 0; j < this->_z.get_batch_size(i); j++) {
+                                    auto iter = this->_points_map[i][j].find(point);
+                                    if (iter == this->_points_map[i][j].end())
+                                        continue;
 
-                        for (const auto& Q_normal: Q_normals) {
-                            combined_Q_normal += Q_normal;
-                        }
+                                    math::polynomial<value_type> g_normal = (*polys_coefficients_ptr)[i][j];
+                                    g_normal *= theta_acc;
+                                    Q_normal_parts[point_batch_index] += g_normal;
+                                    Q_normal_parts[point_batch_index] -= this->_z.get(i, j, iter->second) * theta_acc;
+                                    theta_acc *= theta;
+                                }
+                            }, ThreadPool::PoolLevel::HIGH);
 
-                        // TODO(martun): the following code is the same as above with point = _etha, de-duplicate it.
-                        theta_powers = {theta_powers[points.size()]};
-                        for(std::size_t i : this->_z.get_batches()) {
-                            theta_powers.push_back(theta_powers.back() + this->_z.get_batch_size(i));
-                        }
-                        Q_normals.assign(this->_z.get_batches().size(), math::polynomial<value_type>{});
+                            parallel_for(0, points.size(), [&group, &Q_normals, &Q_normal_parts](std::size_t point_index) {
+                                for (std::size_t k = 0; k < group.size(); ++k) {
+                                    Q_normals[point_index] += Q_normal_parts[point_index * group.size() + k];
+                                }
+                            }, ThreadPool::PoolLevel::HIGH);
 
-                        parallel_for(0, this->_z.get_batches().size(), [this, &theta, &theta_powers, &Q_normals, polys_coefficients_ptr](std::size_t batch_idx) {
-                            std::size_t i = this->_z.get_batches()[batch_idx];
-                            typename field_type::value_type theta_acc = theta.pow(theta_powers[i]);
+                            // TODO(martun): the following code is the same as above with point = _etha, de-duplicate it.
+                            parallel_for(0, group.size(), [this, &group, &theta, &theta_powers, &fixed_Q_normals, &batch_positions, polys_coefficients_ptr](std::size_t group_index) {
+                                std::size_t i = group[group_index];
+                                typename field_type::value_type theta_acc = theta.pow(theta_powers[i]);
 
-                            if( _batch_fixed.find(i) == _batch_fixed.end() || !_batch_fixed[i] )
-                                return;
-                            math::polynomial<value_type>& Q_normal = Q_normals[batch_idx];
-                            auto point = _etha;
-                            math::polynomial<value_type> V = {-point, 1u};
+                                auto fixed = _batch_fixed.find(i);
+                                if (fixed == _batch_fixed.end() || !fixed->second)
+                                    return;
+                                math::polynomial<value_type>& Q_normal = fixed_Q_normals[batch_positions.at(i)];
 
-                            for(std::size_t j = 0; j < this->_z.get_batch_size(i); j++){
-                                math::polynomial<value_type> g_normal = (*polys_coefficients_ptr)[i][j];
-                                g_normal *= theta_acc;
-                                Q_normal += g_normal;
-                                Q_normal -= _fixed_polys_values[i][j] * theta_acc;
-                                theta_acc *= theta;
-                            }
+                                for(std::size_t j = 0; j < this->_z.get_batch_size(i); j++){
+                                    math::polynomial<value_type> g_normal = (*polys_coefficients_ptr)[i][j];
+                                    g_normal *= theta_acc;
+                                    Q_normal += g_normal;
+                                    Q_normal -= _fixed_polys_values[i][j] * theta_acc;
+                                    theta_acc *= theta;
+                                }
+                            }, ThreadPool::PoolLevel::HIGH);
+                        });
 
-                            Q_normal = Q_normal / V;
+                        parallel_for(0, points.size(), [&points, &Q_normals](std::size_t point_index) {
+                            math::polynomial<value_type> V = {-points[point_index], 1};
+                            Q_normals[point_index] = Q_normals[point_index] / V;
+                        }, ThreadPool::PoolLevel::HIGH);
+
+                        parallel_for(0, batches.size(), [this, &fixed_Q_normals](std::size_t batch_idx) {
+                            math::polynomial<value_type> V = {-_etha, 1u};
+                            fixed_Q_normals[batch_idx] = fixed_Q_normals[batch_idx] / V;
                         }, ThreadPool::PoolLevel::HIGH);
 
                         for (const auto& Q_normal: Q_normals) {
                             combined_Q_normal += Q_normal;
                         }
+                        for (const auto& Q_normal: fixed_Q_normals) {
+                            combined_Q_normal += Q_normal;
+                        }
 
                         if constexpr (std::is_same<math::polynomial_dfs<value_type>, PolynomialType>::value) {
                             combined_Q.from_coefficients(combined_Q_normal);
@@ -0,0 +1,452 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2025 Nil Foundation AG
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef PARALLEL_CRYPTO3_ZK_MATH_EXPRESSION_DAG_HPP
+#define PARALLEL_CRYPTO3_ZK_MATH_EXPRESSION_DAG_HPP
+
+#ifdef CRYPTO3_ZK_MATH_EXPRESSION_DAG_HPP
+#error "You're mixing parallel and non-parallel crypto3 versions"
+#endif
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+#include <boost/variant/static_visitor.hpp>
+#include <boost/variant/apply_visitor.hpp>
+
+#include <nil/crypto3/zk/math/expression.hpp>
+#include <nil/crypto3/zk/math/expression_evaluator.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+
+            /**
+             * Hash-consed expression graph. Nodes live in one contiguous arena and are identified by their index,
+             * a node is created only if no structurally equal node exists yet, so equal subexpressions of all the
+             * expressions built in one graph share a node. Handles to nodes are two words and copied for free,
+             * unlike expression, where every operation copies both operand trees.
+             *
+             * Children are always created before their parents, so node ids are a topological order.
+             * Nodes are never removed, the graph grows until it is destroyed.
+             */
+            template<typename VariableType>
+            class expression_dag {
+            public:
+                typedef VariableType variable_type;
+                typedef typename VariableType::assignment_type assignment_type;
+                typedef term<VariableType> term_type;
+                typedef expression<VariableType> expression_type;
+                typedef std::uint32_t node_id;
+
+                enum class node_kind : std::uint8_t {
+                    TERM,
+                    POW,
+                    ADD,
+                    SUB,
+                    MULT
+                };
+
+                // For TERM nodes 'left' is the index of the term, for POW nodes 'right' is the power.
+                struct node {
+                    node_kind kind;
+                    std::uint32_t left;
+                    std::uint32_t right;
+
+                    bool operator==(const node& other) const {
+                        return kind == other.kind && left == other.left && right == other.right;
+                    }
+                };
+
+                // A node of a given graph, with the same arithmetic as expression.
+                class handle {
+                public:
+                    handle(expression_dag* dag, node_id id) : dag(dag), id(id) {
+                    }
+
+                    node_id get_id() const {
+                        return id;
+                    }
+
+                    expression_dag& get_dag() const {
+                        return *dag;
+                    }
+
+                    handle operator+(const handle& other) const {
+                        return handle(dag, dag->binary(ArithmeticOperator::ADD, id, other.id));
+                    }
+
+                    handle operator-(const handle& other) const {
+                        return handle(dag, dag->binary(ArithmeticOperator::SUB, id, other.id));
+                    }
+
+                    handle operator*(const handle& other) const {
+                        return handle(dag, dag->binary(ArithmeticOperator::MULT, id, other.id));
+                    }
+
+                    handle operator-() const {
+                        return handle(dag, dag->binary(ArithmeticOperator::SUB, dag->zero_id, id));
+                    }
+
+                    handle& operator+=(const handle& other) {
+                        return *this = *this + other;
+                    }
+
+                    handle& operator-=(const handle& other) {
+                        return *this = *this - other;
+                    }
+
+                    handle& operator*=(const handle& other) {
+                        return *this = *this * other;
+                    }
+
+                    handle pow(std::size_t power) const {
+                        return handle(dag, dag->pow(id, power));
+                    }
+
+                    // Structural equality, which for interned nodes is identity.
+                    bool operator==(const handle& other) const {
+                        return dag == other.dag && id == other.id;
+                    }
+
+                    bool operator!=(const handle& other) const {
+                        return !(*this == other);
+                    }
+
+                    expression_type to_expression() const {
+                        return dag->to_expression(id);
+                    }
+
+                private:
+                    expression_dag* dag;
+                    node_id id;
+                };
+
+                expression_dag() {
+                    zero_id = add_term(term_type(assignment_type::zero()));
+                }
+
+                // Handles point into the graph, so it is not copied or moved.
+                expression_dag(const expression_dag&) = delete;
+                expression_dag& operator=(const expression_dag&) = delete;
+
+                handle zero() {
+                    return handle(this, zero_id);
+                }
+
+                handle constant(const assignment_type& value) {
+                    return handle(this, add_term(term_type(value)));
+                }
+
+                handle variable(const VariableType& var) {
+                    return handle(this, add_term(term_type(var)));
+                }
+
+                handle make_term(const term_type& t) {
+                    return handle(this, add_term(t));
+                }
+
+                handle from_expression(const expression_type& expr) {
+                    import_visitor visitor(*this);
+                    return handle(this, boost::apply_visitor(visitor, expr.get_expr()));
+                }
+
+                // Shared nodes become copies of the same subtree.
+                expression_type to_expression(node_id id) const {
+                    std::vector<std::optional<expression_type>> converted(id + 1);
+                    return to_expression(id, converted);
+                }
+
+                const node& get_node(node_id id) const {
+                    return nodes[id];
+                }
+
+                const term_type& get_term(node_id id) const {
+                    return terms[nodes[id].left];
+                }
+
+                std::size_t size() const {
+                    return nodes.size();
+                }
+
+                std::size_t terms_size() const {
+                    return terms.size();
+                }
+
+                // Reserves the arena for the given number of nodes, to avoid reallocations while building.
+                void reserve(std::size_t nodes_count) {
+                    nodes.reserve(nodes_count);
+                    node_ids.reserve(nodes_count);
+                }
+
+            private:
+                struct node_hash {
+                    std::size_t operator()(const node& n) const {
+                        std::size_t result = static_cast<std::size_t>(n.kind);
+                        boost::hash_combine(result, n.left);
+                        boost::hash_combine(result, n.right);
+                        return result;
+                    }
+                };
+
+                // Converts expression trees bottom-up. Equal subtrees are found again by interning.
+                class import_visitor : public boost::static_visitor<node_id> {
+                public:
+                    explicit import_visitor(expression_dag& dag) : dag(dag) {
+                    }
+
+                    node_id operator()(const term_type& t) {
+                        return dag.add_term(t);
+                    }
+
+                    node_id operator()(const pow_operation<VariableType>& pow) {
+                        return dag.pow(boost::apply_visitor(*this, pow.get_expr().get_expr()), pow.get_power());
+                    }
+
+                    node_id operator()(const binary_arithmetic_operation<VariableType>& op) {
+                        const node_id left = boost::apply_visitor(*this, op.get_expr_left().get_expr());
+                        const node_id right = boost::apply_visitor(*this, op.get_expr_right().get_expr());
+                        return dag.binary(op.get_op(), left, right);
+                    }
+
+                private:
+                    expression_dag& dag;
+                };
+
+                expression_type to_expression(node_id id, std::vector<std::optional<expression_type>>& converted) const {
+                    if (converted[id]) {
+                        return *converted[id];
+                    }
+                    const node& n = nodes[id];
+                    expression_type result;
+                    switch (n.kind) {
+                        case node_kind::TERM:
+                            result = terms[n.left];
+                            break;
+                        case node_kind::POW:
+                            result = pow_operation<VariableType>(to_expression(n.left, converted), n.right);
+                            break;
+                        case node_kind::ADD:
+                            result = binary_arithmetic_operation<VariableType>(
+                                to_expression(n.left, converted), to_expression(n.right, converted),
+                                ArithmeticOperator::ADD);
+                            break;
+                        case node_kind::SUB:
+                            result = binary_arithmetic_operation<VariableType>(
+                                to_expression(n.left, converted), to_expression(n.right, converted),
+                                ArithmeticOperator::SUB);
+                            break;
+                        case node_kind::MULT:
+                            result = binary_arithmetic_operation<VariableType>(
+                                to_expression(n.left, converted), to_expression(n.right, converted),
+                                ArithmeticOperator::MULT);
+                            break;
+                    }
+                    converted[id] = result;
+                    return result;
+                }
+
+                node_id add_term(const term_type& t) {
+                    auto iter = term_ids.find(t);
+                    if (iter != term_ids.end()) {
+                        return iter->second;
+                    }
+                    const node_id id = intern(node{node_kind::TERM, static_cast<std::uint32_t>(terms.size()), 0});
+                    terms.push_back(t);
+                    term_ids.emplace(t, id);
+                    return id;
+                }
+
+                node_id pow(node_id base, std::size_t power) {
+                    return intern(node{node_kind::POW, base, static_cast<std::uint32_t>(power)});
+                }
+
+                // Same simplifications as the operators of expression, so that conversions round trip.
+                node_id binary(ArithmeticOperator op, node_id left, node_id right) {
+                    switch (op) {
+                        case ArithmeticOperator::ADD:
+                            if (left == zero_id) {
+                                return right;
+                            }
+                            if (right == zero_id) {
+                                return left;
+                            }
+                            return intern(node{node_kind::ADD, left, right});
+                        case ArithmeticOperator::SUB:
+                            return intern(node{node_kind::SUB, left, right});
+                        case ArithmeticOperator::MULT:
+                            if (left == zero_id || right == zero_id) {
+                                return zero_id;
+                            }
+                            return intern(node{node_kind::MULT, left, right});
+                    }
+                    __builtin_unreachable();
+                }
+
+                node_id intern(const node& n) {
+                    auto iter = node_ids.find(n);
+                    if (iter != node_ids.end()) {
+                        return iter->second;
+                    }
+                    const node_id id = static_cast<node_id>(nodes.size());
+                    nodes.push_back(n);
+                    node_ids.emplace(n, id);
+                    return id;
+                }
+
+                std::vector<node> nodes;
+                std::vector<term_type> terms;
+                std::unordered_map<node, node_id, node_hash> node_ids;
+                std::unordered_map<term_type, node_id> term_ids;
+                node_id zero_id;
+            };
+
+            // Evaluates any number of nodes of one graph, computing every shared node once. Values are released
+            // as soon as their last parent has been computed.
+            template<typename VariableType>
+            class dag_expression_evaluator {
+            private:
+                using MultiplicationType = detail::multiplier<typename VariableType::assignment_type>;
+                MultiplicationType multiplicator;
+
+            public:
+                using ValueType = typename VariableType::assignment_type;
+                using dag_type = expression_dag<VariableType>;
+                using node_id = typename dag_type::node_id;
+                using node_kind = typename dag_type::node_kind;
+
+                dag_expression_evaluator(
+                    const dag_type& dag,
+                    std::function<const ValueType&(const VariableType&)> get_var_value)
+                        : dag(dag)
+                        , get_var_value(get_var_value) {
+                }
+
+                ValueType evaluate(node_id root) {
+                    return std::move(evaluate(std::vector<node_id>{root})[0]);
+                }
+
+                std::vector<ValueType> evaluate(const std::vector<node_id>& roots) {
+                    node_id max_id = 0;
+                    for (node_id root : roots) {
+                        max_id = std::max(max_id, root);
+                    }
+                    // Number of pending uses of every needed node, roots hold one extra use until the end.
+                    std::vector<std::uint32_t> uses(roots.empty() ? 0 : max_id + 1, 0);
+                    for (node_id root : roots) {
+                        uses[root]++;
+                    }
+                    for (std::size_t i = uses.size(); i-- > 0;) {
+                        if (uses[i] == 0) {
+                            continue;
+                        }
+                        const auto& n = dag.get_node(i);
+                        if (n.kind == node_kind::POW) {
+                            uses[n.left]++;
+                        } else if (n.kind != node_kind::TERM) {
+                            uses[n.left]++;
+                            uses[n.right]++;
+                        }
+                    }
+
+                    std::vector<std::optional<ValueType>> values(uses.size());
+                    auto take = [&](node_id id) -> ValueType {
+                        if (--uses[id] == 0) {
+                            ValueType result = std::move(*values[id]);
+                            values[id].reset();
+                            return result;
+                        }
+                        return *values[id];
+                    };
+                    auto get = [&](node_id id) -> const ValueType& {
+                        return *values[id];
+                    };
+                    auto release = [&](node_id id) {
+                        if (--uses[id] == 0) {
+                            values[id].reset();
+                        }
+                    };
+
+                    for (std::size_t i = 0; i < uses.size(); i++) {
+                        if (uses[i] == 0) {
+                            continue;
+                        }
+                        const auto& n = dag.get_node(i);
+                        switch (n.kind) {
+                            case node_kind::TERM:
+                                values[i] = evaluate_term(dag.get_term(i));
+                                break;
+                            case node_kind::POW:
+                                values[i] = take(n.left).pow(n.right);
+                                break;
+                            default: {
+                                ValueType result = take(n.left);
+                                if (n.kind == node_kind::ADD) {
+                                    result += get(n.right);
+                                } else if (n.kind == node_kind::SUB) {
+                                    result -= get(n.right);
+                                } else {
+                                    multiplicator.multiply(result, get(n.right));
+                                }
+                                release(n.right);
+                                values[i] = std::move(result);
+                            }
+                        }
+                    }
+
+                    std::vector<ValueType> result;
+                    result.reserve(roots.size());
+                    for (node_id root : roots) {
+                        result.push_back(*values[root]);
+                    }
+                    return result;
+                }
+
+            private:
+                ValueType evaluate_term(const term<VariableType>& t) {
+                    ValueType result = t.get_coeff();
+                    for (const VariableType& var : t.get_vars()) {
+                        if (result.is_one()) {
+                            result = get_var_value(var);
+                        } else {
+                            multiplicator.multiply(result, get_var_value(var));
+                        }
+                    }
+                    return result;
+                }
+
+                const dag_type& dag;
+
+                // A function used to retrieve the value of a variable.
+                std::function<const ValueType&(const VariableType &var)> get_var_value;
+            };
+        }    // namespace math
+    }    // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_MATH_EXPRESSION_DAG_HPP
@@ -134,6 +134,41 @@ void test_fold_polynomial_dfs() {
     BOOST_CHECK(x1 == x2);
 }
 
+template<typename CurveType>
+void test_fold_polynomial_steps(std::size_t steps) {
+    using FieldType = typename CurveType::base_field_type;
+    using value_type = typename FieldType::value_type;
+
+    constexpr static const std::size_t d_log = 14;
+
+    std::vector<std::shared_ptr<math::evaluation_domain<FieldType>>> D =
+            math::calculate_domain_set<FieldType>(d_log, steps);
+
+    math::polynomial_dfs<value_type> f(D[0]->size() - 1, D[0]->size());
+    for (std::size_t i = 0; i < f.size(); i++) {
+        f[i] = algebra::random_element<FieldType>();
+    }
+    std::vector<value_type> alphas(steps);
+    for (auto &alpha : alphas) {
+        alpha = algebra::random_element<FieldType>();
+    }
+
+    // Reference: one step at a time.
+    math::polynomial_dfs<value_type> expected = f;
+    for (std::size_t step = 0; step < steps; step++) {
+        expected = zk::commitments::detail::fold_polynomial<FieldType>(expected, alphas[step], D[step]);
+    }
+
+    std::vector<value_type> folded;
+    zk::commitments::detail::fold_polynomial_steps<FieldType>(f.get_storage(), folded, alphas, D[0]);
+    BOOST_CHECK_EQUAL(folded.size(), D[0]->size() >> steps);
+    BOOST_CHECK(folded == expected.get_storage());
+
+    std::vector<value_type> in_place(f.begin(), f.end());
+    zk::commitments::detail::fold_polynomial_steps<FieldType>(in_place, in_place, alphas, D[0]);
+    BOOST_CHECK(in_place == expected.get_storage());
+}
+
 BOOST_AUTO_TEST_SUITE(fold_polynomial_test_suite)
 
     BOOST_AUTO_TEST_CASE(fold_polynomial_test) {
@@ -153,4 +188,10 @@ BOOST_AUTO_TEST_SUITE(fold_polynomial_test_suite)
         test_fold_polynomial_dfs<algebra::curves::vesta>();
     }
 
+    BOOST_AUTO_TEST_CASE(fold_polynomial_steps_test) {
+        for (std::size_t steps = 1; steps <= 3; steps++) {
+            test_fold_polynomial_steps<algebra::curves::pallas>(steps);
+        }
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
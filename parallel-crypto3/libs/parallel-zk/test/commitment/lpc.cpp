@@ -28,6 +28,7 @@
 
 #define BOOST_TEST_MODULE lpc_test
 
+#include <filesystem>
 #include <string>
 #include <random>
 #include <regex>
@@ -439,6 +440,165 @@ BOOST_AUTO_TEST_SUITE(lpc_math_polynomial_suite);
         BOOST_CHECK(verifier_next_challenge == prover_next_challenge);
     }
 
+    BOOST_FIXTURE_TEST_CASE(lpc_dfs_memory_budget_test, test_fixture) {
+        // Setup types
+        typedef algebra::curves::bls12<381> curve_type;
+        typedef typename curve_type::scalar_field_type FieldType;
+
+        typedef hashes::sha2<256> merkle_hash_type;
+        typedef hashes::sha2<256> transcript_hash_type;
+
+        constexpr static const std::size_t lambda = 10;
+        constexpr static const std::size_t d = 16;
+        constexpr static const std::size_t m = 2;
+
+        typedef zk::commitments::fri<FieldType, merkle_hash_type, transcript_hash_type, m> fri_type;
+
+        typedef zk::commitments::
+        list_polynomial_commitment_params<merkle_hash_type, transcript_hash_type, m>
+                lpc_params_type;
+        typedef zk::commitments::list_polynomial_commitment<FieldType, lpc_params_type> lpc_type;
+
+        // Setup params
+        std::size_t degree_log = std::ceil(std::log2(d - 1));
+        typename fri_type::params_type fri_params(
+                1, /*max_step*/
+                degree_log,
+                lambda,
+                2, //expand_factor
+                false // use_grinding, its random seed makes proofs differ
+                );
+
+        using lpc_scheme_type = nil::crypto3::zk::commitments::lpc_commitment_scheme<lpc_type>;
+        lpc_scheme_type lpc_scheme_prover(fri_params);
+        lpc_scheme_type lpc_scheme_spilling_prover(fri_params);
+        lpc_scheme_type lpc_scheme_verifier(fri_params);
+
+        // Generate polynomials, the same for both provers
+        for (std::size_t i = 0; i < 4; i++) {
+            auto batch = generate_random_polynomial_dfs_batch<FieldType>(
+                dist_type(1, 10)(test_global_rnd_engine), d, test_global_alg_rnd_engine<FieldType>);
+            lpc_scheme_prover.append_to_batch(i, batch);
+            lpc_scheme_spilling_prover.append_to_batch(i, batch);
+        }
+
+        // Batches 0 and 1 are committed before the budget is set, batches 2 and 3 after it
+        std::map<std::size_t, typename lpc_type::commitment_type> commitments;
+        for (std::size_t i = 0; i < 4; i++) {
+            commitments[i] = lpc_scheme_prover.commit(i);
+        }
+        BOOST_CHECK(lpc_scheme_spilling_prover.commit(0) == commitments[0]);
+        BOOST_CHECK(lpc_scheme_spilling_prover.commit(1) == commitments[1]);
+        lpc_scheme_spilling_prover.set_memory_budget(lpc_scheme_spilling_prover.get_resident_batch_bytes() / 2,
+                                                     std::filesystem::temp_directory_path().string());
+        // A copy shares the batches spilled so far and spills the new ones to a file of its own
+        lpc_scheme_type lpc_scheme_spilling_copy(lpc_scheme_spilling_prover);
+        BOOST_CHECK(lpc_scheme_spilling_prover.commit(2) == commitments[2]);
+        BOOST_CHECK(lpc_scheme_spilling_prover.commit(3) == commitments[3]);
+        BOOST_CHECK(lpc_scheme_spilling_copy.commit(2) == commitments[2]);
+        BOOST_CHECK(lpc_scheme_spilling_copy.commit(3) == commitments[3]);
+        BOOST_CHECK(lpc_scheme_spilling_prover.get_spilled_bytes() > 0);
+        BOOST_CHECK(lpc_scheme_spilling_prover.get_resident_batch_bytes() <=
+                    lpc_scheme_spilling_prover.get_memory_budget());
+
+        // Generate evaluation points. Choose points outside the domain
+        auto point = algebra::fields::arithmetic_params<FieldType>::multiplicative_generator;
+        for (std::size_t i = 0; i < 4; i++) {
+            lpc_scheme_prover.append_eval_point(i, point);
+            lpc_scheme_spilling_prover.append_eval_point(i, point);
+            lpc_scheme_spilling_copy.append_eval_point(i, point);
+        }
+
+        std::array<std::uint8_t, 96> x_data{};
+
+        // Prove, the budget must not change the proof
+        zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> transcript(x_data);
+        auto proof = lpc_scheme_prover.proof_eval(transcript);
+        zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> spilling_transcript(x_data);
+        auto spilling_proof = lpc_scheme_spilling_prover.proof_eval(spilling_transcript);
+        BOOST_CHECK(spilling_proof == proof);
+        zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> copy_transcript(x_data);
+        BOOST_CHECK(lpc_scheme_spilling_copy.proof_eval(copy_transcript) == proof);
+
+        lpc_scheme_spilling_prover.load_spilled_batches();
+        BOOST_CHECK(lpc_scheme_spilling_prover.get_trees() == lpc_scheme_prover.get_trees());
+
+        // Verify
+        zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> transcript_verifier(x_data);
+        for (std::size_t i = 0; i < 4; i++) {
+            lpc_scheme_verifier.set_batch_size(i, spilling_proof.z.get_batch_size(i));
+            lpc_scheme_verifier.append_eval_point(i, point);
+        }
+        BOOST_CHECK(lpc_scheme_verifier.verify_eval(spilling_proof, commitments, transcript_verifier));
+    }
+
+    BOOST_FIXTURE_TEST_CASE(lpc_dfs_partial_trees_test, test_fixture) {
+        // Setup types
+        typedef algebra::curves::bls12<381> curve_type;
+        typedef typename curve_type::scalar_field_type FieldType;
+
+        typedef hashes::sha2<256> merkle_hash_type;
+        typedef hashes::sha2<256> transcript_hash_type;
+
+        constexpr static const std::size_t lambda = 10;
+        constexpr static const std::size_t d = 1 << 10;
+        constexpr static const std::size_t m = 2;
+
+        typedef zk::commitments::fri<FieldType, merkle_hash_type, transcript_hash_type, m> fri_type;
+
+        typedef zk::commitments::
+        list_polynomial_commitment_params<merkle_hash_type, transcript_hash_type, m>
+                lpc_params_type;
+        typedef zk::commitments::list_polynomial_commitment<FieldType, lpc_params_type> lpc_type;
+
+        // Setup params
+        std::size_t degree_log = std::ceil(std::log2(d - 1));
+        typename fri_type::params_type fri_params(
+                1, /*max_step*/
+                degree_log,
+                lambda,
+                2, //expand_factor
+                false // use_grinding, its random seed makes proofs differ
+                );
+
+        using lpc_scheme_type = nil::crypto3::zk::commitments::lpc_commitment_scheme<lpc_type>;
+        lpc_scheme_type lpc_scheme_prover(fri_params);
+
+        auto point = algebra::fields::arithmetic_params<FieldType>::multiplicative_generator;
+        for (std::size_t i = 0; i < 3; i++) {
+            lpc_scheme_prover.append_to_batch(i, generate_random_polynomial_dfs_batch<FieldType>(
+                dist_type(1, 4)(test_global_rnd_engine), d, test_global_alg_rnd_engine<FieldType>));
+            lpc_scheme_prover.commit(i);
+            lpc_scheme_prover.append_eval_point(i, point);
+        }
+        BOOST_CHECK(!lpc_scheme_prover.has_partial_trees());
+        const lpc_scheme_type committed_scheme(lpc_scheme_prover);
+
+        std::array<std::uint8_t, 96> x_data{};
+        zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> transcript(x_data);
+        auto proof = lpc_scheme_prover.proof_eval(transcript);
+
+        // With few rows discarded only the queried paths are rebuilt, with all of them the whole trees are. Trees
+        // with discarded rows go through the spill file as well.
+        for (std::size_t rows_to_discard : {2, 64}) {
+            for (bool spill : {false, true}) {
+                lpc_scheme_type partial_scheme(committed_scheme);
+                partial_scheme.set_tree_tops(committed_scheme.get_tree_tops(rows_to_discard));
+                BOOST_CHECK(partial_scheme.has_partial_trees());
+                BOOST_CHECK(partial_scheme.get_tree_tops(rows_to_discard) ==
+                            committed_scheme.get_tree_tops(rows_to_discard));
+                if (spill) {
+                    partial_scheme.set_memory_budget(1, std::filesystem::temp_directory_path().string());
+                    BOOST_CHECK(partial_scheme.get_spilled_bytes() > 0);
+                    BOOST_CHECK(partial_scheme.has_partial_trees());
+                }
+
+                zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> partial_transcript(x_data);
+                BOOST_CHECK(partial_scheme.proof_eval(partial_transcript) == proof);
+            }
+        }
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(lpc_params_test_suite)
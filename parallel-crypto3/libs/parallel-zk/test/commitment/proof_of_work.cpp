@@ -35,6 +35,7 @@
 #include <nil/crypto3/hash/poseidon.hpp>
 #include <nil/crypto3/hash/detail/poseidon/poseidon_policy.hpp>
 #include <nil/crypto3/hash/keccak.hpp>
+#include <nil/crypto3/hash/sha2.hpp>
 
 #include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
 
@@ -95,4 +96,19 @@ BOOST_AUTO_TEST_SUITE(proof_of_knowledge_test_suite)
         BOOST_ASSERT(!hard_pow_type::verify(old_transcript_1, result, grinding_bits));
     }
 
+    BOOST_AUTO_TEST_CASE(pow_sha2_test) {
+        using sha2 = nil::crypto3::hashes::sha2<256>;
+        using pow_type = nil::crypto3::zk::commitments::proof_of_work<sha2, std::uint32_t>;
+
+        const std::size_t grinding_bits = 12;
+        nil::crypto3::zk::transcript::fiat_shamir_heuristic_sequential<sha2> transcript;
+        auto old_transcript = transcript;
+
+        auto result = pow_type::generate(transcript, grinding_bits);
+        BOOST_CHECK(pow_type::verify(old_transcript, result, grinding_bits));
+        // Both transcripts end up in the same state
+        BOOST_CHECK(transcript.template int_challenge<std::uint32_t>() ==
+                    old_transcript.template int_challenge<std::uint32_t>());
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -39,6 +39,7 @@
 #include <nil/crypto3/zk/math/expression.hpp>
 #include <nil/crypto3/zk/math/expression_visitors.hpp>
 #include <nil/crypto3/zk/math/expression_evaluator.hpp>
+#include <nil/crypto3/zk/math/expression_dag.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/variable.hpp>
 
 using namespace nil::crypto3;
@@ -158,4 +159,94 @@ BOOST_AUTO_TEST_CASE(expression_for_each_variable_visitor_test) {
         expected_rotations.begin(), expected_rotations.end());
 }
 
+BOOST_AUTO_TEST_CASE(expression_dag_interning_test) {
+
+    // setup
+    using curve_type = algebra::curves::pallas;
+    using FieldType = typename curve_type::base_field_type;
+    using variable_type = typename nil::crypto3::zk::snark::plonk_variable<typename FieldType::value_type>;
+
+    variable_type w0(0, 0, variable_type::column_type::witness);
+    variable_type w1(3, -1, variable_type::column_type::public_input);
+    variable_type w2(4, 1, variable_type::column_type::public_input);
+    variable_type w3(6, 2, variable_type::column_type::constant);
+
+    expression_dag<variable_type> dag;
+    auto a = (dag.variable(w0) + dag.variable(w1)) * (dag.variable(w2) + dag.variable(w3));
+    auto b = (dag.variable(w0) + dag.variable(w1)) * (dag.variable(w2) + dag.variable(w3));
+    BOOST_CHECK(a == b);
+
+    // zero, 4 variables, 2 sums and a product.
+    BOOST_CHECK_EQUAL(dag.size(), 8);
+
+    // (w0 + w1) * sum is reused, only w0 * w1, its product with sum and the outer sum are new.
+    expression<variable_type> sum = w2 + w3;
+    expression<variable_type> expr = (w0 + w1) * sum + w0 * w1 * sum;
+    auto c = dag.from_expression(expr);
+    BOOST_CHECK_EQUAL(dag.size(), 11);
+    BOOST_CHECK(dag.from_expression(expr) == c);
+    BOOST_CHECK_EQUAL(dag.size(), 11);
+}
+
+BOOST_AUTO_TEST_CASE(expression_dag_conversion_test) {
+
+    // setup
+    using curve_type = algebra::curves::pallas;
+    using FieldType = typename curve_type::base_field_type;
+    using variable_type = typename nil::crypto3::zk::snark::plonk_variable<typename FieldType::value_type>;
+
+    variable_type w0(0, 0, variable_type::column_type::witness);
+    variable_type w1(3, -1, variable_type::column_type::public_input);
+    variable_type w2(4, 1, variable_type::column_type::public_input);
+
+    expression<variable_type> expr = (w0 + w1).pow(3) * (w2 - w0) - w1 * w2 * 5u + (w0 + w1);
+
+    expression_dag<variable_type> dag;
+    BOOST_CHECK_EQUAL(dag.from_expression(expr).to_expression(), expr);
+
+    auto x = dag.variable(w0);
+    auto y = dag.variable(w1);
+    expression<variable_type> expected = (w0 - w1) * (w0 - w1) + w0;
+    BOOST_CHECK_EQUAL(((x - y) * (x - y) + x).to_expression(), expected);
+}
+
+BOOST_AUTO_TEST_CASE(expression_dag_evaluation_test) {
+
+    // setup
+    using curve_type = algebra::curves::pallas;
+    using FieldType = typename curve_type::base_field_type;
+    using variable_type = typename nil::crypto3::zk::snark::plonk_variable<typename FieldType::value_type>;
+    using value_type = variable_type::assignment_type;
+
+    variable_type w0(0, 0, variable_type::column_type::witness);
+    variable_type w1(3, -1, variable_type::column_type::public_input);
+    variable_type w2(4, 1, variable_type::column_type::public_input);
+
+    std::vector<expression<variable_type>> constraints = {
+        (w0 + w1) * (w0 + w1) - w2,
+        (w0 + w1).pow(2) * w2,
+        -(w0 + w1) * w0 * w1
+    };
+
+    std::unordered_map<variable_type, value_type> values = {{w0, 3u}, {w1, 5u}, {w2, 7u}};
+    auto get_value = [&values](const variable_type& var) -> const value_type& {
+        return values.at(var);
+    };
+
+    expression_dag<variable_type> dag;
+    std::vector<typename expression_dag<variable_type>::node_id> roots;
+    for (const auto& constraint : constraints) {
+        roots.push_back(dag.from_expression(constraint).get_id());
+    }
+    dag_expression_evaluator<variable_type> evaluator(dag, get_value);
+    auto results = evaluator.evaluate(roots);
+
+    BOOST_CHECK_EQUAL(results.size(), constraints.size());
+    for (std::size_t i = 0; i < constraints.size(); i++) {
+        expression_evaluator<variable_type> expected(constraints[i], get_value);
+        BOOST_CHECK(results[i] == expected.evaluate());
+    }
+    BOOST_CHECK(results[0] == value_type(64u - 7u));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
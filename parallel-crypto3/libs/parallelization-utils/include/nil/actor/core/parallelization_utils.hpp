@@ -47,7 +47,8 @@ namespace nil {
             }
         }
 
-        // Divides work into chunks and makes calls to 'func' in parallel.
+        // Divides work into chunks and makes calls to 'func' in parallel. thread_id is the index of the chunk,
+        // the same elements count gives the same chunks, which the pool keeps on the same workers if it can.
         template<class ReturnType>
         std::vector<std::future<ReturnType>> parallel_run_in_chunks_with_thread_id(
                 std::size_t elements_count,
@@ -56,7 +57,6 @@ namespace nil {
 
             auto& thread_pool = ThreadPool::get_instance(pool_id);
 
-            std::vector<std::future<ReturnType>> fut;
             std::size_t workers_to_use = std::max((size_t)1, std::min(elements_count, thread_pool.get_pool_size()));
 
             // For pool #0 we have experimentally found that operations over chunks of <4096 elements
@@ -70,15 +70,14 @@ namespace nil {
                 workers_to_use = std::max((size_t)1, workers_to_use);
             }
 
-            std::size_t begin = 0;
+            std::vector<std::size_t> bounds(workers_to_use + 1, 0);
             for (std::size_t i = 0; i < workers_to_use; i++) {
-                auto end = begin + (elements_count - begin) / (workers_to_use - i);
-                fut.emplace_back(thread_pool.post<ReturnType>([i, begin, end, func]() {
-                    return func(i, begin, end);
-                }));
-                begin = end;
+                bounds[i + 1] = bounds[i] + (elements_count - bounds[i]) / (workers_to_use - i);
             }
-            return fut;
+            return thread_pool.post_chunks<ReturnType>(workers_to_use,
+                [bounds = std::move(bounds), func](std::size_t i) {
+                    return func(i, bounds[i], bounds[i + 1]);
+                });
         }
 
         template<class ReturnType>
@@ -28,13 +28,24 @@
 #include <boost/asio/thread_pool.hpp>
 #include <boost/asio/post.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
 #include <functional>
 #include <future>
 #include <thread>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <type_traits>
+#include <vector>
 
+#include <nil/crypto3/bench/cpu_affinity.hpp>
+#include <nil/crypto3/container/huge_page_arena.hpp>
+#include <nil/crypto3/bench/tracer.hpp>
 
 namespace nil {
     namespace crypto3 {
@@ -51,12 +62,23 @@ namespace nil {
             /** Returns a thread pool, based on the pool_id. pool with LOW is normally used for low-level operations, like polynomial
              *  operations and fft. Any code that uses these operations and needs to be parallel will submit its tasks to pool with HIGH.
              *  Submission of higher level tasks to low level pool will immediately result in a deadlock.
+             *  pool_size only matters on the first call, 0 starts a worker per CPU selected by bench::cpu_affinity,
+             *  which has to be configured before that to pin the workers.
              */
-            static ThreadPool& get_instance(PoolLevel pool_id, std::size_t pool_size = std::thread::hardware_concurrency()) {
-                static ThreadPool instance_for_low_level(pool_size);
-                static ThreadPool instance_for_middle_level(pool_size);
-                static ThreadPool instance_for_high_level(pool_size);
-                
+            static ThreadPool& get_instance(PoolLevel pool_id, std::size_t pool_size = 0) {
+                if (pool_size == 0) {
+                    static const std::size_t default_pool_size = bench::cpu_affinity::instance().worker_count();
+                    pool_size = default_pool_size;
+                }
+                static ThreadPool instance_for_low_level(pool_size, "LOW pool");
+                static ThreadPool instance_for_middle_level(pool_size, "HIGH pool");
+                static ThreadPool instance_for_high_level(pool_size, "LASTPOOL pool");
+                static const bool first_touch_installed = [] {
+                    container::huge_page_arena::instance().set_first_touch(&ThreadPool::first_touch);
+                    return true;
+                }();
+                (void)first_touch_installed;
+
                 if (pool_id == PoolLevel::LOW)
                     return instance_for_low_level;
                 if (pool_id == PoolLevel::HIGH)
@@ -74,9 +96,57 @@ namespace nil {
             inline std::future<ReturnType> post(std::function<ReturnType()> task) {
                 auto packaged_task = std::make_shared<std::packaged_task<ReturnType()>>(std::move(task));
                 std::future<ReturnType> fut = packaged_task->get_future();
-                boost::asio::post(pool, [packaged_task]() -> void { (*packaged_task)(); });
+                post_traced([packaged_task]() {
+                    (*packaged_task)();
+                });
                 return fut;
             }
+
+            /** Runs task(chunk) for every chunk in [0, chunks), the future i holds the result of chunk i.
+             *  Every worker prefers the chunk at the same relative position, chunk w * chunks / pool_size for worker w,
+             *  and takes another one only if that is already taken. So successive passes with the same chunking, like
+             *  stages of an FFT over the same array, keep every part of the array on the same worker and, with pinned
+             *  workers, on the same socket as long as the pool has no other work.
+             */
+            template<class ReturnType>
+            std::vector<std::future<ReturnType>> post_chunks(std::size_t chunks,
+                                                             std::function<ReturnType(std::size_t chunk)> task) {
+                struct chunks_state {
+                    std::function<ReturnType(std::size_t)> task;
+                    std::vector<std::promise<ReturnType>> results;
+                    std::unique_ptr<std::atomic<bool>[]> taken;
+                };
+                auto state = std::make_shared<chunks_state>();
+                state->task = std::move(task);
+                state->results.resize(chunks);
+                state->taken.reset(new std::atomic<bool>[chunks]);
+
+                std::vector<std::future<ReturnType>> futures;
+                for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+                    state->taken[chunk] = false;
+                    futures.push_back(state->results[chunk].get_future());
+                }
+                for (std::size_t i = 0; i < chunks; ++i) {
+                    post_traced([this, state, chunks]() {
+                        // Every posted task takes exactly one chunk, so some chunk is always left.
+                        std::size_t chunk = std::min(current_worker() * chunks / pool_size, chunks - 1);
+                        while (state->taken[chunk].exchange(true)) {
+                            chunk = chunk + 1 == chunks ? 0 : chunk + 1;
+                        }
+                        try {
+                            if constexpr (std::is_void_v<ReturnType>) {
+                                state->task(chunk);
+                                state->results[chunk].set_value();
+                            } else {
+                                state->results[chunk].set_value(state->task(chunk));
+                            }
+                        } catch (...) {
+                            state->results[chunk].set_exception(std::current_exception());
+                        }
+                    });
+                }
+                return futures;
+            }
  
             // Waits for all the tasks to complete.
             inline void join() {
@@ -87,14 +157,96 @@ namespace nil {
                 return pool_size;
             }
 
+            // Pool of the calling thread, nullptr outside of pool threads.
+            static ThreadPool*& current() {
+                static thread_local ThreadPool* pool = nullptr;
+                return pool;
+            }
+
+            // Index of the calling thread among the workers of its pool, 0 outside of pool threads.
+            static std::size_t& current_worker() {
+                static thread_local std::size_t worker = 0;
+                return worker;
+            }
+
+            // First touch of fresh huge_page_arena blocks. Contiguous chunks of the block are faulted in by
+            // LOW pool workers, the same way parallel_for splits the work on it, so with first-touch NUMA
+            // placement the pages land on the nodes of the workers. Inside LOW pool tasks the calling thread
+            // touches the block itself, as waiting for the same pool could deadlock.
+            static void first_touch(void* p, std::uint64_t size) {
+                constexpr std::uint64_t page_size = 4096;
+                auto touch = [](volatile unsigned char* begin, std::uint64_t bytes) {
+                    for (std::uint64_t offset = 0; offset < bytes; offset += page_size) {
+                        begin[offset] = 0;
+                    }
+                };
+                auto* begin = static_cast<volatile unsigned char*>(p);
+
+                ThreadPool& low_pool = get_instance(PoolLevel::LOW);
+                if (current() == &low_pool || low_pool.get_pool_size() < 2) {
+                    touch(begin, size);
+                    return;
+                }
+                const std::uint64_t huge_page = container::huge_page_arena::huge_page_size;
+                const std::uint64_t chunk =
+                    ((size + low_pool.get_pool_size() - 1) / low_pool.get_pool_size() + huge_page - 1) / huge_page * huge_page;
+                auto futures = low_pool.post_chunks<void>((size + chunk - 1) / chunk, [touch, begin, chunk, size](std::size_t i) {
+                    touch(begin + i * chunk, std::min(chunk, size - i * chunk));
+                });
+                for (auto& future : futures) {
+                    future.get();
+                }
+            }
+
         private:
-            inline ThreadPool(std::size_t pool_size)
+            inline ThreadPool(std::size_t pool_size, const char* name)
                 : pool(pool_size)
-                , pool_size(pool_size)  {
+                , pool_size(pool_size)
+                , name(name) {
+                start_workers();
+            }
+
+            // Numbers the pool threads and pins them as bench::cpu_affinity says. Every thread gets exactly one
+            // of the start tasks, as none of them finishes before all have started.
+            void start_workers() {
+                std::mutex mutex;
+                std::condition_variable all_started;
+                std::size_t started = 0;
+                for (std::size_t worker = 0; worker < pool_size; ++worker) {
+                    boost::asio::post(pool, [this, worker, &mutex, &all_started, &started]() {
+                        current() = this;
+                        current_worker() = worker;
+                        const auto cpus = bench::cpu_affinity::instance().worker_cpus(worker);
+                        if (!cpus.empty()) {
+                            bench::cpu_affinity::set_current_thread_cpus(cpus);
+                        }
+                        std::unique_lock<std::mutex> lock(mutex);
+                        if (++started == pool_size) {
+                            all_started.notify_all();
+                        }
+                        all_started.wait(lock, [this, &started] { return started == pool_size; });
+                    });
+                }
+                std::unique_lock<std::mutex> lock(mutex);
+                all_started.wait(lock, [this, &started] { return started == pool_size; });
+            }
+
+            template<class Task>
+            void post_traced(Task&& task) {
+                boost::asio::post(pool, [task = std::forward<Task>(task), name = name]() mutable -> void {
+                    // Tasks are traced, so that idle pool threads show up as gaps in the trace
+                    if (bench::tracer::enabled()) {
+                        bench::tracer::instance().set_thread_name(name);
+                    }
+                    bench::trace_scope task_scope(name);
+                    task();
+                });
             }
 
             boost::asio::thread_pool pool;
             const std::size_t pool_size;
+            // Name of the pool threads and tasks in traces.
+            const char* const name;
 
         };
 
@@ -27,6 +27,10 @@
 
 #include <vector>
 #include <cstdint>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/test/data/test_case.hpp>
@@ -34,6 +38,11 @@
 
 #include <nil/actor/core/thread_pool.hpp>
 #include <nil/actor/core/parallelization_utils.hpp>
+#include <nil/crypto3/bench/cpu_affinity.hpp>
+#include <nil/crypto3/bench/memory_stats.hpp>
+#include <nil/crypto3/bench/memory_stats_new_delete.hpp>
+#include <nil/crypto3/bench/tracer.hpp>
+#include <nil/crypto3/container/huge_page_arena.hpp>
 
 
 BOOST_AUTO_TEST_SUITE(thread_pool_test_suite)
@@ -61,4 +70,231 @@ BOOST_AUTO_TEST_CASE(vector_multiplication_test) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(traced_tasks_test) {
+    auto& tracer = nil::crypto3::bench::tracer::instance();
+    tracer.enable();
+    {
+        TRACE_SCOPE("outer \"span\"")
+        nil::crypto3::wait_for_all(nil::crypto3::parallel_run_in_chunks<void>(
+            1024,
+            [](std::size_t begin, std::size_t end) {
+                TRACE_SCOPE("chunk")
+            }, nil::crypto3::ThreadPool::PoolLevel::LOW));
+    }
+    tracer.disable();
+    {
+        TRACE_SCOPE("not traced")
+    }
+
+    std::stringstream out;
+    tracer.write_chrome_trace(out);
+    const std::string trace = out.str();
+
+    BOOST_CHECK(trace.find("\"traceEvents\"") != std::string::npos);
+    BOOST_CHECK(trace.find("\"name\":\"outer \\\"span\\\"\"") != std::string::npos);
+    BOOST_CHECK(trace.find("\"name\":\"chunk\"") != std::string::npos);
+    BOOST_CHECK(trace.find("\"name\":\"LOW pool\"") != std::string::npos);
+    BOOST_CHECK(trace.find("\"thread_name\"") != std::string::npos);
+    BOOST_CHECK(trace.find("not traced") == std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(memory_stats_test) {
+    using nil::crypto3::bench::memory_scope;
+    using nil::crypto3::bench::memory_stats;
+
+    const std::int64_t chunk_bytes = 1 << 20;
+    auto& stats = memory_stats::instance();
+    stats.enable();
+    {
+        memory_scope outer("outer");
+        std::vector<std::uint8_t> held(4 * chunk_bytes);
+        {
+            memory_scope inner("inner");
+            nil::crypto3::wait_for_all(nil::crypto3::parallel_run_in_chunks<void>(
+                8,
+                [chunk_bytes](std::size_t begin, std::size_t end) {
+                    std::vector<std::uint8_t> temporary(chunk_bytes * (end - begin));
+                    temporary[0] = 1;
+                }, nil::crypto3::ThreadPool::PoolLevel::HIGH));
+        }
+    }
+    stats.disable();
+
+    const auto stages = stats.get_stages();
+#if defined(__GLIBC__)
+    BOOST_REQUIRE_EQUAL(stages.size(), 2);
+    BOOST_CHECK_EQUAL(stages[0].name, "inner");
+    BOOST_CHECK_EQUAL(stages[1].name, "outer");
+    // Inner stage starts with the held vector and peaks with at least one task chunk on top of it
+    BOOST_CHECK_GE(stages[0].live_bytes_before, 4 * chunk_bytes);
+    BOOST_CHECK_GE(stages[0].peak_live_bytes, 5 * chunk_bytes);
+    BOOST_CHECK_GE(stages[0].allocated_bytes, 8 * chunk_bytes);
+    // Outer peak includes the inner one
+    BOOST_CHECK_GE(stages[1].peak_live_bytes, stages[0].peak_live_bytes);
+    BOOST_CHECK_LT(stages[1].live_bytes_after, stages[1].live_bytes_before + chunk_bytes);
+
+    std::stringstream out;
+    stats.write_json_report(out);
+    BOOST_CHECK(out.str().find("\"name\": \"inner\"") != std::string::npos);
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(memory_stats_overlapping_scopes_test) {
+    using nil::crypto3::bench::memory_scope;
+    using nil::crypto3::bench::memory_stats;
+
+    const std::int64_t chunk_bytes = 1 << 20;
+    auto& stats = memory_stats::instance();
+    const std::size_t stages_before = stats.get_stages().size();
+    stats.enable();
+    std::optional<memory_scope> first;
+    std::optional<memory_scope> second;
+    first.emplace("first");
+    {
+        std::vector<std::uint8_t> temporary(4 * chunk_bytes);
+        temporary[0] = 1;
+    }
+    // Opened after the first peak and closed after the first scope, neither sees the other's peak
+    second.emplace("second");
+    first.reset();
+    {
+        std::vector<std::uint8_t> temporary(chunk_bytes);
+        temporary[0] = 1;
+    }
+    second.reset();
+    stats.disable();
+
+    const auto stages = stats.get_stages();
+#if defined(__GLIBC__)
+    BOOST_REQUIRE_EQUAL(stages.size(), stages_before + 2);
+    const auto& first_stage = stages[stages_before];
+    const auto& second_stage = stages[stages_before + 1];
+    BOOST_CHECK_EQUAL(first_stage.name, "first");
+    BOOST_CHECK_EQUAL(second_stage.name, "second");
+    BOOST_CHECK_GE(first_stage.peak_live_bytes, first_stage.live_bytes_before + 4 * chunk_bytes);
+    BOOST_CHECK_GE(second_stage.peak_live_bytes, second_stage.live_bytes_before + chunk_bytes);
+    BOOST_CHECK_LT(second_stage.peak_live_bytes, second_stage.live_bytes_before + 2 * chunk_bytes);
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(huge_page_arena_test) {
+    using nil::crypto3::container::huge_page_arena;
+
+    auto& arena = huge_page_arena::instance();
+    nil::crypto3::container::huge_page_arena_options options;
+    options.reserve_bytes = std::uint64_t(1) << 30;
+    options.max_cached_bytes = 6 * huge_page_arena::huge_page_size;
+    options.placement = nil::crypto3::container::numa_placement::first_touch;
+#if defined(__linux__) && defined(__GLIBC__)
+    BOOST_REQUIRE(arena.enable(options));
+    // Installs the first touch by LOW pool workers
+    nil::crypto3::ThreadPool::get_instance(nil::crypto3::ThreadPool::PoolLevel::LOW);
+
+    const std::size_t size = 3 * huge_page_arena::huge_page_size + 100;
+    const std::size_t half_size = 2 * huge_page_arena::huge_page_size;
+    const std::uint64_t allocations = arena.get_allocations();
+    const std::uint8_t* first;
+    {
+        std::vector<std::uint8_t> buffer(size, 1);
+        first = buffer.data();
+        BOOST_CHECK(arena.owns(first));
+        BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(first) % huge_page_arena::huge_page_size, 0);
+        BOOST_CHECK_EQUAL(arena.allocation_size(first), size);
+    }
+    BOOST_CHECK_GE(arena.get_cached_bytes(), size);
+    {
+        // Freed block of the same size class is handed out again
+        std::vector<std::uint64_t> buffer(size / 8);
+        BOOST_CHECK_EQUAL(static_cast<const void*>(buffer.data()), first);
+        BOOST_CHECK_EQUAL(buffer[size / 16], 0);
+    }
+    {
+        // Smaller requests split the freed block, which merges again once both halves are freed
+        std::vector<std::uint8_t> lower(half_size, 1);
+        std::vector<std::uint8_t> upper(half_size, 1);
+        BOOST_CHECK_EQUAL(static_cast<const void*>(lower.data()), first);
+        BOOST_CHECK_EQUAL(static_cast<const void*>(upper.data()), first + half_size);
+    }
+    {
+        std::vector<std::uint8_t> buffer(size);
+        BOOST_CHECK_EQUAL(static_cast<const void*>(buffer.data()), first);
+        // Freeing both blocks would exceed the cache limit, the second one is returned to the system
+        std::vector<std::uint8_t> other(size, 1);
+        BOOST_CHECK(arena.owns(other.data()));
+    }
+    BOOST_CHECK_LE(arena.get_cached_bytes(), options.max_cached_bytes);
+    BOOST_CHECK_GE(arena.get_cached_bytes(), size);
+    std::vector<std::uint8_t> small(1024);
+    BOOST_CHECK(!arena.owns(small.data()));
+    BOOST_CHECK_EQUAL(arena.get_allocations() - allocations, 6);
+    BOOST_CHECK_GE(arena.get_recycled_allocations(), 4);
+
+    arena.release_cached();
+    BOOST_CHECK_EQUAL(arena.get_cached_bytes(), 0);
+    arena.disable();
+    std::vector<std::uint8_t> after(size);
+    BOOST_CHECK(!arena.owns(after.data()));
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(cpu_affinity_test) {
+    using namespace nil::crypto3::bench;
+
+    BOOST_CHECK(parse_cpu_list("0-3,8,6-7") == std::vector<unsigned>({0, 1, 2, 3, 6, 7, 8}));
+    BOOST_CHECK(!parse_cpu_list("3-1"));
+    BOOST_CHECK(!parse_cpu_list("0,x"));
+
+    // Two sockets of two cores with two hardware threads each, siblings numbered as on most servers
+    std::vector<cpu_info> topology;
+    for (unsigned cpu = 0; cpu < 8; ++cpu) {
+        topology.push_back({cpu, (cpu / 2) % 2, cpu % 2, (cpu / 2) % 2});
+    }
+    cpu_affinity_options options;
+    BOOST_CHECK_EQUAL(cpu_affinity::select_worker_cpus(topology, options).size(), 8);
+    BOOST_CHECK(cpu_affinity::select_worker_cpus(topology, options)[0].empty());
+
+    options.pinning = thread_pinning::core;
+    options.skip_smt_siblings = true;
+    auto workers = cpu_affinity::select_worker_cpus(topology, options);
+    BOOST_REQUIRE_EQUAL(workers.size(), 4);
+    // Workers of the first socket come first
+    BOOST_CHECK(workers[0] == std::vector<unsigned>({0}));
+    BOOST_CHECK(workers[1] == std::vector<unsigned>({1}));
+    BOOST_CHECK(workers[2] == std::vector<unsigned>({2}));
+    BOOST_CHECK(workers[3] == std::vector<unsigned>({3}));
+
+    options.pinning = thread_pinning::socket;
+    options.skip_smt_siblings = false;
+    workers = cpu_affinity::select_worker_cpus(topology, options);
+    BOOST_REQUIRE_EQUAL(workers.size(), 8);
+    BOOST_CHECK(workers[0] == std::vector<unsigned>({0, 4, 1, 5}));
+    BOOST_CHECK(workers[7] == std::vector<unsigned>({2, 6, 3, 7}));
+
+    BOOST_CHECK_GE(cpu_affinity::read_topology().size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(sticky_chunks_test) {
+    using nil::crypto3::ThreadPool;
+
+    auto& pool = ThreadPool::get_instance(ThreadPool::PoolLevel::HIGH);
+    const std::size_t chunks = 3 * pool.get_pool_size() + 1;
+    auto results = nil::crypto3::wait_for_all(pool.post_chunks<std::size_t>(chunks, [&pool](std::size_t chunk) {
+        BOOST_CHECK(ThreadPool::current() == &pool);
+        BOOST_CHECK_LT(ThreadPool::current_worker(), pool.get_pool_size());
+        return chunk;
+    }));
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        BOOST_CHECK_EQUAL(results[chunk], chunk);
+    }
+
+    auto failed = pool.post_chunks<void>(2, [](std::size_t chunk) {
+        if (chunk == 1) {
+            throw std::runtime_error("chunk failed");
+        }
+    });
+    BOOST_CHECK_NO_THROW(failed[0].get());
+    BOOST_CHECK_THROW(failed[1].get(), std::runtime_error);
+    BOOST_CHECK(ThreadPool::current() == nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
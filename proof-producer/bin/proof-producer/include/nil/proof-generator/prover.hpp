@@ -22,10 +22,12 @@
 
 #include <fstream>
 #include <functional>
+#include <memory>
 #include <ostream>
 #include <random>
 #include <sstream>
 #include <optional>
+#include <typeinfo>
 
 #include <boost/log/trivial.hpp>
 
@@ -63,11 +65,13 @@
 #include <nil/blueprint/transpiler/recursive_verifier_generator.hpp>
 #include <nil/blueprint/transpiler/lpc_evm_verifier_gen.hpp>
 
+#include <nil/proof-generator/preset/circuit_cache.hpp>
 #include <nil/proof-generator/preset/preset.hpp>
 #include <nil/proof-generator/assigner/assigner.hpp>
 #include <nil/proof-generator/arithmetization_params.hpp>
 #include <nil/proof-generator/output_artifacts/assignment_table_writer.hpp>
 #include <nil/proof-generator/output_artifacts/circuit_writer.hpp>
+#include <nil/proof-generator/output_artifacts/mapped_assignment_table.hpp>
 #include <nil/proof-generator/output_artifacts/output_artifacts.hpp>
 #include <nil/proof-generator/file_operations.hpp>
 
@@ -76,19 +80,15 @@
 namespace nil {
     namespace proof_generator {
         namespace detail {
+            // Decodes the contents v of the file path.
             template<typename MarshallingType>
-            std::optional<MarshallingType> decode_marshalling_from_file(
-                const boost::filesystem::path& path,
-                bool hex = false
+            std::optional<MarshallingType> decode_marshalling(
+                const std::vector<std::uint8_t>& v,
+                const boost::filesystem::path& path
             ) {
-                const auto v = hex ? read_hex_file_to_vector(path.c_str()) : read_file_to_vector(path.c_str());
-                if (!v.has_value()) {
-                    return std::nullopt;
-                }
-
                 MarshallingType marshalled_data;
-                auto read_iter = v->begin();
-                auto status = marshalled_data.read(read_iter, v->size());
+                auto read_iter = v.begin();
+                auto status = marshalled_data.read(read_iter, v.size());
                 if (status != nil::crypto3::marshalling::status_type::success) {
                     BOOST_LOG_TRIVIAL(error) << "When reading a Marshalled structure from file "
                         << path << ", decoding step failed.";
@@ -97,6 +97,18 @@ namespace nil {
                 return marshalled_data;
             }
 
+            template<typename MarshallingType>
+            std::optional<MarshallingType> decode_marshalling_from_file(
+                const boost::filesystem::path& path,
+                bool hex = false
+            ) {
+                const auto v = hex ? read_hex_file_to_vector(path.c_str()) : read_file_to_vector(path.c_str());
+                if (!v.has_value()) {
+                    return std::nullopt;
+                }
+                return decode_marshalling<MarshallingType>(*v, path);
+            }
+
             template<typename MarshallingType>
             bool encode_marshalling_to_file(
                 const boost::filesystem::path& path,
@@ -128,7 +140,10 @@ namespace nil {
                 COMPUTE_COMBINED_Q = 9,
                 GENERATE_AGGREGATED_FRI_PROOF = 10,
                 GENERATE_CONSISTENCY_CHECKS_PROOF = 11,
-                MERGE_PROOFS = 12
+                MERGE_PROOFS = 12,
+                DAEMON = 13,
+                FUSED = 14,
+                MULTI_ASSIGNMENT = 15
             };
 
             ProverStage prover_stage_from_string(const std::string& stage) {
@@ -145,7 +160,10 @@ namespace nil {
                     {"compute-combined-Q", ProverStage::COMPUTE_COMBINED_Q},
                     {"merge-proofs", ProverStage::MERGE_PROOFS},
                     {"aggregated-FRI", ProverStage::GENERATE_AGGREGATED_FRI_PROOF},
-                    {"consistency-checks", ProverStage::GENERATE_CONSISTENCY_CHECKS_PROOF}
+                    {"consistency-checks", ProverStage::GENERATE_CONSISTENCY_CHECKS_PROOF},
+                    {"daemon", ProverStage::DAEMON},
+                    {"fused", ProverStage::FUSED},
+                    {"fill-assignment-multi", ProverStage::MULTI_ASSIGNMENT}
                 };
                 auto it = stage_map.find(stage);
                 if (it == stage_map.end()) {
@@ -197,6 +215,39 @@ namespace nil {
                 circuit_name_(circuit_name){
             }
 
+            // Committed polynomials and merkle trees above memory_budget bytes are kept in a spill file in
+            // spill_directory, see lpc_commitment_scheme::set_memory_budget. 0 keeps everything in memory.
+            void set_memory_budget(std::size_t memory_budget, const boost::filesystem::path& spill_directory) {
+                memory_budget_ = memory_budget;
+                spill_directory_ = spill_directory;
+                if (lpc_scheme_) {
+                    lpc_scheme_->set_memory_budget(memory_budget_, spill_directory_.string());
+                }
+            }
+
+            // Prover for one more proof over the same circuit and preprocessed data. The circuit and the public
+            // preprocessed data are shared with this prover. The commitment scheme, which the proof adds its batches
+            // to, is copied, and so is the preset table if with_preset_table is set, for the table to be filled
+            // from a trace.
+            Prover fork(bool with_preset_table) const {
+                Prover result(lambda_, expand_factor_, max_quotient_chunks_, grind_, circuit_name_);
+                result.memory_budget_ = memory_budget_;
+                result.spill_directory_ = spill_directory_;
+                result.public_preprocessed_data_ = public_preprocessed_data_;
+                result.constraint_system_ = constraint_system_;
+                if (common_data_) {
+                    result.common_data_.emplace(*common_data_);
+                }
+                if (lpc_scheme_) {
+                    result.lpc_scheme_.emplace(*lpc_scheme_);
+                }
+                if (with_preset_table && assignment_table_) {
+                    result.table_description_.emplace(*table_description_);
+                    result.assignment_table_.emplace(*assignment_table_);
+                }
+                return result;
+            }
+
             bool print_evm_verifier(
                 boost::filesystem::path output_folder
             ){
@@ -490,58 +541,99 @@ namespace nil {
                 if (!marshalled_value) {
                     return false;
                 }
-                public_preprocessed_data_.emplace(
+                public_preprocessed_data_ = std::make_shared<const PublicPreprocessedData>(
                     make_placeholder_preprocessed_public_data<Endianness, PublicPreprocessedData>(*marshalled_value)
                 );
                 return true;
             }
 
-            bool save_commitment_state_to_file(boost::filesystem::path commitment_scheme_state_file) {
+            // With compact_rows_to_discard set only the top rows of the merkle trees are written, see
+            // fill_compact_commitment_scheme. A scheme read from such state can be saved as compact state only.
+            bool save_commitment_state_to_file(
+                    boost::filesystem::path commitment_scheme_state_file,
+                    std::optional<std::size_t> compact_rows_to_discard = std::nullopt) {
                 using namespace nil::crypto3::marshalling::types;
 
-                BOOST_LOG_TRIVIAL(info) << "Writing commitment_state to " <<
-                    commitment_scheme_state_file;
+                BOOST_LOG_TRIVIAL(info) << "Writing " << (compact_rows_to_discard ? "compact " : "")
+                    << "commitment_state to " << commitment_scheme_state_file;
+                if (!compact_rows_to_discard && lpc_scheme_->has_partial_trees()) {
+                    BOOST_LOG_TRIVIAL(error) << "Commitment scheme was read from compact state, "
+                        "it can only be written as compact state";
+                    return false;
+                }
 
-                auto marshalled_lpc_state = fill_commitment_scheme<Endianness, LpcScheme>(
-                    *lpc_scheme_);
-                bool res = detail::encode_marshalling_to_file(
-                    commitment_scheme_state_file,
-                    marshalled_lpc_state
-                );
+                // The state is streamed one batch at a time, so spilled batches are not loaded back into memory.
+                auto file = open_file<std::ofstream>(
+                    commitment_scheme_state_file.string(), std::ios_base::out | std::ios_base::binary);
+                if (!file.has_value()) {
+                    return false;
+                }
+                std::ofstream& stream = file.value();
+
+                const nil::crypto3::marshalling::status_type status = compact_rows_to_discard
+                    ? write_compact_commitment_scheme<Endianness, LpcScheme>(
+                        *lpc_scheme_, *compact_rows_to_discard, stream)
+                    : write_commitment_scheme<Endianness, LpcScheme>(*lpc_scheme_, stream);
+                bool res = true;
+                if (status != nil::crypto3::marshalling::status_type::success) {
+                    BOOST_LOG_TRIVIAL(error) << "Marshalled structure encoding failed";
+                    res = false;
+                } else if (stream.fail()) {
+                    BOOST_LOG_TRIVIAL(error) << "Error occured during writing file " << commitment_scheme_state_file;
+                    res = false;
+                }
                 if (res) {
                     BOOST_LOG_TRIVIAL(info) << "Commitment scheme written.";
                 }
                 return res;
             }
 
+            // Both the full and the compact state are accepted, they are told apart by the tag of the latter.
             bool read_commitment_scheme_from_file(boost::filesystem::path commitment_scheme_state_file) {
-                BOOST_LOG_TRIVIAL(info) << "Read commitment scheme from " << commitment_scheme_state_file;
-
                 using namespace nil::crypto3::marshalling::types;
 
-                using CommitmentStateMarshalling = typename commitment_scheme_state<TTypeBase, LpcScheme>::type;
-
-                auto marshalled_value = detail::decode_marshalling_from_file<CommitmentStateMarshalling>(
-                    commitment_scheme_state_file);
-
-                if (!marshalled_value) {
+                const auto contents = read_file_to_vector(commitment_scheme_state_file.c_str());
+                if (!contents.has_value()) {
                     return false;
                 }
+                const bool compact =
+                    is_compact_commitment_scheme_state<Endianness>(contents->begin(), contents->size());
+                BOOST_LOG_TRIVIAL(info) << "Read " << (compact ? "compact " : "")
+                    << "commitment scheme from " << commitment_scheme_state_file;
+
+                std::optional<outcome::result<LpcScheme, nil::crypto3::marshalling::status_type>> commitment_scheme;
+                if (compact) {
+                    using CommitmentStateMarshalling = typename compact_commitment_scheme_state<TTypeBase, LpcScheme>::type;
+                    auto marshalled_value = detail::decode_marshalling<CommitmentStateMarshalling>(
+                        *contents, commitment_scheme_state_file);
+                    if (!marshalled_value) {
+                        return false;
+                    }
+                    commitment_scheme.emplace(make_compact_commitment_scheme<Endianness, LpcScheme>(*marshalled_value));
+                } else {
+                    using CommitmentStateMarshalling = typename commitment_scheme_state<TTypeBase, LpcScheme>::type;
+                    auto marshalled_value = detail::decode_marshalling<CommitmentStateMarshalling>(
+                        *contents, commitment_scheme_state_file);
+                    if (!marshalled_value) {
+                        return false;
+                    }
+                    commitment_scheme.emplace(make_commitment_scheme<Endianness, LpcScheme>(*marshalled_value));
+                }
 
-                auto commitment_scheme = make_commitment_scheme<Endianness, LpcScheme>(*marshalled_value);
-                if (!commitment_scheme) {
+                if (!*commitment_scheme) {
                     BOOST_LOG_TRIVIAL(error) << "Error decoding commitment scheme";
                     return false;
                 }
 
-                lpc_scheme_.emplace(std::move(commitment_scheme.value()));
+                lpc_scheme_.emplace(std::move(commitment_scheme->value()));
+                lpc_scheme_->set_memory_budget(memory_budget_, spill_directory_.string());
                 return true;
             }
 
             bool verify(const Proof& proof) {
                 BOOST_LOG_TRIVIAL(info) << "Verifying proof...";
                 bool verification_result = nil::crypto3::zk::snark::placeholder_verifier<BlueprintField, PlaceholderParams>::process(
-                        public_preprocessed_data_.has_value() ? public_preprocessed_data_->common_data : *common_data_,
+                        public_preprocessed_data_ ? public_preprocessed_data_->common_data : *common_data_,
                         proof,
                         *table_description_,
                         *constraint_system_,
@@ -568,7 +660,7 @@ namespace nil {
                 if (!marshalled_value) {
                     return false;
                 }
-                constraint_system_.emplace(
+                constraint_system_ = std::make_shared<const ConstraintSystem>(
                     nil::crypto3::marshalling::types::make_plonk_constraint_system<Endianness, ZkConstraintSystem>(
                         *marshalled_value
                     )
@@ -599,11 +691,15 @@ namespace nil {
             bool set_circuit(const ConstraintSystem& circuit) {
                 BOOST_LOG_TRIVIAL(info) << "Set circuit" << std::endl;
 
-                constraint_system_.emplace(std::move(circuit));
+                constraint_system_ = std::make_shared<const ConstraintSystem>(circuit);
                 return true;
             }
 
             bool read_assignment_table(const boost::filesystem::path& assignment_table_file_path) {
+                if (is_mapped_assignment_table(assignment_table_file_path.string())) {
+                    return read_mapped_assignment_table(assignment_table_file_path);
+                }
+
                 BOOST_LOG_TRIVIAL(info) << "Read assignment table from " << assignment_table_file_path;
 
                 auto marshalled_table =
@@ -623,6 +719,26 @@ namespace nil {
                 return true;
             }
 
+            // The table file is mapped and its columns are copied into the prover table as is, without
+            // going through marshalling.
+            bool read_mapped_assignment_table(const boost::filesystem::path& assignment_table_file_path) {
+                BOOST_LOG_TRIVIAL(info) << "Read mapped assignment table from " << assignment_table_file_path;
+                TIME_LOG_SCOPE("Read Mapped Assignment Table")
+
+                auto mapped_table = mapped_assignment_table<BlueprintField>::open(assignment_table_file_path.string());
+                if (!mapped_table) {
+                    BOOST_LOG_TRIVIAL(error) << "Can't read mapped assignment table: " << mapped_table.error();
+                    return false;
+                }
+
+                auto [table_description, assignment_table] = mapped_table->make_table();
+                table_description_.emplace(table_description);
+                assignment_table_.emplace(std::move(assignment_table));
+                public_inputs_.emplace(assignment_table_->public_inputs());
+
+                return true;
+            }
+
             bool set_assignment_table(const AssignmentTable& assignment_table, std::size_t used_rows_amount) {
                 BOOST_LOG_TRIVIAL(info) << "Set external assignment table" << std::endl;
 
@@ -637,10 +753,11 @@ namespace nil {
                 return true;
             }
 
-            bool save_binary_assignment_table_to_file(const boost::filesystem::path& output_filename) {
+            bool save_binary_assignment_table_to_file(const boost::filesystem::path& output_filename, bool mapped = false) {
                 using writer = assignment_table_writer<Endianness, BlueprintField>;
 
-                BOOST_LOG_TRIVIAL(info) << "Writing binary assignment table to " << output_filename;
+                BOOST_LOG_TRIVIAL(info) << "Writing " << (mapped ? "mapped" : "binary") << " assignment table to "
+                                        << output_filename;
 
                 if (!assignment_table_.has_value() || !table_description_.has_value()) {
                     BOOST_LOG_TRIVIAL(error) << "No assignment table is currently loaded";
@@ -653,9 +770,15 @@ namespace nil {
                     return false;
                 }
 
-                writer::write_binary_assignment(
-                    out, assignment_table_.value(), table_description_.value()
-                );
+                if (mapped) {
+                    writer::write_mapped_assignment(
+                        out, assignment_table_.value(), table_description_.value()
+                    );
+                } else {
+                    writer::write_binary_assignment(
+                        out, assignment_table_.value(), table_description_.value()
+                    );
+                }
 
                 return true;
             }
@@ -780,16 +903,35 @@ namespace nil {
                 std::size_t table_rows_log = std::ceil(std::log2(table_description_->rows_amount));
 
                 lpc_scheme_.emplace(FriParams(1, table_rows_log, lambda_, expand_factor_, grind_!=0, grind_));
+                lpc_scheme_->set_memory_budget(memory_budget_, spill_directory_.string());
             }
 
             bool preprocess_public_data() {
                 public_inputs_.emplace(assignment_table_->public_inputs());
 
+                std::optional<boost::filesystem::path> preprocessed_data_file, commitment_state_file;
+                if (circuit_cache_) {
+                    const auto parameters = preprocessing_parameters();
+                    preprocessed_data_file = circuit_cache_->entry_file("preprocessed_data", parameters);
+                    commitment_state_file = circuit_cache_->entry_file("commitment_state", parameters);
+                    if (boost::filesystem::exists(*preprocessed_data_file) &&
+                        boost::filesystem::exists(*commitment_state_file)) {
+                        TIME_LOG_SCOPE("Read Cached Preprocessed Public Data")
+                        if (read_public_preprocessed_data_from_file(*preprocessed_data_file) &&
+                            read_commitment_scheme_from_file(*commitment_state_file)) {
+                            // The public table is consumed by the preprocessor, drop it the same way
+                            assignment_table_->move_public_table();
+                            return true;
+                        }
+                        BOOST_LOG_TRIVIAL(warning) << "Can't read cached preprocessed data, preprocessing again";
+                    }
+                }
+
                 create_lpc_scheme();
 
                 BOOST_LOG_TRIVIAL(info) << "Preprocessing public data";
                 TIME_LOG_SCOPE("Preprocess Public Data")
-                public_preprocessed_data_.emplace(
+                public_preprocessed_data_ = std::make_shared<const PublicPreprocessedData>(
                     nil::crypto3::zk::snark::placeholder_public_preprocessor<BlueprintField, PlaceholderParams>::
                         process(
                             *constraint_system_,
@@ -799,6 +941,14 @@ namespace nil {
                             max_quotient_chunks_
                         )
                 );
+                if (preprocessed_data_file) {
+                    save_to_cache(*preprocessed_data_file, [this](const boost::filesystem::path& file) {
+                        return save_public_preprocessed_data_to_file(file);
+                    });
+                    save_to_cache(*commitment_state_file, [this](const boost::filesystem::path& file) {
+                        return save_commitment_state_to_file(file);
+                    });
+                }
                 return true;
             }
 
@@ -1127,19 +1277,39 @@ namespace nil {
                 return save_lpc_consistency_proof_to_file(proof, output_proof_file);
             }
 
-            bool setup_prover(const CircuitsLimits& circuits_limits) {
+            // With circuit_cache_dir set the circuit and the preset table are loaded from the cache if they were
+            // generated before with the same limits, otherwise they are generated and stored there.
+            // Preprocessed public data is cached in the same place, see preprocess_public_data.
+            bool setup_prover(const CircuitsLimits& circuits_limits,
+                              const boost::filesystem::path& circuit_cache_dir = {}) {
                 TIME_LOG_SCOPE("Preset")
-                const auto err = CircuitFactory<BlueprintField>::initialize_circuit(circuit_name_, constraint_system_, assignment_table_, table_description_, circuits_limits);
+                if (!circuit_cache_dir.empty()) {
+                    circuit_cache_.emplace(circuit_cache_dir, circuit_name_, circuits_limits);
+                    if (circuit_cache_->has_circuit()) {
+                        if (read_cached_circuit()) {
+                            return true;
+                        }
+                        BOOST_LOG_TRIVIAL(warning) << "Can't read cached circuit from " << circuit_cache_->directory()
+                                                   << ", generating it";
+                    }
+                }
+
+                std::optional<ConstraintSystem> constraint_system;
+                const auto err = CircuitFactory<BlueprintField>::initialize_circuit(circuit_name_, constraint_system, assignment_table_, table_description_, circuits_limits);
                 if (err) {
                     BOOST_LOG_TRIVIAL(error) << "Can't initialize circuit " << circuit_name_ << ": " << err.value();
                     return false;
                 }
+                constraint_system_ = std::make_shared<const ConstraintSystem>(std::move(*constraint_system));
+                if (circuit_cache_) {
+                    save_circuit_to_cache();
+                }
                 return true;
             }
 
             const ConstraintSystem& get_constraint_system() const {
                 BOOST_ASSERT(constraint_system_);
-                return constraint_system_.value();
+                return *constraint_system_;
             }
 
             const AssignmentTable& get_assignment_table() const {
@@ -1148,7 +1318,7 @@ namespace nil {
             }
 
             bool fill_assignment_table(const boost::filesystem::path& trace_base_path, const AssignerOptions& options) {
-                if (!constraint_system_.has_value()) {
+                if (!constraint_system_) {
                     BOOST_LOG_TRIVIAL(error) << "Circuit is not initialized";
                     return false;
                 }
@@ -1162,17 +1332,123 @@ namespace nil {
                     BOOST_LOG_TRIVIAL(error) << "Can't fill assignment table from trace " << trace_base_path << ": " << err.value();
                     return false;
                 }
+                public_inputs_.emplace(assignment_table_->public_inputs());
+                return true;
+            }
+
+            // Fills the table from traces read once for several circuits, see read_trace_set.
+            bool fill_assignment_table(const TraceSet& traces, const AssignerOptions& options) {
+                if (!constraint_system_) {
+                    BOOST_LOG_TRIVIAL(error) << "Circuit is not initialized";
+                    return false;
+                }
+                if (!assignment_table_.has_value()) {
+                    BOOST_LOG_TRIVIAL(error) << "Assignment table is not initialized";
+                    return false;
+                }
+                TIME_LOG_SCOPE("Fill Assignment Table (" + circuit_name_ + ")")
+                const auto err = fill_assignment_table_from_trace_set(*assignment_table_, *table_description_, circuit_name_, traces, options);
+                if (err) {
+                    BOOST_LOG_TRIVIAL(error) << "Can't fill " << circuit_name_ << " assignment table: " << err.value();
+                    return false;
+                }
+                public_inputs_.emplace(assignment_table_->public_inputs());
                 return true;
             }
 
         private:
+            bool read_cached_circuit() {
+                BOOST_LOG_TRIVIAL(info) << "Read cached circuit " << circuit_name_ << " from " << circuit_cache_->directory();
+                if (!read_circuit(circuit_cache_->circuit_file())) {
+                    return false;
+                }
+
+                auto marshalled_table =
+                    detail::decode_marshalling_from_file<TableMarshalling>(circuit_cache_->preset_table_file());
+                if (!marshalled_table) {
+                    return false;
+                }
+                auto [table_description, assignment_table] =
+                    nil::crypto3::marshalling::types::make_assignment_table<Endianness, AssignmentTable>(
+                        *marshalled_table
+                    );
+                assignment_table_.emplace(std::move(assignment_table));
+                // Same description as CircuitFactory::initialize_circuit sets, rows are counted by the assigner
+                table_description_.emplace(table_description.witness_columns, table_description.public_input_columns,
+                                           table_description.constant_columns, table_description.selector_columns);
+                return true;
+            }
+
+            void save_circuit_to_cache() {
+                // Marshalling pads every column to the longest one, which is what the assigner pads to anyway
+                if (assignment_table_->rows_amount() == 0) {
+                    return;
+                }
+                boost::system::error_code ec;
+                boost::filesystem::create_directories(circuit_cache_->directory(), ec);
+                if (ec) {
+                    BOOST_LOG_TRIVIAL(warning) << "Can't create circuit cache directory " << circuit_cache_->directory()
+                                               << ": " << ec.message();
+                    return;
+                }
+                // The table goes first, since the circuit file existence is checked by readers
+                save_to_cache(circuit_cache_->preset_table_file(), [this](const boost::filesystem::path& file) {
+                    auto marshalled_table =
+                        nil::crypto3::marshalling::types::fill_assignment_table<Endianness, AssignmentTable>(
+                            0, *assignment_table_);
+                    return detail::encode_marshalling_to_file(file, marshalled_table);
+                });
+                save_to_cache(circuit_cache_->circuit_file(), [this](const boost::filesystem::path& file) {
+                    return save_circuit_to_file(file);
+                });
+            }
+
+            // Cache write failures are not fatal, the entry is just generated again next time
+            template<typename Writer>
+            void save_to_cache(const boost::filesystem::path& file, Writer writer) {
+                const auto tmp_file = CircuitCache::temporary_file(file);
+                boost::system::error_code ec;
+                if (writer(tmp_file)) {
+                    boost::filesystem::rename(tmp_file, file, ec);
+                    if (!ec) {
+                        return;
+                    }
+                }
+                BOOST_LOG_TRIVIAL(warning) << "Can't store " << file << " in the circuit cache";
+                boost::filesystem::remove(tmp_file, ec);
+            }
+
+            // Everything besides the circuit the preprocessed public data depends on. Public inputs are part of the
+            // preprocessed public table, so their values are hashed into the key as well.
+            std::string preprocessing_parameters() const {
+                std::stringstream parameters;
+                parameters << typeid(PlaceholderParams).name()
+                           << " " << table_description_->usable_rows_amount
+                           << " " << table_description_->rows_amount
+                           << " " << lambda_
+                           << " " << expand_factor_
+                           << " " << grind_
+                           << " " << max_quotient_chunks_;
+                for (const auto& column : assignment_table_->public_inputs()) {
+                    parameters << " " << column.size();
+                    for (const auto& value : column) {
+                        parameters << " " << value;
+                    }
+                }
+                return parameters.str();
+            }
+
             const std::size_t expand_factor_;
             const std::size_t max_quotient_chunks_;
             const std::size_t lambda_;
             const std::size_t grind_;
             const std::string circuit_name_;
+            std::size_t memory_budget_ = 0;
+            boost::filesystem::path spill_directory_ = ".";
 
-            std::optional<PublicPreprocessedData> public_preprocessed_data_;
+            // The circuit and the public preprocessed data are never changed once set, copies of the prover
+            // share them, see fork.
+            std::shared_ptr<const PublicPreprocessedData> public_preprocessed_data_;
 
             // TODO: This is used in verifier, since it does not need the whole preprocessed data.
             // It makes sence to separate prover class from verifier later.
@@ -1181,9 +1457,10 @@ namespace nil {
             std::optional<PrivatePreprocessedData> private_preprocessed_data_;
             std::optional<typename AssignmentTable::public_input_container_type> public_inputs_;
             std::optional<TableDescription> table_description_;
-            std::optional<ConstraintSystem> constraint_system_;
+            std::shared_ptr<const ConstraintSystem> constraint_system_;
             std::optional<AssignmentTable> assignment_table_;
             std::optional<LpcScheme> lpc_scheme_;
+            std::optional<CircuitCache> circuit_cache_;
         };
 
     } // namespace proof_generator
@@ -0,0 +1,253 @@
+//---------------------------------------------------------------------------//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//---------------------------------------------------------------------------//
+
+#ifndef PROOF_GENERATOR_PROVER_DAEMON_HPP
+#define PROOF_GENERATOR_PROVER_DAEMON_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <expected>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/log/trivial.hpp>
+
+#include <nil/proof-generator/assigner/options.hpp>
+#include <nil/proof-generator/preset/limits.hpp>
+
+namespace nil {
+    namespace proof_generator {
+
+        /**
+         * Job accepted by the prover daemon, one per input line:
+         *
+         *   prove <job-id> <assignment-table-file> <proof-file> [<json-file>]
+         *   prove-trace <job-id> <trace-base-path> <proof-file> [<json-file>]
+         *   quit
+         *
+         * Every job gets exactly one response line on the output stream:
+         *
+         *   <job-id> ok proof=<proof-file> load_ms=<n> preprocess_ms=<n> prove_ms=<n> total_ms=<n>
+         *   <job-id> error <message>
+         */
+        struct DaemonJob {
+            enum class Input {
+                ASSIGNMENT_TABLE,
+                TRACE
+            };
+
+            std::string id;
+            Input input_type;
+            boost::filesystem::path input_path;
+            boost::filesystem::path proof_file_path;
+            boost::filesystem::path json_file_path;
+        };
+
+        namespace detail {
+            inline std::expected<DaemonJob, std::string> parse_daemon_job(const std::string& command,
+                                                                          std::istringstream& args) {
+                DaemonJob job;
+                if (command == "prove") {
+                    job.input_type = DaemonJob::Input::ASSIGNMENT_TABLE;
+                } else if (command == "prove-trace") {
+                    job.input_type = DaemonJob::Input::TRACE;
+                } else {
+                    return std::unexpected("unknown command " + command);
+                }
+
+                std::string input_path, proof_file_path, json_file_path;
+                if (!(args >> job.id >> input_path >> proof_file_path)) {
+                    return std::unexpected("usage: " + command + " <job-id> <input> <proof-file> [<json-file>]");
+                }
+                args >> json_file_path;
+
+                job.input_path = input_path;
+                job.proof_file_path = proof_file_path;
+                job.json_file_path = json_file_path.empty() ? job.proof_file_path.string() + ".json" : json_file_path;
+                return job;
+            }
+
+            inline std::size_t elapsed_ms(std::chrono::steady_clock::time_point start) {
+                return std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - start).count();
+            }
+        } // namespace detail
+
+        /**
+         * Long-running prover. The resident prover must already hold the circuit, the public preprocessed
+         * data and the commitment scheme state, and for prove-trace jobs the preset table as well. They are
+         * loaded once, every job shares the circuit and the preprocessed data and proves on its own copy of
+         * the commitment scheme, see Prover::fork, so that jobs never touch the disk for anything but their
+         * own input and output.
+         */
+        template<typename ProverType>
+        class ProverDaemon {
+        public:
+            ProverDaemon(const ProverType& resident_prover,
+                         const CircuitsLimits& circuits_limits,
+                         std::size_t jobs_amount,
+                         std::istream& in,
+                         std::ostream& out)
+                : resident_prover_(resident_prover),
+                  circuits_limits_(circuits_limits),
+                  jobs_amount_(std::max<std::size_t>(jobs_amount, 1)),
+                  in_(in),
+                  out_(out) {
+            }
+
+            // Serves jobs until the input is closed or "quit" is received, then waits for the running jobs.
+            bool run() {
+                BOOST_LOG_TRIVIAL(info) << "Prover daemon started, concurrent jobs: " << jobs_amount_;
+
+                std::vector<std::thread> workers;
+                for (std::size_t i = 0; i < jobs_amount_; ++i) {
+                    workers.emplace_back([this] { worker(); });
+                }
+
+                std::string line;
+                while (std::getline(in_, line)) {
+                    std::istringstream args(line);
+                    std::string command;
+                    if (!(args >> command)) {
+                        continue;
+                    }
+                    if (command == "quit") {
+                        break;
+                    }
+
+                    auto job = detail::parse_daemon_job(command, args);
+                    if (!job) {
+                        respond("- error " + job.error());
+                        continue;
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(queue_mutex_);
+                        queue_.push_back(std::move(job.value()));
+                    }
+                    queue_cv_.notify_one();
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(queue_mutex_);
+                    closed_ = true;
+                }
+                queue_cv_.notify_all();
+                for (auto& worker : workers) {
+                    worker.join();
+                }
+
+                BOOST_LOG_TRIVIAL(info) << "Prover daemon stopped, jobs failed: " << failed_jobs_;
+                return failed_jobs_ == 0;
+            }
+
+        private:
+            void worker() {
+                while (true) {
+                    DaemonJob job;
+                    {
+                        std::unique_lock<std::mutex> lock(queue_mutex_);
+                        queue_cv_.wait(lock, [this] { return closed_ || !queue_.empty(); });
+                        if (queue_.empty()) {
+                            return;
+                        }
+                        job = std::move(queue_.front());
+                        queue_.pop_front();
+                    }
+
+                    std::string response;
+                    try {
+                        response = process(job);
+                    } catch (const std::exception& e) {
+                        response = failed(e.what());
+                    }
+                    respond(job.id + " " + response);
+                }
+            }
+
+            std::string process(const DaemonJob& job) {
+                BOOST_LOG_TRIVIAL(info) << "Job " << job.id << ": proving " << job.input_path;
+                const auto job_start = std::chrono::steady_clock::now();
+
+                const bool from_trace = job.input_type == DaemonJob::Input::TRACE;
+                ProverType prover = resident_prover_.fork(from_trace);
+
+                auto stage_start = std::chrono::steady_clock::now();
+                bool loaded = from_trace
+                    ? prover.fill_assignment_table(job.input_path, AssignerOptions(false, circuits_limits_))
+                    : prover.read_assignment_table(job.input_path);
+                if (!loaded) {
+                    return failed("can't load input " + job.input_path.string());
+                }
+                const std::size_t load_ms = detail::elapsed_ms(stage_start);
+
+                stage_start = std::chrono::steady_clock::now();
+                if (!prover.preprocess_private_data()) {
+                    return failed("private preprocessing failed");
+                }
+                const std::size_t preprocess_ms = detail::elapsed_ms(stage_start);
+
+                stage_start = std::chrono::steady_clock::now();
+                if (!prover.generate_to_file(job.proof_file_path, job.json_file_path, true/*skip verification*/)) {
+                    return failed("proof generation failed");
+                }
+                const std::size_t prove_ms = detail::elapsed_ms(stage_start);
+
+                std::ostringstream response;
+                response << "ok proof=" << job.proof_file_path.string()
+                         << " load_ms=" << load_ms
+                         << " preprocess_ms=" << preprocess_ms
+                         << " prove_ms=" << prove_ms
+                         << " total_ms=" << detail::elapsed_ms(job_start);
+                return response.str();
+            }
+
+            std::string failed(const std::string& message) {
+                std::lock_guard<std::mutex> lock(out_mutex_);
+                ++failed_jobs_;
+                return "error " + message;
+            }
+
+            void respond(const std::string& response) {
+                std::lock_guard<std::mutex> lock(out_mutex_);
+                out_ << response << std::endl;
+            }
+
+            const ProverType& resident_prover_;
+            const CircuitsLimits circuits_limits_;
+            const std::size_t jobs_amount_;
+            std::istream& in_;
+            std::ostream& out_;
+
+            std::mutex queue_mutex_;
+            std::condition_variable queue_cv_;
+            std::deque<DaemonJob> queue_;
+            bool closed_ = false;
+
+            std::mutex out_mutex_;
+            std::size_t failed_jobs_ = 0;
+        };
+
+    } // namespace proof_generator
+} // namespace nil
+
+#endif // PROOF_GENERATOR_PROVER_DAEMON_HPP
@@ -87,19 +87,46 @@ namespace nil {
             // clang-format off
             auto options_appender = config.add_options()
                 ("stage", make_defaulted_option(prover_options.stage),
-                 "Stage of the prover to run, one of (all, preprocess, prove, verify, generate-aggregated-challenge, generate-combined-Q, aggregated-FRI, consistency-checks). Defaults to 'all'.")
+                 "Stage of the prover to run, one of (all, preprocess, prove, verify, generate-aggregated-challenge, generate-combined-Q, aggregated-FRI, consistency-checks, daemon, fused, fill-assignment-multi). Defaults to 'all'.")
                 ("proof,p", make_defaulted_option(prover_options.proof_file_path), "Proof file")
                 ("json,j", make_defaulted_option(prover_options.json_file_path), "JSON proof file")
                 ("common-data", make_defaulted_option(prover_options.preprocessed_common_data_path), "Preprocessed common data file")
                 ("preprocessed-data", make_defaulted_option(prover_options.preprocessed_public_data_path), "Preprocessed public data file")
                 ("commitment-state-file", make_defaulted_option(prover_options.commitment_scheme_state_path), "Commitment state data file")
                 ("updated-commitment-state-file", make_defaulted_option(prover_options.updated_commitment_scheme_state_path), "Updated commitment state data file")
+                ("compact-commitment-state", po::bool_switch(&prover_options.compact_commitment_state),
+                 "Write commitment state files without the bottom rows of merkle trees, the queried paths are rebuilt from the polynomials. Such files are recognized on reading.")
+                ("commitment-state-rows-to-discard", make_defaulted_option(prover_options.commitment_state_rows_to_discard),
+                 "Number of merkle tree rows above the leaves dropped from compact commitment state files (16)")
+                ("memory-budget-mb", make_defaulted_option(prover_options.memory_budget_mb),
+                 "Memory for committed polynomials and their merkle trees, in MB. The largest batches above it are moved to a spill file. 0 keeps everything in memory.")
+                ("spill-dir", make_defaulted_option(prover_options.spill_dir), "Directory of the spill file used with --memory-budget-mb")
                 ("trace", po::value(&prover_options.trace_base_path), "Base path for EVM trace files")
                 ("circuit", po::value(&prover_options.circuit_file_path), "Circuit input file")
                 ("circuit-name", po::value(&prover_options.circuit_name), "Target circuit name")
+                ("circuit-cache-dir", po::value(&prover_options.circuit_cache_dir),
+                 "Directory where generated circuits and preprocessed public data are cached between runs")
                 ("assignment-table,t", po::value(&prover_options.assignment_table_file_path), "Assignment table input file")
                 ("assignment-description-file", po::value(&prover_options.assignment_description_file_path), "Assignment description file")
+                ("mapped-assignment-table", po::bool_switch(&prover_options.mapped_assignment_table),
+                 "Write the assignment table in memory-mapped column-major format. Such tables are detected and mapped on read.")
                 ("log-level,l", make_defaulted_option(prover_options.log_level), "Log level (trace, debug, info, warning, error, fatal)")
+                ("trace-out", po::value(&prover_options.trace_out_path),
+                 "Record nested timing spans of all threads and write them to the given file in Chrome trace format")
+                ("memory-report", po::value(&prover_options.memory_report_path),
+                 "Record heap high-water marks of prover stages and write them to the given file as JSON")
+                ("huge-page-arena", po::bool_switch(&prover_options.huge_page_arena),
+                 "Serve large buffers from a pool of 2MB transparent huge pages reused across prover stages")
+                ("huge-page-cache-mb", make_defaulted_option(prover_options.huge_page_cache_mb),
+                 "Memory of freed huge page arena buffers kept for reuse, in MB. The rest is returned to the system. 0 keeps a quarter of the physical memory.")
+                ("numa-placement", make_defaulted_option(prover_options.numa_placement),
+                 "Placement of huge page arena memory on NUMA nodes (local, interleave, first-touch). With first-touch pages are faulted in by the thread pool workers.")
+                ("cpu-set", po::value(&prover_options.cpu_set),
+                 "Run on the given CPUs only, e.g. 0-15,32-47. Thread pools start a worker per CPU.")
+                ("thread-pinning", make_defaulted_option(prover_options.thread_pinning),
+                 "Pin thread pool workers to CPUs (none, core, socket)")
+                ("skip-smt", po::bool_switch(&prover_options.skip_smt_siblings),
+                 "Start thread pool workers on one hardware thread of every core only")
                 ("elliptic-curve-type,e", make_defaulted_option(prover_options.elliptic_curve_type), "Elliptic curve type (pallas)")
                 ("hash-type", make_defaulted_option(prover_options.hash_type), "Hash type (keccak, poseidon, sha256)")
                 ("lambda-param", make_defaulted_option(prover_options.lambda), "Lambda param (9)")
@@ -107,6 +134,14 @@ namespace nil {
                 ("expand-factor,x", make_defaulted_option(prover_options.expand_factor), "Expand factor")
                 ("max-quotient-chunks,q", make_defaulted_option(prover_options.max_quotient_chunks), "Maximum quotient polynomial parts amount")
                 ("evm-verifier", make_defaulted_option(prover_options.evm_verifier_path), "Output folder for EVM verifier")
+                ("daemon-jobs", make_defaulted_option(prover_options.daemon_jobs),
+                 "Number of jobs proved concurrently. Used with 'daemon' stage.")
+                ("fused-circuits", po::value<std::vector<std::string>>(&prover_options.fused_circuits)->multitoken(),
+                 "Circuits proved from the same trace, in order. Used with 'fused' stage, defaults to --circuit-name.")
+                ("overlap-assignment", po::bool_switch(&prover_options.overlap_assignment),
+                 "Fill the assignment table of the next circuit while proving the current one. Used with 'fused' stage.")
+                ("assignment-circuits", po::value<std::vector<std::string>>(&prover_options.assignment_circuits)->multitoken(),
+                 "Circuits filled concurrently from one trace set. Used with 'fill-assignment-multi' stage, defaults to all circuits.")
                 ("input-challenge-files,u", po::value<std::vector<boost::filesystem::path>>(&prover_options.input_challenge_files)->multitoken(),
                  "Input challenge files. Used with 'generate-aggregated-challenge' stage.")
                 ("challenge-file", po::value<boost::filesystem::path>(&prover_options.challenge_file_path),
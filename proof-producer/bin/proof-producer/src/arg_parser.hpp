@@ -19,6 +19,7 @@
 
 #include <optional>
 #include <string>
+#include <vector>
 
 #include <boost/filesystem/path.hpp>
 #include <boost/log/trivial.hpp>
@@ -45,10 +46,24 @@ namespace nil {
             boost::filesystem::path preprocessed_public_data_path = "preprocessed_data.dat";
             boost::filesystem::path commitment_scheme_state_path = "commitment_scheme_state.dat";
             boost::filesystem::path updated_commitment_scheme_state_path = "updated_commitment_scheme_state.dat";
+            bool compact_commitment_state = false;
+            std::size_t commitment_state_rows_to_discard = 16;
+            std::size_t memory_budget_mb = 0;
+            boost::filesystem::path spill_dir = ".";
             boost::filesystem::path trace_base_path;
             boost::filesystem::path circuit_file_path;
+            boost::filesystem::path circuit_cache_dir;
+            boost::filesystem::path trace_out_path;
+            boost::filesystem::path memory_report_path;
+            bool huge_page_arena = false;
+            std::size_t huge_page_cache_mb = 0;
+            std::string numa_placement = "local";
+            std::string cpu_set;
+            std::string thread_pinning = "none";
+            bool skip_smt_siblings = false;
             boost::filesystem::path assignment_table_file_path;
             boost::filesystem::path assignment_description_file_path;
+            bool mapped_assignment_table = false;
             boost::filesystem::path challenge_file_path;
             boost::filesystem::path theta_power_file_path;
             boost::filesystem::path evm_verifier_path;
@@ -72,6 +87,10 @@ namespace nil {
             std::size_t grind = 0;
             std::size_t expand_factor = 2;
             std::size_t max_quotient_chunks = 0;
+            std::size_t daemon_jobs = 1;
+            std::vector<std::string> fused_circuits;
+            bool overlap_assignment = false;
+            std::vector<std::string> assignment_circuits;
 
             CircuitsLimits circuits_limits;
         };
@@ -17,18 +17,149 @@
 // limitations under the License.
 //---------------------------------------------------------------------------//
 
+#include <future>
 #include <iostream>
 #include <optional>
+#include <string>
 #include <utility>
+#include <vector>
+
+#include <nil/crypto3/bench/cpu_affinity.hpp>
+#include <nil/crypto3/bench/memory_stats.hpp>
+#include <nil/crypto3/bench/memory_stats_new_delete.hpp>
+#include <nil/crypto3/bench/tracer.hpp>
+#include <nil/crypto3/container/huge_page_arena.hpp>
 
 #include <arg_parser.hpp>
 #include <nil/proof-generator/file_operations.hpp>
 #include <nil/proof-generator/prover.hpp>
+#include <nil/proof-generator/prover_daemon.hpp>
 
 #undef B0
 
 using namespace nil::proof_generator;
 
+// Runs preset, assignment, preprocessing and proving for every requested circuit in one process, all
+// artifacts stay in memory. With overlap enabled, the assignment table of the next circuit is filled
+// while the current one is being proved.
+template<typename CurveType, typename HashType>
+bool run_fused_pipeline(const nil::proof_generator::ProverOptions& prover_options) {
+    using ProverType = nil::proof_generator::Prover<CurveType, HashType>;
+
+    const std::vector<std::string> circuit_names = prover_options.fused_circuits.empty()
+        ? std::vector<std::string>{prover_options.circuit_name}
+        : prover_options.fused_circuits;
+
+    auto assign = [&prover_options](const std::string& circuit_name) -> std::optional<ProverType> {
+        ProverType prover(
+            prover_options.lambda,
+            prover_options.expand_factor,
+            prover_options.max_quotient_chunks,
+            prover_options.grind,
+            circuit_name
+        );
+        prover.set_memory_budget(prover_options.memory_budget_mb << 20, prover_options.spill_dir);
+        if (!prover.setup_prover(prover_options.circuits_limits, prover_options.circuit_cache_dir) ||
+            !prover.fill_assignment_table(prover_options.trace_base_path,
+                                          AssignerOptions(false, prover_options.circuits_limits))) {
+            return std::nullopt;
+        }
+        return prover;
+    };
+
+    // With several circuits every proof gets the circuit name as a prefix.
+    auto output_path = [&circuit_names](const boost::filesystem::path& path, const std::string& circuit_name) {
+        if (circuit_names.size() == 1) {
+            return path;
+        }
+        return path.parent_path() / (circuit_name + "_" + path.filename().string());
+    };
+
+    const auto next_policy = prover_options.overlap_assignment ? std::launch::async : std::launch::deferred;
+    std::future<std::optional<ProverType>> next_assigned = std::async(std::launch::deferred, assign, circuit_names[0]);
+    for (std::size_t i = 0; i < circuit_names.size(); ++i) {
+        std::optional<ProverType> prover = next_assigned.get();
+        if (i + 1 < circuit_names.size()) {
+            next_assigned = std::async(next_policy, assign, circuit_names[i + 1]);
+        }
+
+        bool prover_result =
+            prover.has_value() &&
+            prover->preprocess_public_data() &&
+            prover->preprocess_private_data() &&
+            prover->generate_to_file(
+                output_path(prover_options.proof_file_path, circuit_names[i]),
+                output_path(prover_options.json_file_path, circuit_names[i]),
+                true/*skip verification*/);
+        if (!prover_result) {
+            BOOST_LOG_TRIVIAL(error) << "Fused pipeline failed on circuit " << circuit_names[i];
+            return false;
+        }
+    }
+    return true;
+}
+
+// Reads the trace set once and fills the assignment tables of all requested circuits concurrently, one
+// thread per circuit. Each table and its description are saved with the circuit name as a file name prefix.
+template<typename CurveType, typename HashType>
+bool run_multi_assignment(const nil::proof_generator::ProverOptions& prover_options) {
+    using ProverType = nil::proof_generator::Prover<CurveType, HashType>;
+
+    const std::vector<std::string> circuit_names = prover_options.assignment_circuits.empty()
+        ? std::vector<std::string>{circuits::BYTECODE, circuits::RW, circuits::ZKEVM, circuits::COPY, circuits::EXP}
+        : prover_options.assignment_circuits;
+    const AssignerOptions assigner_options(false, prover_options.circuits_limits);
+
+    TraceSet traces;
+    {
+        TIME_LOG_SCOPE("Read Trace Set")
+        const auto err = read_trace_set(prover_options.trace_base_path, assigner_options, traces);
+        if (err) {
+            BOOST_LOG_TRIVIAL(error) << "Can't read traces " << prover_options.trace_base_path << ": " << err.value();
+            return false;
+        }
+    }
+
+    auto output_path = [](const boost::filesystem::path& path, const std::string& circuit_name) {
+        return path.parent_path() / (circuit_name + "_" + path.filename().string());
+    };
+
+    auto assign = [&](const std::string& circuit_name) -> bool {
+        ProverType prover(
+            prover_options.lambda,
+            prover_options.expand_factor,
+            prover_options.max_quotient_chunks,
+            prover_options.grind,
+            circuit_name
+        );
+        bool result = prover.setup_prover(prover_options.circuits_limits, prover_options.circuit_cache_dir) &&
+                      prover.fill_assignment_table(traces, assigner_options);
+        if (!prover_options.assignment_table_file_path.empty() && result) {
+            result = prover.save_binary_assignment_table_to_file(
+                output_path(prover_options.assignment_table_file_path, circuit_name),
+                prover_options.mapped_assignment_table);
+        }
+        if (!prover_options.assignment_description_file_path.empty() && result) {
+            result = prover.save_assignment_description(
+                output_path(prover_options.assignment_description_file_path, circuit_name));
+        }
+        if (!result) {
+            BOOST_LOG_TRIVIAL(error) << "Multi-circuit assignment failed on circuit " << circuit_name;
+        }
+        return result;
+    };
+
+    std::vector<std::future<bool>> results;
+    for (const auto& circuit_name : circuit_names) {
+        results.push_back(std::async(std::launch::async, assign, circuit_name));
+    }
+    bool all_assigned = true;
+    for (auto& result : results) {
+        all_assigned = result.get() && all_assigned;
+    }
+    return all_assigned;
+}
+
 template<typename CurveType, typename HashType>
 int run_prover(const nil::proof_generator::ProverOptions& prover_options) {
     auto prover_task = [&] {
@@ -39,6 +170,10 @@ int run_prover(const nil::proof_generator::ProverOptions& prover_options) {
             prover_options.grind,
             prover_options.circuit_name
         );
+        prover.set_memory_budget(prover_options.memory_budget_mb << 20, prover_options.spill_dir);
+        const std::optional<std::size_t> compact_state_rows_to_discard = prover_options.compact_commitment_state
+            ? std::make_optional(prover_options.commitment_state_rows_to_discard)
+            : std::nullopt;
         bool prover_result;
         try {
             switch (nil::proof_generator::detail::prover_stage_from_string(prover_options.stage)) {
@@ -56,27 +191,30 @@ int run_prover(const nil::proof_generator::ProverOptions& prover_options) {
                             false/*don't skip verification*/) &&
                         prover.save_preprocessed_common_data_to_file(prover_options.preprocessed_common_data_path) &&
                         prover.save_public_preprocessed_data_to_file(prover_options.preprocessed_public_data_path) &&
-                        prover.save_commitment_state_to_file(prover_options.commitment_scheme_state_path) &&
+                        prover.save_commitment_state_to_file(
+                            prover_options.commitment_scheme_state_path, compact_state_rows_to_discard) &&
                         prover.print_evm_verifier(prover_options.evm_verifier_path);
                     break;
                 case nil::proof_generator::detail::ProverStage::PRESET:
-                    prover_result = prover.setup_prover(prover_options.circuits_limits);
+                    prover_result = prover.setup_prover(prover_options.circuits_limits, prover_options.circuit_cache_dir);
                     if (!prover_options.circuit_file_path.empty() && prover_result) {
                         prover_result = prover.save_circuit_to_file(prover_options.circuit_file_path);
                     }
                     if (!prover_options.assignment_table_file_path.empty() && prover_result) {
-                        prover_result = prover.save_binary_assignment_table_to_file(prover_options.assignment_table_file_path);
+                        prover_result = prover.save_binary_assignment_table_to_file(
+                            prover_options.assignment_table_file_path, prover_options.mapped_assignment_table);
                     }
                     if (prover_result) {
                         prover_result = prover.print_debug_assignment_table(prover_options.output_artifacts);
                     }
                     break;
                 case nil::proof_generator::detail::ProverStage::ASSIGNMENT:
-                    prover_result = prover.setup_prover(prover_options.circuits_limits) &&
+                    prover_result = prover.setup_prover(prover_options.circuits_limits, prover_options.circuit_cache_dir) &&
                     prover.fill_assignment_table(prover_options.trace_base_path,
                                                  AssignerOptions(false, prover_options.circuits_limits));
                     if (!prover_options.assignment_table_file_path.empty() && prover_result) {
-                        prover_result = prover.save_binary_assignment_table_to_file(prover_options.assignment_table_file_path);
+                        prover_result = prover.save_binary_assignment_table_to_file(
+                            prover_options.assignment_table_file_path, prover_options.mapped_assignment_table);
                     }
                     if (!prover_options.assignment_description_file_path.empty() && prover_result) {
                         prover_result = prover.save_assignment_description(prover_options.assignment_description_file_path);
@@ -91,7 +229,8 @@ int run_prover(const nil::proof_generator::ProverOptions& prover_options) {
                         prover.preprocess_public_data() &&
                         prover.save_preprocessed_common_data_to_file(prover_options.preprocessed_common_data_path) &&
                         prover.save_public_preprocessed_data_to_file(prover_options.preprocessed_public_data_path) &&
-                        prover.save_commitment_state_to_file(prover_options.commitment_scheme_state_path)&&
+                        prover.save_commitment_state_to_file(
+                            prover_options.commitment_scheme_state_path, compact_state_rows_to_discard)&&
                         prover.save_assignment_description(prover_options.assignment_description_file_path) &&
                         prover.print_evm_verifier(prover_options.evm_verifier_path);
                     break;
@@ -103,7 +242,8 @@ int run_prover(const nil::proof_generator::ProverOptions& prover_options) {
                         prover.print_debug_assignment_table(prover_options.output_artifacts) &&
                         prover.print_public_input_for_evm(prover_options.evm_verifier_path) &&
                         prover.read_public_preprocessed_data_from_file(prover_options.preprocessed_public_data_path) &&
-                        prover.read_commitment_scheme_from_file(prover_options.commitment_scheme_state_path) &&
+                        prover.read_commitment_scheme_from_file(
+                            prover_options.commitment_scheme_state_path) &&
                         prover.preprocess_private_data() &&
                         prover.generate_to_file(
                             prover_options.proof_file_path,
@@ -119,18 +259,20 @@ int run_prover(const nil::proof_generator::ProverOptions& prover_options) {
                         prover.print_debug_assignment_table(prover_options.output_artifacts) &&
                         prover.read_public_preprocessed_data_from_file(prover_options.preprocessed_public_data_path) &&
                         prover.read_preprocessed_common_data_from_file(prover_options.preprocessed_common_data_path) &&
-                        prover.read_commitment_scheme_from_file(prover_options.commitment_scheme_state_path) &&
+                        prover.read_commitment_scheme_from_file(
+                            prover_options.commitment_scheme_state_path) &&
                         prover.preprocess_private_data() &&
                         prover.generate_partial_proof_to_file(
                             prover_options.proof_file_path,
                             prover_options.challenge_file_path,
                             prover_options.theta_power_file_path) &&
-                        prover.save_commitment_state_to_file(prover_options.updated_commitment_scheme_state_path);
+                        prover.save_commitment_state_to_file(
+                            prover_options.updated_commitment_scheme_state_path, compact_state_rows_to_discard);
                     break;
                 case nil::proof_generator::detail::ProverStage::FAST_GENERATE_PARTIAL_PROOF:
                     // Preset, fill assignment table, preprocess
                     prover_result =
-                        prover.setup_prover(prover_options.circuits_limits) &&
+                        prover.setup_prover(prover_options.circuits_limits, prover_options.circuit_cache_dir) &&
                         prover.fill_assignment_table(prover_options.trace_base_path,
                                                      AssignerOptions(false, prover_options.circuits_limits)) &&
                         prover.save_assignment_description(prover_options.assignment_description_file_path) &&
@@ -141,7 +283,8 @@ int run_prover(const nil::proof_generator::ProverOptions& prover_options) {
                             prover_options.proof_file_path,
                             prover_options.challenge_file_path,
                             prover_options.theta_power_file_path) &&
-                        prover.save_commitment_state_to_file(prover_options.updated_commitment_scheme_state_path);
+                        prover.save_commitment_state_to_file(
+                            prover_options.updated_commitment_scheme_state_path, compact_state_rows_to_discard);
                     break;
                 case nil::proof_generator::detail::ProverStage::VERIFY:
                     prover_result =
@@ -167,7 +310,8 @@ int run_prover(const nil::proof_generator::ProverOptions& prover_options) {
                     break;
                 case nil::proof_generator::detail::ProverStage::COMPUTE_COMBINED_Q:
                     prover_result =
-                        prover.read_commitment_scheme_from_file(prover_options.commitment_scheme_state_path) &&
+                        prover.read_commitment_scheme_from_file(
+                            prover_options.commitment_scheme_state_path) &&
                         prover.generate_combined_Q_to_file(
                             prover_options.aggregated_challenge_file, prover_options.combined_Q_starting_power,
                             prover_options.combined_Q_polynomial_file);
@@ -184,13 +328,37 @@ int run_prover(const nil::proof_generator::ProverOptions& prover_options) {
                     break;
                 case nil::proof_generator::detail::ProverStage::GENERATE_CONSISTENCY_CHECKS_PROOF:
                     prover_result =
-                        prover.read_commitment_scheme_from_file(prover_options.commitment_scheme_state_path) &&
+                        prover.read_commitment_scheme_from_file(
+                            prover_options.commitment_scheme_state_path) &&
                         prover.generate_consistency_checks_to_file(
                             prover_options.combined_Q_polynomial_file,
                             prover_options.consistency_checks_challenges_file,
                             prover_options.proof_file_path
                             );
                     break;
+                case nil::proof_generator::detail::ProverStage::FUSED:
+                    prover_result = run_fused_pipeline<CurveType, HashType>(prover_options);
+                    break;
+                case nil::proof_generator::detail::ProverStage::MULTI_ASSIGNMENT:
+                    prover_result = run_multi_assignment<CurveType, HashType>(prover_options);
+                    break;
+                case nil::proof_generator::detail::ProverStage::DAEMON:
+                    // Load the circuit and preprocessed data once, then prove jobs read from stdin. With a circuit
+                    // name the circuit is generated together with the preset table prove-trace jobs start from.
+                    prover_result =
+                        (prover_options.circuit_name.empty()
+                            ? prover.read_circuit(prover_options.circuit_file_path)
+                            : prover.setup_prover(prover_options.circuits_limits, prover_options.circuit_cache_dir)) &&
+                        prover.read_public_preprocessed_data_from_file(prover_options.preprocessed_public_data_path) &&
+                        prover.read_commitment_scheme_from_file(
+                            prover_options.commitment_scheme_state_path) &&
+                        ProverDaemon<decltype(prover)>(
+                            prover,
+                            prover_options.circuits_limits,
+                            prover_options.daemon_jobs,
+                            std::cin,
+                            std::cout).run();
+                    break;
             }
         } catch (const std::exception& e) {
             BOOST_LOG_TRIVIAL(error) << e.what();
@@ -236,5 +404,86 @@ int main(int argc, char* argv[]) {
         // Action has already taken a place (help, version, etc.)
         return 0;
     }
-    return initial_wrapper(*prover_options);
+    using nil::crypto3::container::huge_page_arena;
+    using nil::crypto3::bench::memory_stats;
+    using nil::crypto3::bench::tracer;
+
+    {
+        // Before any thread pool is started, workers are placed when the pools are created
+        nil::crypto3::bench::cpu_affinity_options affinity_options;
+        const auto pinning = nil::crypto3::bench::parse_thread_pinning(prover_options->thread_pinning);
+        if (!pinning) {
+            BOOST_LOG_TRIVIAL(error) << "Unknown thread pinning " << prover_options->thread_pinning;
+            return 1;
+        }
+        affinity_options.pinning = *pinning;
+        affinity_options.skip_smt_siblings = prover_options->skip_smt_siblings;
+        if (!prover_options->cpu_set.empty()) {
+            const auto cpus = nil::crypto3::bench::parse_cpu_list(prover_options->cpu_set);
+            if (!cpus || cpus->empty()) {
+                BOOST_LOG_TRIVIAL(error) << "Invalid CPU set " << prover_options->cpu_set;
+                return 1;
+            }
+            affinity_options.cpu_set = *cpus;
+        }
+        if (!nil::crypto3::bench::cpu_affinity::instance().configure(affinity_options)) {
+            BOOST_LOG_TRIVIAL(error) << "Can't restrict the prover to CPU set " << prover_options->cpu_set;
+            return 1;
+        }
+    }
+
+    if (prover_options->huge_page_arena) {
+        nil::crypto3::container::huge_page_arena_options arena_options;
+        const auto placement = nil::crypto3::container::parse_numa_placement(prover_options->numa_placement);
+        if (!placement) {
+            BOOST_LOG_TRIVIAL(error) << "Unknown NUMA placement " << prover_options->numa_placement;
+            return 1;
+        }
+        arena_options.placement = *placement;
+        arena_options.numa_nodes = nil::crypto3::bench::read_cpu_list("/sys/devices/system/node/online")
+                                       .value_or(std::vector<unsigned>());
+        arena_options.max_cached_bytes = std::uint64_t(prover_options->huge_page_cache_mb) << 20;
+        if (!huge_page_arena::instance().enable(arena_options)) {
+            BOOST_LOG_TRIVIAL(warning) << "Can't reserve huge page arena, large buffers stay on the heap";
+        }
+    }
+
+    if (!prover_options->trace_out_path.empty()) {
+        // Open in chrome://tracing or ui.perfetto.dev
+        tracer::instance().enable();
+        tracer::instance().set_thread_name("main");
+    }
+    if (!prover_options->memory_report_path.empty()) {
+        memory_stats::instance().enable();
+    }
+
+    int ret = initial_wrapper(*prover_options);
+
+    if (!prover_options->trace_out_path.empty()) {
+        tracer::instance().disable();
+        if (!tracer::instance().write_chrome_trace(prover_options->trace_out_path.string())) {
+            BOOST_LOG_TRIVIAL(error) << "Can't write trace to " << prover_options->trace_out_path;
+            ret = ret == 0 ? 1 : ret;
+        }
+    }
+    if (!prover_options->memory_report_path.empty()) {
+        memory_stats::instance().disable();
+        BOOST_LOG_TRIVIAL(info) << "Peak heap " << memory_stats::instance().get_peak_live_bytes() / (1024 * 1024)
+                                << " MiB, peak RSS " << memory_stats::peak_rss_bytes() / (1024 * 1024) << " MiB";
+        if (!memory_stats::instance().write_json_report(prover_options->memory_report_path.string())) {
+            BOOST_LOG_TRIVIAL(error) << "Can't write memory report to " << prover_options->memory_report_path;
+            ret = ret == 0 ? 1 : ret;
+        }
+    }
+    if (huge_page_arena::enabled()) {
+        BOOST_LOG_TRIVIAL(info) << "Huge page arena: " << huge_page_arena::instance().get_allocations()
+                                << " allocations, " << huge_page_arena::instance().get_recycled_allocations()
+                                << " of them recycled, "
+                                << huge_page_arena::instance().get_used_address_bytes() / (1024 * 1024)
+                                << " MiB of address space used, "
+                                << huge_page_arena::instance().get_cached_bytes() / (1024 * 1024) << " of "
+                                << huge_page_arena::instance().get_max_cached_bytes() / (1024 * 1024)
+                                << " MiB cached";
+    }
+    return ret;
 }
@@ -10,6 +10,7 @@
 #include <nil/proof-generator/assigner/zkevm.hpp>
 #include <nil/proof-generator/assigner/exp.hpp>
 #include <nil/proof-generator/assigner/trace_parser.hpp>
+#include <nil/proof-generator/assigner/trace_set.hpp>
 
 
 namespace nil {
@@ -31,6 +32,22 @@ namespace nil {
                 {circuits::EXP, fill_exp_assignment_table<BlueprintFieldType>},
         };
 
+        template<typename BlueprintFieldType>
+        using TraceSetAssignmentTableFiller = std::function<std::optional<std::string>(
+            crypto3::zk::snark::plonk_assignment_table<BlueprintFieldType>& assignment_table,
+            const TraceSet& traces,
+            const AssignerOptions& options)
+        >;
+
+        template<typename BlueprintFieldType>
+        std::map<const std::string, TraceSetAssignmentTableFiller<BlueprintFieldType>> trace_set_circuit_selector = {
+                {circuits::BYTECODE, fill_bytecode_assignment_table_from_traces<BlueprintFieldType>},
+                {circuits::RW, fill_rw_assignment_table_from_traces<BlueprintFieldType>},
+                {circuits::ZKEVM, fill_zkevm_assignment_table_from_traces<BlueprintFieldType>},
+                {circuits::COPY, fill_copy_events_assignment_table_from_traces<BlueprintFieldType>},
+                {circuits::EXP, fill_exp_assignment_table_from_traces<BlueprintFieldType>},
+        };
+
         template<typename BlueprintFieldType>
         void set_padding(nil::crypto3::zk::snark::plonk_assignment_table<BlueprintFieldType>& assignment_table) {
             std::uint32_t used_rows_amount = assignment_table.rows_amount();
@@ -68,6 +85,16 @@ namespace nil {
             }
         }
 
+        template<typename BlueprintFieldType>
+        void pad_assignment_table(crypto3::zk::snark::plonk_assignment_table<BlueprintFieldType>& assignment_table,
+                                  crypto3::zk::snark::plonk_table_description<BlueprintFieldType>& desc,
+                                  const std::string& circuit_name) {
+            desc.usable_rows_amount = assignment_table.rows_amount();
+            set_padding(assignment_table);
+            desc.rows_amount = assignment_table.rows_amount();
+            BOOST_LOG_TRIVIAL(debug) << "total rows amount = " << desc.rows_amount << " for " << circuit_name << "\n";
+        }
+
         template<typename BlueprintFieldType>
         std::optional<std::string> fill_assignment_table_single_thread(crypto3::zk::snark::plonk_assignment_table<BlueprintFieldType>& assignment_table,
                                                                        crypto3::zk::snark::plonk_table_description<BlueprintFieldType>& desc,
@@ -82,10 +109,27 @@ namespace nil {
             if (err) {
                 return err;
             }
-            desc.usable_rows_amount = assignment_table.rows_amount();
-            set_padding(assignment_table);
-            desc.rows_amount = assignment_table.rows_amount();
-            BOOST_LOG_TRIVIAL(debug) << "total rows amount = " << desc.rows_amount << " for " << circuit_name << "\n";
+            pad_assignment_table(assignment_table, desc, circuit_name);
+            return {};
+        }
+
+        /// @brief Same as fill_assignment_table_single_thread, but takes traces already read by read_trace_set.
+        /// Doesn't modify the traces, so assignment tables of different circuits can be filled from one set concurrently.
+        template<typename BlueprintFieldType>
+        std::optional<std::string> fill_assignment_table_from_trace_set(crypto3::zk::snark::plonk_assignment_table<BlueprintFieldType>& assignment_table,
+                                                                        crypto3::zk::snark::plonk_table_description<BlueprintFieldType>& desc,
+                                                                        const std::string& circuit_name,
+                                                                        const TraceSet& traces,
+                                                                        const AssignerOptions& options) {
+            auto find_it = trace_set_circuit_selector<BlueprintFieldType>.find(circuit_name);
+            if (find_it == trace_set_circuit_selector<BlueprintFieldType>.end()) {
+                return "Unknown circuit name " + circuit_name;
+            }
+            const auto err = find_it->second(assignment_table, traces, options);
+            if (err) {
+                return err;
+            }
+            pad_assignment_table(assignment_table, desc, circuit_name);
             return {};
         }
     } // proof_generator
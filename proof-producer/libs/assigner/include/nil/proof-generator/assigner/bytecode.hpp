@@ -7,16 +7,17 @@
 #include <nil/crypto3/zk/snark/arithmetization/plonk/assignment.hpp>
 #include <nil/blueprint/zkevm_bbf/bytecode.hpp>
 #include <nil/proof-generator/assigner/trace_parser.hpp>
+#include <nil/proof-generator/assigner/trace_set.hpp>
 #include <nil/proof-generator/assigner/options.hpp>
 
 namespace nil {
     namespace proof_generator {
 
-        /// @brief Fill assignment table
+        /// @brief Fill assignment table from already deserialized traces
         template<typename BlueprintFieldType>
-        std::optional<std::string> fill_bytecode_assignment_table(nil::crypto3::zk::snark::plonk_assignment_table<BlueprintFieldType>& assignment_table,
-                                                             const boost::filesystem::path& trace_base_path,
-                                                             const AssignerOptions& options) {
+        std::optional<std::string> fill_bytecode_assignment_table_from_traces(nil::crypto3::zk::snark::plonk_assignment_table<BlueprintFieldType>& assignment_table,
+                                                                              const TraceSet& traces,
+                                                                              const AssignerOptions& options) {
 
             using ComponentType = nil::blueprint::bbf::bytecode<BlueprintFieldType, nil::blueprint::bbf::GenerationStage::ASSIGNMENT>;
 
@@ -25,14 +26,7 @@ namespace nil {
             typename ComponentType::input_type input;
             input.rlc_challenge = options.circuits_limits.RLC_CHALLENGE;
 
-            const auto bytecode_trace_path = get_bytecode_trace_path(trace_base_path);
-            BOOST_LOG_TRIVIAL(debug) << "fill bytecode table from " << bytecode_trace_path << "\n";
-            const auto contract_bytecodes = deserialize_bytecodes_from_file(bytecode_trace_path, options);
-            if (!contract_bytecodes) {
-                return "can't read bytecode trace from file: " + bytecode_trace_path.string();
-            }
-
-            for (const auto& bytecode_it : contract_bytecodes->value) {
+            for (const auto& bytecode_it : traces.bytecodes) {
                 const auto raw_bytecode = string_to_bytes(bytecode_it.second);
                 input.bytecodes.new_buffer(raw_bytecode);
                 input.keccak_buffers.new_buffer(raw_bytecode);
@@ -41,6 +35,23 @@ namespace nil {
             ComponentType instance(context_object, input, options.circuits_limits.max_bytecode_size, options.circuits_limits.max_keccak_blocks);
             return {};
         }
+
+        /// @brief Fill assignment table
+        template<typename BlueprintFieldType>
+        std::optional<std::string> fill_bytecode_assignment_table(nil::crypto3::zk::snark::plonk_assignment_table<BlueprintFieldType>& assignment_table,
+                                                             const boost::filesystem::path& trace_base_path,
+                                                             const AssignerOptions& options) {
+            const auto bytecode_trace_path = get_bytecode_trace_path(trace_base_path);
+            BOOST_LOG_TRIVIAL(debug) << "fill bytecode table from " << bytecode_trace_path << "\n";
+            auto contract_bytecodes = deserialize_bytecodes_from_file(bytecode_trace_path, options);
+            if (!contract_bytecodes) {
+                return "can't read bytecode trace from file: " + bytecode_trace_path.string();
+            }
+
+            TraceSet traces;
+            traces.bytecodes = std::move(contract_bytecodes->value);
+            return fill_bytecode_assignment_table_from_traces(assignment_table, traces, options);
+        }
     } // proof_generator
 } // nil
 
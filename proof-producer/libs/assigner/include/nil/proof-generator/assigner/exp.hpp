@@ -8,40 +8,47 @@
 #include <nil/blueprint/zkevm_bbf/exp.hpp>
 #include <nil/proof-generator/assigner/options.hpp>
 #include <nil/proof-generator/assigner/trace_parser.hpp>
+#include <nil/proof-generator/assigner/trace_set.hpp>
 
 namespace nil {
     namespace proof_generator {
 
-        /// @brief Fill assignment table
+        /// @brief Fill assignment table from already deserialized traces
         template<typename BlueprintFieldType>
-        std::optional<std::string> fill_exp_assignment_table(nil::crypto3::zk::snark::plonk_assignment_table<BlueprintFieldType>& assignment_table,
-                                                             const boost::filesystem::path& trace_base_path,
-                                                             const AssignerOptions& options) {
-            BOOST_LOG_TRIVIAL(debug) << "fill exp table from " << trace_base_path << "\n";
-
+        std::optional<std::string> fill_exp_assignment_table_from_traces(nil::crypto3::zk::snark::plonk_assignment_table<BlueprintFieldType>& assignment_table,
+                                                                         const TraceSet& traces,
+                                                                         const AssignerOptions& options) {
             using ComponentType = nil::blueprint::bbf::exponentiation<BlueprintFieldType, nil::blueprint::bbf::GenerationStage::ASSIGNMENT>;
 
             typename nil::blueprint::bbf::context<BlueprintFieldType, nil::blueprint::bbf::GenerationStage::ASSIGNMENT> context_object(assignment_table, options.circuits_limits.max_rows);
 
-            typename ComponentType::input_type input;
-
-
-            const auto exp_trace_path = get_exp_trace_path(trace_base_path);
-            const auto exp_operations = deserialize_exp_traces_from_file(exp_trace_path, options);
-            if (!exp_operations) {
-                return "can't read exp operations from file: " + exp_trace_path.string();
-            }
-            input = std::move(exp_operations->value);
-
             ComponentType instance(
                 context_object,
-                input,
+                traces.exponentiations,
                 options.circuits_limits.max_rows,
                 options.circuits_limits.max_exp_rows
             );
 
             return {};
         }
+
+        /// @brief Fill assignment table
+        template<typename BlueprintFieldType>
+        std::optional<std::string> fill_exp_assignment_table(nil::crypto3::zk::snark::plonk_assignment_table<BlueprintFieldType>& assignment_table,
+                                                             const boost::filesystem::path& trace_base_path,
+                                                             const AssignerOptions& options) {
+            BOOST_LOG_TRIVIAL(debug) << "fill exp table from " << trace_base_path << "\n";
+
+            const auto exp_trace_path = get_exp_trace_path(trace_base_path);
+            auto exp_operations = deserialize_exp_traces_from_file(exp_trace_path, options);
+            if (!exp_operations) {
+                return "can't read exp operations from file: " + exp_trace_path.string();
+            }
+
+            TraceSet traces;
+            traces.exponentiations = std::move(exp_operations->value);
+            return fill_exp_assignment_table_from_traces(assignment_table, traces, options);
+        }
     } // proof_generator
 } // nil
 
@@ -8,10 +8,25 @@
 #include <nil/blueprint/zkevm_bbf/rw.hpp>
 #include <nil/proof-generator/assigner/options.hpp>
 #include <nil/proof-generator/assigner/trace_parser.hpp>
+#include <nil/proof-generator/assigner/trace_set.hpp>
 
 namespace nil {
     namespace proof_generator {
 
+        /// @brief Fill assignment table from already deserialized traces
+        template<typename BlueprintFieldType>
+        std::optional<std::string> fill_rw_assignment_table_from_traces(nil::crypto3::zk::snark::plonk_assignment_table<BlueprintFieldType>& assignment_table,
+                                                                        const TraceSet& traces,
+                                                                        const AssignerOptions& options) {
+            using ComponentType = nil::blueprint::bbf::rw<BlueprintFieldType, nil::blueprint::bbf::GenerationStage::ASSIGNMENT>;
+
+            typename nil::blueprint::bbf::context<BlueprintFieldType, nil::blueprint::bbf::GenerationStage::ASSIGNMENT> context_object(assignment_table, options.circuits_limits.max_rows);
+
+            ComponentType instance(context_object, traces.rw_operations, options.circuits_limits.max_rw_size, options.circuits_limits.max_mpt_size);
+
+            return {};
+        }
+
         /// @brief Fill assignment table
         template<typename BlueprintFieldType>
         std::optional<std::string> fill_rw_assignment_table(nil::crypto3::zk::snark::plonk_assignment_table<BlueprintFieldType>& assignment_table,
@@ -19,19 +34,15 @@ namespace nil {
                                                             const AssignerOptions& options) {
             BOOST_LOG_TRIVIAL(debug) << "fill rw table from " << trace_base_path << "\n";
 
-            using ComponentType = nil::blueprint::bbf::rw<BlueprintFieldType, nil::blueprint::bbf::GenerationStage::ASSIGNMENT>;
-
-            typename nil::blueprint::bbf::context<BlueprintFieldType, nil::blueprint::bbf::GenerationStage::ASSIGNMENT> context_object(assignment_table, options.circuits_limits.max_rows);
-
             const auto rw_trace_path = get_rw_trace_path(trace_base_path);
             auto input = deserialize_rw_traces_from_file(rw_trace_path, options);
             if (!input) {
                 return "can't read rw from file: " + rw_trace_path.string();
             }
 
-            ComponentType instance(context_object, input->value, options.circuits_limits.max_rw_size, options.circuits_limits.max_mpt_size);
-
-            return {};
+            TraceSet traces;
+            traces.rw_operations = std::move(input->value);
+            return fill_rw_assignment_table_from_traces(assignment_table, traces, options);
         }
     } // proof_generator
 } // nil
@@ -2,11 +2,12 @@
 #define PROOF_GENERATOR_LIBS_ASSIGNER_TRACE_PARSER_HPP_
 
 #include <utility>
-#include <fstream>
-#include <ios>
 #include <optional>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <iterator>
+#include <algorithm>
 #include <cstdint>
 #include <unordered_map>
 #include <boost/filesystem.hpp>
@@ -21,6 +22,7 @@
 
 #include <nil/proof-generator/assigner/trace.pb.h>
 #include <nil/proof-generator/assigner/options.hpp>
+#include <nil/proof-generator/assigner/trace_reader.hpp>
 #include "proto_hash.h"
 
 namespace nil {
@@ -51,25 +53,40 @@ namespace nil {
                 return base.string() + extension + BINARY_SERIALIZATION_EXTENSION;
             }
 
-            template<typename ProtoTraces>
-            [[nodiscard]] std::optional<ProtoTraces> read_pb_traces_from_file(const boost::filesystem::path& filename) {
-                std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
-                if (!file.is_open()) {
-                    return std::nullopt;
+            // Hashes of earlier versions of trace.proto whose traces are still read. Each version only adds fields,
+            // which are absent in older traces.
+            const char* const COMPATIBLE_PROTO_HASHES[] = {
+                "e3ae43a88b195e9b52a55dbdd31d1f05754be052dfeef94560cfbf35e05fe83f", // before MemoryOpRange
+            };
+
+            [[nodiscard]] bool is_compatible_proto_hash(std::string_view proto_hash) {
+                if (proto_hash == PROTO_HASH) {
+                    return true;
                 }
+                return std::find(std::begin(COMPATIBLE_PROTO_HASHES), std::end(COMPATIBLE_PROTO_HASHES), proto_hash)
+                    != std::end(COMPATIBLE_PROTO_HASHES);
+            }
 
-                ProtoTraces pb_traces;
-                if (!pb_traces.ParseFromIstream(&file)) {
+            /// @brief Map and index a trace file, records are parsed by the deserializers chunk by chunk
+            template<typename ProtoTraces>
+            [[nodiscard]] std::optional<TraceRecords> read_pb_traces_from_file(const boost::filesystem::path& filename) {
+                auto traces = read_trace_records_from_file(filename);
+                if (!traces) {
                     return std::nullopt;
                 }
 
-                if (pb_traces.proto_hash() != PROTO_HASH) {
+                if (!is_compatible_proto_hash(traces->index.bytes(traces->file, ProtoTraces::kProtoHashFieldNumber))) {
                     BOOST_LOG_TRIVIAL(error) << "Compatibility check failed for trace file " << filename.c_str()
                                              << ": proto version mismatch";
                     return std::nullopt;
 
                 }
-                return pb_traces;
+                return traces;
+            }
+
+            template<typename ProtoTraces>
+            [[nodiscard]] std::uint64_t get_trace_index(const TraceRecords& traces) {
+                return traces.index.varint(ProtoTraces::kTraceIdxFieldNumber);
             }
 
             [[nodiscard]] std::optional<std::pair<
@@ -184,24 +201,31 @@ namespace nil {
             const AssignerOptions& opts,
             TraceIndexOpt base_index = {}
         ) {
-            const auto pb_traces = read_pb_traces_from_file<executionproofs::BytecodeTraces>(bytecode_trace_path);
-            if (!pb_traces) {
+            using PbTraces = executionproofs::BytecodeTraces;
+
+            const auto traces = read_pb_traces_from_file<PbTraces>(bytecode_trace_path);
+            if (!traces) {
                 return std::nullopt;
             }
-            if (!check_trace_index(opts, base_index, pb_traces->trace_idx())) {
+            const auto trace_idx = get_trace_index<PbTraces>(*traces);
+            if (!check_trace_index(opts, base_index, trace_idx)) {
                 return std::nullopt;
             }
 
             // Read executed op codes
             std::unordered_map<std::string, std::string> contract_bytecodes;
-            const auto& bytecodes = pb_traces->contract_bytecodes();
-            for (const auto& bytecode : bytecodes) {
-                contract_bytecodes.emplace(bytecode.first, bytecode.second);
+            for (const auto& span : traces->index.records(PbTraces::kContractBytecodesFieldNumber)) {
+                auto bytecode = parse_trace_map_entry(traces->file, span);
+                if (!bytecode) {
+                    return std::nullopt;
+                }
+                // Later entries override earlier ones, the same as protobuf map parsing does
+                contract_bytecodes.insert_or_assign(std::move(bytecode->first), std::move(bytecode->second));
             }
 
             return DeserializeResult<BytecodeTraces>{
                 std::move(contract_bytecodes),
-                pb_traces->trace_idx()
+                trace_idx
             };
         }
 
@@ -210,66 +234,111 @@ namespace nil {
             const AssignerOptions& opts,
             TraceIndexOpt base_index = {}
         ) {
-            const auto pb_traces = read_pb_traces_from_file<executionproofs::RWTraces>(rw_traces_path);
-            if (!pb_traces) {
+            using PbTraces = executionproofs::RWTraces;
+
+            const auto traces = read_pb_traces_from_file<PbTraces>(rw_traces_path);
+            if (!traces) {
                 return std::nullopt;
             }
-            if (!check_trace_index(opts, base_index, pb_traces->trace_idx())) {
+            const auto trace_idx = get_trace_index<PbTraces>(*traces);
+            if (!check_trace_index(opts, base_index, trace_idx)) {
                 return std::nullopt;
             }
 
+            const auto& stack_ops = traces->index.records(PbTraces::kStackOpsFieldNumber);
+            const auto& memory_ops = traces->index.records(PbTraces::kMemoryOpsFieldNumber);
+            const auto& memory_op_ranges = traces->index.records(PbTraces::kMemoryOpRangesFieldNumber);
+            const auto& storage_ops = traces->index.records(PbTraces::kStorageOpsFieldNumber);
+
             blueprint::bbf::rw_operations_vector rw_traces;
-            rw_traces.reserve(pb_traces->stack_ops_size() + pb_traces->memory_ops_size() + pb_traces->storage_ops_size() + 1); // +1 slot for start op
+            rw_traces.reserve(stack_ops.size() + memory_ops.size() + storage_ops.size() + 1); // +1 slot for start op
 
             // Convert stack operations
-            for (const auto& pb_sop : pb_traces->stack_ops()) {
-                rw_traces.push_back(blueprint::bbf::stack_rw_operation(
-                    static_cast<uint64_t>(pb_sop.txn_id()),
-                    static_cast<int32_t>(pb_sop.index()),
-                    static_cast<uint64_t>(pb_sop.rw_idx()),
-                    !pb_sop.is_read(),
-                    proto_uint256_to_zkevm_word(pb_sop.value()))
-                );
+            const bool stack_ok = parse_trace_records<executionproofs::StackOp>(
+                traces->file, stack_ops, rw_traces,
+                [](const executionproofs::StackOp& pb_sop) {
+                    return std::make_optional(blueprint::bbf::stack_rw_operation(
+                        static_cast<uint64_t>(pb_sop.txn_id()),
+                        static_cast<int32_t>(pb_sop.index()),
+                        static_cast<uint64_t>(pb_sop.rw_idx()),
+                        !pb_sop.is_read(),
+                        proto_uint256_to_zkevm_word(pb_sop.value()))
+                    );
+                });
+            if (!stack_ok) {
+                return std::nullopt;
             }
 
             // Convert memory operations
-            for (const auto& pb_mop : pb_traces->memory_ops()) {
-                auto value = string_to_bytes(pb_mop.value());
-                auto const op = blueprint::bbf::memory_rw_operation(
-                    static_cast<uint64_t>(pb_mop.txn_id()),
-                    blueprint::zkevm_word_type(static_cast<int>(pb_mop.index())),
-                    static_cast<uint64_t>(pb_mop.rw_idx()),
-                    !pb_mop.is_read(),
-                    blueprint::zkevm_word_from_bytes(value)
-                );
-                rw_traces.push_back(std::move(op));
+            const bool memory_ok = parse_trace_records<executionproofs::MemoryOp>(
+                traces->file, memory_ops, rw_traces,
+                [](const executionproofs::MemoryOp& pb_mop) {
+                    auto value = string_to_bytes(pb_mop.value());
+                    return std::make_optional(blueprint::bbf::memory_rw_operation(
+                        static_cast<uint64_t>(pb_mop.txn_id()),
+                        blueprint::zkevm_word_type(static_cast<int>(pb_mop.index())),
+                        static_cast<uint64_t>(pb_mop.rw_idx()),
+                        !pb_mop.is_read(),
+                        blueprint::zkevm_word_from_bytes(value)
+                    ));
+                });
+            if (!memory_ok) {
+                return std::nullopt;
+            }
+
+            // Expand ranged memory operations into one operation per byte
+            std::size_t memory_range_ops = rw_traces.size();
+            const bool memory_ranges_ok = parse_trace_records<executionproofs::MemoryOpRange>(
+                traces->file, memory_op_ranges, rw_traces,
+                [](const executionproofs::MemoryOpRange& pb_mop, std::vector<blueprint::bbf::rw_operation>& ops) {
+                    const auto& values = pb_mop.values();
+                    for (std::size_t i = 0; i < values.size(); i++) {
+                        ops.push_back(blueprint::bbf::memory_rw_operation(
+                            static_cast<uint64_t>(pb_mop.txn_id()),
+                            blueprint::zkevm_word_type(static_cast<int>(pb_mop.start_index() + i)),
+                            static_cast<uint64_t>(pb_mop.start_rw_idx() + i),
+                            !pb_mop.is_read(),
+                            blueprint::zkevm_word_type(static_cast<std::uint8_t>(values[i]))
+                        ));
+                    }
+                    return true;
+                });
+            if (!memory_ranges_ok) {
+                return std::nullopt;
             }
+            memory_range_ops = rw_traces.size() - memory_range_ops;
 
             // Convert storage operations
-            for (const auto& pb_sop : pb_traces->storage_ops()) {
-                auto op = blueprint::bbf::storage_rw_operation(
-                    static_cast<uint64_t>(pb_sop.txn_id()),
-                    blueprint::zkevm_word_from_string(static_cast<std::string>(pb_sop.key())),
-                    static_cast<uint64_t>(pb_sop.rw_idx()),
-                    !pb_sop.is_read(),
-                    proto_uint256_to_zkevm_word(pb_sop.value()),
-                    proto_uint256_to_zkevm_word(pb_sop.prev_value()),
-                    blueprint::zkevm_word_from_string(pb_sop.address().address_bytes())
-                );
-                //TODO root and initial_root?
-                rw_traces.push_back(std::move(op));
+            const bool storage_ok = parse_trace_records<executionproofs::StorageOp>(
+                traces->file, storage_ops, rw_traces,
+                [](const executionproofs::StorageOp& pb_sop) {
+                    //TODO root and initial_root?
+                    return std::make_optional(blueprint::bbf::storage_rw_operation(
+                        static_cast<uint64_t>(pb_sop.txn_id()),
+                        blueprint::zkevm_word_from_string(static_cast<std::string>(pb_sop.key())),
+                        static_cast<uint64_t>(pb_sop.rw_idx()),
+                        !pb_sop.is_read(),
+                        proto_uint256_to_zkevm_word(pb_sop.value()),
+                        proto_uint256_to_zkevm_word(pb_sop.prev_value()),
+                        blueprint::zkevm_word_from_string(pb_sop.address().address_bytes())
+                    ));
+                });
+            if (!storage_ok) {
+                return std::nullopt;
             }
 
             std::sort(rw_traces.begin(), rw_traces.end(), std::less());
 
             BOOST_LOG_TRIVIAL(debug) << "number RW operations " << rw_traces.size() << ":\n"
-                                     << "stack   " << pb_traces->stack_ops_size() << "\n"
-                                     << "memory  " << pb_traces->memory_ops_size() << "\n"
-                                     << "storage " << pb_traces->storage_ops_size() << "\n";
+                                     << "stack   " << stack_ops.size() << "\n"
+                                     << "memory  " << memory_ops.size() << "\n"
+                                     << "memory ranges " << memory_op_ranges.size()
+                                     << " (" << memory_range_ops << " bytes)\n"
+                                     << "storage " << storage_ops.size() << "\n";
 
             return DeserializeResult<RWTraces>{
                 std::move(rw_traces),
-                pb_traces->trace_idx()
+                trace_idx
             };
         }
 
@@ -278,47 +347,55 @@ namespace nil {
             const AssignerOptions& opts,
             TraceIndexOpt base_index = {}
         ) {
-            const auto pb_traces = read_pb_traces_from_file<executionproofs::ZKEVMTraces>(zkevm_traces_path);
-            if (!pb_traces) {
+            using PbTraces = executionproofs::ZKEVMTraces;
+
+            const auto traces = read_pb_traces_from_file<PbTraces>(zkevm_traces_path);
+            if (!traces) {
                 return std::nullopt;
             }
-            if (!check_trace_index(opts, base_index, pb_traces->trace_idx())) {
+            const auto trace_idx = get_trace_index<PbTraces>(*traces);
+            if (!check_trace_index(opts, base_index, trace_idx)) {
                 return std::nullopt;
             }
 
             std::vector<blueprint::bbf::zkevm_state> zkevm_states;
-            zkevm_states.reserve(pb_traces->zkevm_states_size());
-            for (const auto& pb_state : pb_traces->zkevm_states()) {
-                std::vector<blueprint::zkevm_word_type> stack;
-                stack.reserve(pb_state.stack_slice_size());
-                for (const auto& pb_stack_val : pb_state.stack_slice()) {
-                    stack.push_back(proto_uint256_to_zkevm_word(pb_stack_val));
-                }
-                std::map<std::size_t, std::uint8_t> memory;
-                for (const auto& pb_memory_val : pb_state.memory_slice()) {
-                    memory.emplace(pb_memory_val.first, pb_memory_val.second);
-                }
-                std::map<blueprint::zkevm_word_type, blueprint::zkevm_word_type> storage;
-                for (const auto& pb_storage_entry : pb_state.storage_slice()) {
-                    storage.emplace(proto_uint256_to_zkevm_word(pb_storage_entry.key()), proto_uint256_to_zkevm_word(pb_storage_entry.value()));
-                }
-                zkevm_states.emplace_back(stack, memory, storage);
-                zkevm_states.back().call_id = static_cast<uint64_t>(pb_state.call_id());
-                zkevm_states.back().pc = static_cast<uint64_t>(pb_state.pc());
-                zkevm_states.back().gas = static_cast<uint64_t>(pb_state.gas());
-                zkevm_states.back().rw_counter = static_cast<uint64_t>(pb_state.rw_idx());
-                zkevm_states.back().bytecode_hash = blueprint::zkevm_word_from_string(static_cast<std::string>(pb_state.bytecode_hash()));
-                zkevm_states.back().opcode = static_cast<uint64_t>(pb_state.opcode());
-                zkevm_states.back().additional_input = proto_uint256_to_zkevm_word(pb_state.additional_input()),
-                zkevm_states.back().stack_size = static_cast<uint64_t>(pb_state.stack_size());
-                zkevm_states.back().memory_size = static_cast<uint64_t>(pb_state.memory_size());
-                zkevm_states.back().tx_finish = static_cast<bool>(pb_state.tx_finish());
-                zkevm_states.back().error_opcode = static_cast<uint64_t>(pb_state.error_opcode());
+            const bool ok = parse_trace_records<executionproofs::ZKEVMState>(
+                traces->file, traces->index.records(PbTraces::kZkevmStatesFieldNumber), zkevm_states,
+                [](const executionproofs::ZKEVMState& pb_state) {
+                    std::vector<blueprint::zkevm_word_type> stack;
+                    stack.reserve(pb_state.stack_slice_size());
+                    for (const auto& pb_stack_val : pb_state.stack_slice()) {
+                        stack.push_back(proto_uint256_to_zkevm_word(pb_stack_val));
+                    }
+                    std::map<std::size_t, std::uint8_t> memory;
+                    for (const auto& pb_memory_val : pb_state.memory_slice()) {
+                        memory.emplace(pb_memory_val.first, pb_memory_val.second);
+                    }
+                    std::map<blueprint::zkevm_word_type, blueprint::zkevm_word_type> storage;
+                    for (const auto& pb_storage_entry : pb_state.storage_slice()) {
+                        storage.emplace(proto_uint256_to_zkevm_word(pb_storage_entry.key()), proto_uint256_to_zkevm_word(pb_storage_entry.value()));
+                    }
+                    std::optional<blueprint::bbf::zkevm_state> state(std::in_place, stack, memory, storage);
+                    state->call_id = static_cast<uint64_t>(pb_state.call_id());
+                    state->pc = static_cast<uint64_t>(pb_state.pc());
+                    state->gas = static_cast<uint64_t>(pb_state.gas());
+                    state->rw_counter = static_cast<uint64_t>(pb_state.rw_idx());
+                    state->bytecode_hash = blueprint::zkevm_word_from_string(static_cast<std::string>(pb_state.bytecode_hash()));
+                    state->opcode = static_cast<uint64_t>(pb_state.opcode());
+                    state->additional_input = proto_uint256_to_zkevm_word(pb_state.additional_input());
+                    state->stack_size = static_cast<uint64_t>(pb_state.stack_size());
+                    state->memory_size = static_cast<uint64_t>(pb_state.memory_size());
+                    state->tx_finish = static_cast<bool>(pb_state.tx_finish());
+                    state->error_opcode = static_cast<uint64_t>(pb_state.error_opcode());
+                    return state;
+                });
+            if (!ok) {
+                return std::nullopt;
             }
 
             return DeserializeResult<ZKEVMTraces>{
                 std::move(zkevm_states),
-                pb_traces->trace_idx()
+                trace_idx
             };
         }
 
@@ -327,47 +404,54 @@ namespace nil {
             const AssignerOptions& opts,
             TraceIndexOpt base_index = {}
         ) {
-            const auto pb_traces = read_pb_traces_from_file<executionproofs::CopyTraces>(copy_traces_file);
-            if (!pb_traces) {
+            using PbTraces = executionproofs::CopyTraces;
+
+            const auto traces = read_pb_traces_from_file<PbTraces>(copy_traces_file);
+            if (!traces) {
                 return std::nullopt;
             }
-            if (!check_trace_index(opts, base_index, pb_traces->trace_idx())) {
+            const auto trace_idx = get_trace_index<PbTraces>(*traces);
+            if (!check_trace_index(opts, base_index, trace_idx)) {
                 return std::nullopt;
             }
 
             namespace bbf = blueprint::bbf;
 
             std::vector<bbf::copy_event> copy_events;
-            copy_events.reserve(pb_traces->copy_events_size());
-            for (const auto& pb_event: pb_traces->copy_events()) {
-                bbf::copy_event event;
-                event.initial_rw_counter = pb_event.rw_idx();
-
-                const auto source = copy_operand_from_proto(pb_event.from());
-                if (!source) {
-                    return std::nullopt;
-                }
-                event.source_type = source->first;
-                event.source_id = source->second;
-                event.src_address = pb_event.from().mem_address();
+            const bool ok = parse_trace_records<executionproofs::CopyEvent>(
+                traces->file, traces->index.records(PbTraces::kCopyEventsFieldNumber), copy_events,
+                [](const executionproofs::CopyEvent& pb_event) -> std::optional<bbf::copy_event> {
+                    bbf::copy_event event;
+                    event.initial_rw_counter = pb_event.rw_idx();
+
+                    const auto source = copy_operand_from_proto(pb_event.from());
+                    if (!source) {
+                        return std::nullopt;
+                    }
+                    event.source_type = source->first;
+                    event.source_id = source->second;
+                    event.src_address = pb_event.from().mem_address();
 
-                const auto dest = copy_operand_from_proto(pb_event.to());
-                if (!dest) {
-                    return std::nullopt;
-                }
-                event.destination_type = dest->first;
-                event.destination_id = dest->second;
-                event.dst_address = pb_event.to().mem_address();
+                    const auto dest = copy_operand_from_proto(pb_event.to());
+                    if (!dest) {
+                        return std::nullopt;
+                    }
+                    event.destination_type = dest->first;
+                    event.destination_id = dest->second;
+                    event.dst_address = pb_event.to().mem_address();
 
-                event.bytes = std::move(string_to_bytes(pb_event.data()));
-                event.length = event.bytes.size();
+                    event.bytes = string_to_bytes(pb_event.data());
+                    event.length = event.bytes.size();
 
-                copy_events.push_back(std::move(event));
+                    return event;
+                });
+            if (!ok) {
+                return std::nullopt;
             }
 
             return DeserializeResult<CopyEvents>{
                 std::move(copy_events),
-                pb_traces->trace_idx()
+                trace_idx
             };
         }
 
@@ -376,26 +460,33 @@ namespace nil {
             const AssignerOptions& opts,
             TraceIndexOpt base_index = {}
         ) {
-            const auto pb_traces = read_pb_traces_from_file<executionproofs::ExpTraces>(exp_traces_path);
-            if (!pb_traces) {
+            using PbTraces = executionproofs::ExpTraces;
+
+            const auto traces = read_pb_traces_from_file<PbTraces>(exp_traces_path);
+            if (!traces) {
                 return std::nullopt;
             }
-            if (!check_trace_index(opts, base_index, pb_traces->trace_idx())) {
+            const auto trace_idx = get_trace_index<PbTraces>(*traces);
+            if (!check_trace_index(opts, base_index, trace_idx)) {
                 return std::nullopt;
             }
 
             std::vector<exp_input> exps;
-            exps.reserve(pb_traces->exp_ops_size());
-            for (const auto& pb_exp_op : pb_traces->exp_ops()) {
-                exps.emplace_back(
-                    proto_uint256_to_zkevm_word(pb_exp_op.base()),
-                    proto_uint256_to_zkevm_word(pb_exp_op.exponent())
-                );
+            const bool ok = parse_trace_records<executionproofs::ExpOp>(
+                traces->file, traces->index.records(PbTraces::kExpOpsFieldNumber), exps,
+                [](const executionproofs::ExpOp& pb_exp_op) {
+                    return std::make_optional<exp_input>(
+                        proto_uint256_to_zkevm_word(pb_exp_op.base()),
+                        proto_uint256_to_zkevm_word(pb_exp_op.exponent())
+                    );
+                });
+            if (!ok) {
+                return std::nullopt;
             }
 
             return DeserializeResult<ExpTraces>{
                 std::move(exps),
-                pb_traces->trace_idx()
+                trace_idx
             };
         }
     } // namespace proof_generator
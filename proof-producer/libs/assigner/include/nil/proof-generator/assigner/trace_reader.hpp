@@ -0,0 +1,330 @@
+#ifndef PROOF_GENERATOR_LIBS_ASSIGNER_TRACE_READER_HPP_
+#define PROOF_GENERATOR_LIBS_ASSIGNER_TRACE_READER_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/log/trivial.hpp>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+
+namespace nil {
+    namespace proof_generator {
+
+        /// @brief Read-only memory mapping of a whole trace file
+        class MappedTraceFile {
+        public:
+            MappedTraceFile() = default;
+            MappedTraceFile(const MappedTraceFile&) = delete;
+            MappedTraceFile& operator=(const MappedTraceFile&) = delete;
+
+            MappedTraceFile(MappedTraceFile&& other) noexcept:
+                data_(std::exchange(other.data_, nullptr)),
+                size_(std::exchange(other.size_, 0)) {}
+
+            MappedTraceFile& operator=(MappedTraceFile&& other) noexcept {
+                if (this != &other) {
+                    unmap();
+                    data_ = std::exchange(other.data_, nullptr);
+                    size_ = std::exchange(other.size_, 0);
+                }
+                return *this;
+            }
+
+            ~MappedTraceFile() {
+                unmap();
+            }
+
+            [[nodiscard]] static std::optional<MappedTraceFile> open(const boost::filesystem::path& filename) {
+                const int fd = ::open(filename.c_str(), O_RDONLY);
+                if (fd < 0) {
+                    return std::nullopt;
+                }
+                struct stat st;
+                if (::fstat(fd, &st) != 0) {
+                    ::close(fd);
+                    return std::nullopt;
+                }
+
+                MappedTraceFile file;
+                file.size_ = static_cast<std::uint64_t>(st.st_size);
+                if (file.size_ != 0) {
+                    void* data = ::mmap(nullptr, file.size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (data == MAP_FAILED) {
+                        ::close(fd);
+                        BOOST_LOG_TRIVIAL(error) << "Can't map trace file " << filename.c_str();
+                        return std::nullopt;
+                    }
+                    // Records are indexed front to back and then parsed by several threads at once
+                    ::madvise(data, file.size_, MADV_WILLNEED);
+                    file.data_ = static_cast<const std::uint8_t*>(data);
+                }
+                ::close(fd);
+                return file;
+            }
+
+            const std::uint8_t* data() const { return data_; }
+            std::uint64_t size() const { return size_; }
+
+        private:
+            void unmap() {
+                if (data_ != nullptr) {
+                    ::munmap(const_cast<std::uint8_t*>(data_), size_);
+                    data_ = nullptr;
+                }
+            }
+
+            const std::uint8_t* data_{nullptr};
+            std::uint64_t size_{0};
+        };
+
+        /// @brief Location of one length-delimited record in a mapped trace file
+        struct TraceRecordSpan {
+            std::uint64_t offset;
+            std::uint32_t size;
+        };
+
+        /// @brief Top-level fields of a trace message. Every element of a repeated message field is a
+        /// length-delimited record, only their positions are stored, records themselves are parsed later.
+        class TraceRecordIndex {
+        public:
+            [[nodiscard]] static std::optional<TraceRecordIndex> build(const MappedTraceFile& file) {
+                using google::protobuf::internal::WireFormatLite;
+
+                // CodedInputStream addresses at most 2GB, larger files are scanned in windows
+                static constexpr std::uint64_t max_window = std::uint64_t(1) << 30;
+
+                TraceRecordIndex index;
+                std::uint64_t base = 0;
+                while (base < file.size()) {
+                    const int window = static_cast<int>(std::min(file.size() - base, max_window));
+                    const bool last_window = base + window == file.size();
+                    google::protobuf::io::CodedInputStream input(file.data() + base, window);
+
+                    std::uint64_t next_base = base + window;
+                    bool restart = false;
+                    while (!restart) {
+                        const std::uint64_t field_start = base + input.CurrentPosition();
+                        if (field_start == base + window) {
+                            break;
+                        }
+                        const std::uint32_t tag = input.ReadTag();
+                        const int field = WireFormatLite::GetTagFieldNumber(tag);
+                        bool ok = tag != 0;
+                        if (ok) {
+                            switch (WireFormatLite::GetTagWireType(tag)) {
+                                case WireFormatLite::WIRETYPE_VARINT: {
+                                    std::uint64_t value;
+                                    ok = input.ReadVarint64(&value);
+                                    if (ok) {
+                                        index.varints_[field] = value;
+                                    }
+                                    break;
+                                }
+                                case WireFormatLite::WIRETYPE_LENGTH_DELIMITED: {
+                                    std::uint32_t size;
+                                    ok = input.ReadVarint32(&size);
+                                    if (!ok) {
+                                        break;
+                                    }
+                                    const std::uint64_t offset = base + input.CurrentPosition();
+                                    if (offset + size > file.size()) {
+                                        BOOST_LOG_TRIVIAL(error) << "Trace record at " << offset << " is truncated";
+                                        return std::nullopt;
+                                    }
+                                    index.records_[field].push_back({offset, size});
+                                    if (offset + size > base + window) {
+                                        next_base = offset + size;
+                                        restart = true;
+                                    } else {
+                                        input.Skip(static_cast<int>(size));
+                                    }
+                                    break;
+                                }
+                                case WireFormatLite::WIRETYPE_FIXED64:
+                                    ok = input.Skip(8);
+                                    break;
+                                case WireFormatLite::WIRETYPE_FIXED32:
+                                    ok = input.Skip(4);
+                                    break;
+                                default:
+                                    BOOST_LOG_TRIVIAL(error) << "Unexpected wire type in trace field " << field;
+                                    return std::nullopt;
+                            }
+                        }
+                        if (!ok) {
+                            // A field header crossing the window end is read again from the next window
+                            if (last_window || field_start == base) {
+                                BOOST_LOG_TRIVIAL(error) << "Malformed trace field at " << field_start;
+                                return std::nullopt;
+                            }
+                            next_base = field_start;
+                            break;
+                        }
+                    }
+                    base = next_base;
+                }
+                return index;
+            }
+
+            /// @brief All records of a length-delimited field in file order
+            const std::vector<TraceRecordSpan>& records(int field) const {
+                static const std::vector<TraceRecordSpan> empty;
+                const auto it = records_.find(field);
+                return it == records_.end() ? empty : it->second;
+            }
+
+            /// @brief Value of a scalar field, 0 if it is absent as protobuf does
+            std::uint64_t varint(int field) const {
+                const auto it = varints_.find(field);
+                return it == varints_.end() ? 0 : it->second;
+            }
+
+            /// @brief Value of a string or bytes field, the last one wins as protobuf does
+            std::string_view bytes(const MappedTraceFile& file, int field) const {
+                const auto& spans = records(field);
+                if (spans.empty()) {
+                    return {};
+                }
+                return {reinterpret_cast<const char*>(file.data() + spans.back().offset), spans.back().size};
+            }
+
+        private:
+            std::unordered_map<int, std::vector<TraceRecordSpan>> records_;
+            std::unordered_map<int, std::uint64_t> varints_;
+        };
+
+        /// @brief Mapped trace file with its top-level fields indexed
+        struct TraceRecords {
+            MappedTraceFile file;
+            TraceRecordIndex index;
+        };
+
+        [[nodiscard]] inline std::optional<TraceRecords> read_trace_records_from_file(const boost::filesystem::path& filename) {
+            auto file = MappedTraceFile::open(filename);
+            if (!file) {
+                return std::nullopt;
+            }
+            auto index = TraceRecordIndex::build(*file);
+            if (!index) {
+                BOOST_LOG_TRIVIAL(error) << "Can't index trace file " << filename.c_str();
+                return std::nullopt;
+            }
+            return TraceRecords{std::move(*file), std::move(*index)};
+        }
+
+        /// @brief Parse records of one field into protobuf messages of type Record and convert each of them.
+        /// Large fields are split into chunks parsed concurrently, each chunk reuses a single message.
+        /// @param convert maps a parsed record to std::optional of the output type, nullopt fails the whole read.
+        /// A record expanding to several values is handled by convert(record, values) appending to values
+        /// and returning false on failure.
+        template<typename Record, typename Output, typename Convert>
+        [[nodiscard]] bool parse_trace_records(const MappedTraceFile& file,
+                                               const std::vector<TraceRecordSpan>& spans,
+                                               Output& output,
+                                               Convert convert) {
+            using value_type = typename Output::value_type;
+            static constexpr std::size_t min_chunk_size = 1 << 14;
+
+            const std::size_t max_chunks = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+            const std::size_t chunks = std::clamp<std::size_t>(spans.size() / min_chunk_size, 1, max_chunks);
+            const std::size_t chunk_size = (spans.size() + chunks - 1) / chunks;
+
+            auto parse_chunk = [&file, &spans, &convert, chunk_size](std::size_t chunk) {
+                std::optional<std::vector<value_type>> result(std::in_place);
+                const std::size_t begin = std::min(chunk * chunk_size, spans.size());
+                const std::size_t end = std::min(begin + chunk_size, spans.size());
+                result->reserve(end - begin);
+
+                Record record;
+                for (std::size_t i = begin; i < end; ++i) {
+                    if (!record.ParseFromArray(file.data() + spans[i].offset, static_cast<int>(spans[i].size))) {
+                        BOOST_LOG_TRIVIAL(error) << "Can't parse trace record at " << spans[i].offset;
+                        return std::optional<std::vector<value_type>>();
+                    }
+                    if constexpr (std::is_invocable_v<Convert&, const Record&, std::vector<value_type>&>) {
+                        if (!convert(std::as_const(record), *result)) {
+                            return std::optional<std::vector<value_type>>();
+                        }
+                    } else {
+                        auto value = convert(std::as_const(record));
+                        if (!value) {
+                            return std::optional<std::vector<value_type>>();
+                        }
+                        result->push_back(std::move(*value));
+                    }
+                }
+                return result;
+            };
+
+            std::vector<std::future<std::optional<std::vector<value_type>>>> futures;
+            for (std::size_t chunk = 1; chunk < chunks; ++chunk) {
+                futures.push_back(std::async(std::launch::async, parse_chunk, chunk));
+            }
+            std::vector<std::optional<std::vector<value_type>>> results;
+            results.push_back(parse_chunk(0));
+            for (auto& future : futures) {
+                results.push_back(future.get());
+            }
+
+            std::size_t size = output.size();
+            for (auto& result : results) {
+                if (!result) {
+                    return false;
+                }
+                size += result->size();
+            }
+            output.reserve(size);
+            for (auto& result : results) {
+                std::move(result->begin(), result->end(), std::back_inserter(output));
+            }
+            return true;
+        }
+
+        /// @brief Parse a map<string, bytes> entry record without the generated map entry type
+        [[nodiscard]] inline std::optional<std::pair<std::string, std::string>> parse_trace_map_entry(
+            const MappedTraceFile& file,
+            const TraceRecordSpan& span
+        ) {
+            using google::protobuf::internal::WireFormatLite;
+
+            google::protobuf::io::CodedInputStream input(file.data() + span.offset, static_cast<int>(span.size));
+            std::pair<std::string, std::string> entry;
+            while (const std::uint32_t tag = input.ReadTag()) {
+                bool ok;
+                if (tag == WireFormatLite::MakeTag(1, WireFormatLite::WIRETYPE_LENGTH_DELIMITED)) {
+                    ok = WireFormatLite::ReadBytes(&input, &entry.first);
+                } else if (tag == WireFormatLite::MakeTag(2, WireFormatLite::WIRETYPE_LENGTH_DELIMITED)) {
+                    ok = WireFormatLite::ReadBytes(&input, &entry.second);
+                } else {
+                    ok = WireFormatLite::SkipField(&input, tag);
+                }
+                if (!ok) {
+                    BOOST_LOG_TRIVIAL(error) << "Can't parse trace map entry at " << span.offset;
+                    return std::nullopt;
+                }
+            }
+            return entry;
+        }
+    } // namespace proof_generator
+} // namespace nil
+
+#endif  // PROOF_GENERATOR_LIBS_ASSIGNER_TRACE_READER_HPP_
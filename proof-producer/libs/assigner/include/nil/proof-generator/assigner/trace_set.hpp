@@ -0,0 +1,78 @@
+#ifndef PROOF_GENERATOR_LIBS_ASSIGNER_TRACE_SET_HPP_
+#define PROOF_GENERATOR_LIBS_ASSIGNER_TRACE_SET_HPP_
+
+#include <future>
+#include <optional>
+#include <string>
+
+#include <boost/filesystem.hpp>
+#include <boost/log/trivial.hpp>
+
+#include <nil/proof-generator/assigner/options.hpp>
+#include <nil/proof-generator/assigner/trace_parser.hpp>
+
+namespace nil {
+    namespace proof_generator {
+
+        /// @brief All traces of one block, deserialized once and shared by the assigners of every circuit
+        struct TraceSet {
+            BytecodeTraces bytecodes;
+            RWTraces rw_operations;
+            ZKEVMTraces zkevm_states;
+            CopyEvents copy_events;
+            ExpTraces exponentiations;
+        };
+
+        /// @brief Read every trace file of the set concurrently, traces are checked to come from the same set
+        inline std::optional<std::string> read_trace_set(const boost::filesystem::path& trace_base_path,
+                                                         const AssignerOptions& options,
+                                                         TraceSet& traces) {
+            BOOST_LOG_TRIVIAL(debug) << "read trace set from " << trace_base_path << "\n";
+
+            const auto bytecode_trace_path = get_bytecode_trace_path(trace_base_path);
+            const auto rw_trace_path = get_rw_trace_path(trace_base_path);
+            const auto zkevm_trace_path = get_zkevm_trace_path(trace_base_path);
+            const auto copy_trace_path = get_copy_trace_path(trace_base_path);
+            const auto exp_trace_path = get_exp_trace_path(trace_base_path);
+
+            auto bytecodes = std::async(std::launch::async, deserialize_bytecodes_from_file, bytecode_trace_path, options, TraceIndexOpt{});
+            auto rw_operations = std::async(std::launch::async, deserialize_rw_traces_from_file, rw_trace_path, options, TraceIndexOpt{});
+            auto zkevm_states = std::async(std::launch::async, deserialize_zkevm_state_traces_from_file, zkevm_trace_path, options, TraceIndexOpt{});
+            auto copy_events = std::async(std::launch::async, deserialize_copy_events_from_file, copy_trace_path, options, TraceIndexOpt{});
+            auto exponentiations = std::async(std::launch::async, deserialize_exp_traces_from_file, exp_trace_path, options, TraceIndexOpt{});
+
+            auto bytecodes_result = bytecodes.get();
+            auto rw_result = rw_operations.get();
+            auto zkevm_result = zkevm_states.get();
+            auto copy_result = copy_events.get();
+            auto exp_result = exponentiations.get();
+
+            if (!bytecodes_result) {
+                return "can't read bytecode trace from file: " + bytecode_trace_path.string();
+            }
+            // Bytecode trace index is the base one, the same way the zkevm assigner checks it
+            const TraceIndexOpt base_index = bytecodes_result->index;
+            if (!rw_result || !check_trace_index(options, base_index, rw_result->index)) {
+                return "can't read rw from file: " + rw_trace_path.string();
+            }
+            if (!zkevm_result || !check_trace_index(options, base_index, zkevm_result->index)) {
+                return "can't read zkevm states from file: " + zkevm_trace_path.string();
+            }
+            if (!copy_result || !check_trace_index(options, base_index, copy_result->index)) {
+                return "can't read copy events from file: " + copy_trace_path.string();
+            }
+            if (!exp_result || !check_trace_index(options, base_index, exp_result->index)) {
+                return "can't read exp operations from file: " + exp_trace_path.string();
+            }
+
+            traces.bytecodes = std::move(bytecodes_result->value);
+            traces.rw_operations = std::move(rw_result->value);
+            traces.zkevm_states = std::move(zkevm_result->value);
+            traces.copy_events = std::move(copy_result->value);
+            traces.exponentiations = std::move(exp_result->value);
+            return {};
+        }
+    } // proof_generator
+} // nil
+
+#endif  // PROOF_GENERATOR_LIBS_ASSIGNER_TRACE_SET_HPP_
@@ -20,7 +20,9 @@
 #include <boost/log/sources/record_ostream.hpp>
 #include <boost/log/trivial.hpp>
 #include <boost/assert.hpp>
-#include <ostream>  
+#include <algorithm>
+#include <array>
+#include <ostream>
 
 #include <nil/crypto3/marshalling/algebra/types/field_element.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/assignment.hpp>
@@ -28,6 +30,7 @@
 #include <nil/marshalling/types/integral.hpp>
 
 #include <nil/proof-generator/output_artifacts/output_artifacts.hpp>
+#include <nil/proof-generator/output_artifacts/mapped_assignment_table.hpp>
 
 
 namespace nil {
@@ -104,6 +107,46 @@ namespace nil {
                 }
 
 
+                /**
+                * @brief Rows amount of the written table: usable rows rounded up to a power of two,
+                * with at least one unusable row and at least 8 rows.
+                */
+                static std::uint32_t get_padded_rows_amount(const AssignmentTableDescription& desc) {
+                    std::uint32_t usable_rows_amount = desc.usable_rows_amount;
+
+                    std::uint32_t padded_rows_amount = std::pow(2, std::ceil(std::log2(usable_rows_amount)));
+                    if (padded_rows_amount == usable_rows_amount) {
+                        padded_rows_amount *= 2;
+                    }
+                    if (padded_rows_amount < 8) {
+                        padded_rows_amount = 8;
+                    }
+                    return padded_rows_amount;
+                }
+
+                /**
+                * @brief Write raw column content padded with zeroes up to the column stride.
+                */
+                static void write_mapped_column(
+                        std::ostream& out,
+                        const std::size_t padded_rows_amount,
+                        const std::size_t column_stride,
+                        const Column& table_col) {
+                    const std::size_t values_amount = std::min(table_col.size(), padded_rows_amount);
+                    const std::size_t values_bytes = values_amount * sizeof(BlueprintFieldValueType);
+                    out.write(reinterpret_cast<const char*>(table_col.data()), values_bytes);
+                    write_zero_bytes(out, column_stride - values_bytes);
+                }
+
+                static void write_zero_bytes(std::ostream& out, std::size_t amount) {
+                    static const std::array<char, MAPPED_TABLE_DATA_OFFSET> zeroes{};
+                    while (amount > 0) {
+                        const std::size_t chunk = std::min(amount, zeroes.size());
+                        out.write(zeroes.data(), chunk);
+                        amount -= chunk;
+                    }
+                }
+
             public:
                 assignment_table_writer() = delete;
 
@@ -113,15 +156,8 @@ namespace nil {
                     std::uint32_t constant_size = table.constants_amount();
                     std::uint32_t selector_size = table.selectors_amount();
                     std::uint32_t usable_rows_amount = desc.usable_rows_amount;
+                    std::uint32_t padded_rows_amount = get_padded_rows_amount(desc);
 
-                    std::uint32_t padded_rows_amount = std::pow(2, std::ceil(std::log2(usable_rows_amount)));
-                    if (padded_rows_amount == usable_rows_amount) {
-                        padded_rows_amount *= 2;
-                    }
-                    if (padded_rows_amount < 8) {
-                        padded_rows_amount = 8;
-                    }
-                    
                     write_size_t(out, witness_size);
                     write_size_t(out, public_input_size);
                     write_size_t(out, constant_size);
@@ -150,6 +186,40 @@ namespace nil {
                     }
                 }
 
+                /**
+                * @brief Write table in memory-mapped column-major format, see mapped_assignment_table.hpp.
+                * Field elements are written in their in-memory representation, so the file can be loaded
+                * without decoding.
+                */
+                static void write_mapped_assignment(std::ostream& out, const AssignmentTable& table, const AssignmentTableDescription& desc) {
+                    MappedAssignmentTableHeader header = make_mapped_assignment_table_header<BlueprintField>();
+                    header.witness_columns = table.witnesses_amount();
+                    header.public_input_columns = table.public_inputs_amount();
+                    header.constant_columns = table.constants_amount();
+                    header.selector_columns = table.selectors_amount();
+                    header.usable_rows_amount = desc.usable_rows_amount;
+                    header.rows_amount = get_padded_rows_amount(desc);
+
+                    const std::size_t column_bytes = header.rows_amount * header.element_size;
+                    header.column_stride = (column_bytes + MAPPED_TABLE_COLUMN_ALIGNMENT - 1) /
+                        MAPPED_TABLE_COLUMN_ALIGNMENT * MAPPED_TABLE_COLUMN_ALIGNMENT;
+
+                    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                    write_zero_bytes(out, header.data_offset - sizeof(header));
+
+                    for (std::uint32_t i = 0; i < table.witnesses_amount(); i++) {
+                        write_mapped_column(out, header.rows_amount, header.column_stride, table.witness(i));
+                    }
+                    for (std::uint32_t i = 0; i < table.public_inputs_amount(); i++) {
+                        write_mapped_column(out, header.rows_amount, header.column_stride, table.public_input(i));
+                    }
+                    for (std::uint32_t i = 0; i < table.constants_amount(); i++) {
+                        write_mapped_column(out, header.rows_amount, header.column_stride, table.constant(i));
+                    }
+                    for (std::uint32_t i = 0; i < table.selectors_amount(); i++) {
+                        write_mapped_column(out, header.rows_amount, header.column_stride, table.selector(i));
+                    }
+                }
 
                 static bool write_text_assignment(
                     std::ostream& out,
@@ -0,0 +1,304 @@
+/**
+ * @file mapped_assignment_table.hpp
+ *
+ * @brief Memory-mapped column-major assignment table format.
+ *
+ * File layout:
+ *   - MappedAssignmentTableHeader, zero-padded up to `data_offset` (one page);
+ *   - witness, public input, constant and selector columns, in this order. Each column holds
+ *     `rows_amount` field elements in their in-memory (Montgomery) representation and starts at
+ *     `data_offset + column_index * column_stride`, `column_stride` is a multiple of
+ *     MAPPED_TABLE_COLUMN_ALIGNMENT.
+ *
+ * Elements are stored exactly as the prover keeps them in memory, so the file is not portable
+ * between builds with a different field element layout or byte order. The header records both and
+ * the reader refuses files that do not match.
+ */
+
+#ifndef PROOF_GENERATOR_MAPPED_ASSIGNMENT_TABLE_HPP
+#define PROOF_GENERATOR_MAPPED_ASSIGNMENT_TABLE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <nil/crypto3/zk/snark/arithmetization/plonk/assignment.hpp>
+#include <nil/crypto3/zk/snark/arithmetization/plonk/table_description.hpp>
+
+namespace nil {
+    namespace proof_generator {
+
+        constexpr std::array<char, 8> MAPPED_TABLE_MAGIC = {'N', 'I', 'L', 'T', 'B', 'L', 'M', 'M'};
+        constexpr std::uint32_t MAPPED_TABLE_VERSION = 1;
+        constexpr std::uint32_t MAPPED_TABLE_BYTE_ORDER_MARK = 0x01020304;
+        constexpr std::size_t MAPPED_TABLE_DATA_OFFSET = 4096;
+        constexpr std::size_t MAPPED_TABLE_COLUMN_ALIGNMENT = 64;
+        constexpr std::size_t MAPPED_TABLE_MAX_ELEMENT_SIZE = 64;
+
+        /**
+        * @brief Fixed-size header at the beginning of a memory-mapped assignment table file.
+        */
+        struct MappedAssignmentTableHeader {
+            std::array<char, 8> magic;
+            std::uint32_t version;
+            std::uint32_t byte_order_mark;
+            std::uint64_t element_size;
+            std::uint64_t witness_columns;
+            std::uint64_t public_input_columns;
+            std::uint64_t constant_columns;
+            std::uint64_t selector_columns;
+            std::uint64_t usable_rows_amount;
+            std::uint64_t rows_amount;
+            std::uint64_t column_stride;
+            std::uint64_t data_offset;
+            /// @brief Field modulus limbs, zero-padded. Together with element_size identifies the field.
+            std::array<std::uint8_t, MAPPED_TABLE_MAX_ELEMENT_SIZE> modulus;
+
+            std::uint64_t columns_amount() const {
+                return witness_columns + public_input_columns + constant_columns + selector_columns;
+            }
+        };
+
+        static_assert(std::is_trivially_copyable_v<MappedAssignmentTableHeader>);
+        static_assert(sizeof(MappedAssignmentTableHeader) <= MAPPED_TABLE_DATA_OFFSET);
+
+        /**
+        * @brief Header fields that depend on the field type only.
+        */
+        template<typename BlueprintField>
+        MappedAssignmentTableHeader make_mapped_assignment_table_header() {
+            using value_type = typename BlueprintField::value_type;
+            static_assert(std::is_standard_layout_v<value_type>);
+            static_assert(sizeof(value_type) <= MAPPED_TABLE_MAX_ELEMENT_SIZE);
+
+            MappedAssignmentTableHeader header{};
+            header.magic = MAPPED_TABLE_MAGIC;
+            header.version = MAPPED_TABLE_VERSION;
+            header.byte_order_mark = MAPPED_TABLE_BYTE_ORDER_MARK;
+            header.element_size = sizeof(value_type);
+            header.data_offset = MAPPED_TABLE_DATA_OFFSET;
+
+            constexpr std::size_t modulus_words = (BlueprintField::modulus_bits + 63) / 64;
+            static_assert(modulus_words * sizeof(std::uint64_t) <= MAPPED_TABLE_MAX_ELEMENT_SIZE);
+            for (std::size_t i = 0; i < modulus_words; i++) {
+                std::uint64_t word = static_cast<std::uint64_t>(
+                    (BlueprintField::modulus >> (64 * i)) & std::numeric_limits<std::uint64_t>::max());
+                std::memcpy(header.modulus.data() + i * sizeof(word), &word, sizeof(word));
+            }
+            return header;
+        }
+
+        /**
+        * @brief Check whether the file starts with the memory-mapped table magic.
+        */
+        inline bool is_mapped_assignment_table(const std::string& path) {
+            std::array<char, MAPPED_TABLE_MAGIC.size()> magic{};
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                return false;
+            }
+            ssize_t read_bytes = ::read(fd, magic.data(), magic.size());
+            ::close(fd);
+            return read_bytes == static_cast<ssize_t>(magic.size()) && magic == MAPPED_TABLE_MAGIC;
+        }
+
+        /**
+        * @brief Read-only view of a memory-mapped assignment table file.
+        *
+        * Columns are exposed as spans into the mapping, nothing is decoded. The mapping is released
+        * when the object is destroyed, spans must not outlive it.
+        */
+        template<typename BlueprintField>
+        class mapped_assignment_table {
+            public:
+                using value_type = typename BlueprintField::value_type;
+                using Column = nil::crypto3::zk::snark::plonk_column<BlueprintField>;
+                using AssignmentTable = nil::crypto3::zk::snark::plonk_table<BlueprintField, Column>;
+                using AssignmentTableDescription = nil::crypto3::zk::snark::plonk_table_description<BlueprintField>;
+                using ColumnView = std::span<const value_type>;
+
+                mapped_assignment_table(const mapped_assignment_table&) = delete;
+                mapped_assignment_table& operator=(const mapped_assignment_table&) = delete;
+
+                mapped_assignment_table(mapped_assignment_table&& other) noexcept
+                    : data_(std::exchange(other.data_, nullptr))
+                    , size_(std::exchange(other.size_, 0))
+                    , header_(other.header_) {}
+
+                ~mapped_assignment_table() {
+                    if (data_ != nullptr) {
+                        ::munmap(data_, size_);
+                    }
+                }
+
+                /**
+                * @brief Map the file and validate its header against BlueprintField. Returns error as string
+                * if the file can't be mapped or was written for a different field or layout.
+                */
+                static std::expected<mapped_assignment_table, std::string> open(const std::string& path) {
+                    int fd = ::open(path.c_str(), O_RDONLY);
+                    if (fd < 0) {
+                        return std::unexpected("Unable to open file: " + path);
+                    }
+
+                    struct stat file_stat{};
+                    if (::fstat(fd, &file_stat) != 0 ||
+                            static_cast<std::size_t>(file_stat.st_size) < MAPPED_TABLE_DATA_OFFSET) {
+                        ::close(fd);
+                        return std::unexpected("File is too small to hold a mapped assignment table: " + path);
+                    }
+
+                    std::size_t size = file_stat.st_size;
+                    void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                    ::close(fd);
+                    if (data == MAP_FAILED) {
+                        return std::unexpected("Unable to map file: " + path);
+                    }
+                    ::madvise(data, size, MADV_SEQUENTIAL);
+
+                    mapped_assignment_table table(data, size);
+                    auto const err = table.validate();
+                    if (!err.empty()) {
+                        return std::unexpected(path + ": " + err);
+                    }
+                    return table;
+                }
+
+                const MappedAssignmentTableHeader& header() const {
+                    return header_;
+                }
+
+                AssignmentTableDescription description() const {
+                    return AssignmentTableDescription(
+                        header_.witness_columns,
+                        header_.public_input_columns,
+                        header_.constant_columns,
+                        header_.selector_columns,
+                        header_.usable_rows_amount,
+                        header_.rows_amount
+                    );
+                }
+
+                ColumnView witness(std::size_t index) const {
+                    BOOST_ASSERT(index < header_.witness_columns);
+                    return column(index);
+                }
+
+                ColumnView public_input(std::size_t index) const {
+                    BOOST_ASSERT(index < header_.public_input_columns);
+                    return column(header_.witness_columns + index);
+                }
+
+                ColumnView constant(std::size_t index) const {
+                    BOOST_ASSERT(index < header_.constant_columns);
+                    return column(header_.witness_columns + header_.public_input_columns + index);
+                }
+
+                ColumnView selector(std::size_t index) const {
+                    BOOST_ASSERT(index < header_.selector_columns);
+                    return column(header_.witness_columns + header_.public_input_columns +
+                                  header_.constant_columns + index);
+                }
+
+                /**
+                * @brief Build a prover table out of the mapped columns. Each column is a single bulk
+                * copy from the mapping, no per-element decoding is involved.
+                */
+                std::pair<AssignmentTableDescription, AssignmentTable> make_table() const {
+                    const auto copy_columns = [this](std::size_t first, std::size_t amount) {
+                        std::vector<Column> columns;
+                        columns.reserve(amount);
+                        for (std::size_t i = 0; i < amount; i++) {
+                            ColumnView view = column(first + i);
+                            columns.emplace_back(view.begin(), view.end());
+                        }
+                        return columns;
+                    };
+
+                    std::size_t first = 0;
+                    auto witnesses = copy_columns(first, header_.witness_columns);
+                    first += header_.witness_columns;
+                    auto public_inputs = copy_columns(first, header_.public_input_columns);
+                    first += header_.public_input_columns;
+                    auto constants = copy_columns(first, header_.constant_columns);
+                    first += header_.constant_columns;
+                    auto selectors = copy_columns(first, header_.selector_columns);
+
+                    using private_table = typename AssignmentTable::private_table_type;
+                    using public_table = typename AssignmentTable::public_table_type;
+
+                    return std::make_pair(description(), AssignmentTable(
+                        std::make_shared<private_table>(std::move(witnesses)),
+                        std::make_shared<public_table>(
+                            std::move(public_inputs),
+                            std::move(constants),
+                            std::move(selectors)
+                        )
+                    ));
+                }
+
+            private:
+                mapped_assignment_table(void* data, std::size_t size) : data_(data), size_(size) {
+                    std::memcpy(&header_, data_, sizeof(header_));
+                }
+
+                ColumnView column(std::size_t global_index) const {
+                    const auto* bytes = static_cast<const std::uint8_t*>(data_) +
+                        header_.data_offset + global_index * header_.column_stride;
+                    return ColumnView(reinterpret_cast<const value_type*>(bytes), header_.rows_amount);
+                }
+
+                std::string validate() const {
+                    const auto expected = make_mapped_assignment_table_header<BlueprintField>();
+                    if (header_.magic != MAPPED_TABLE_MAGIC) {
+                        return "not a mapped assignment table";
+                    }
+                    if (header_.version != MAPPED_TABLE_VERSION) {
+                        return "unsupported mapped assignment table version " + std::to_string(header_.version);
+                    }
+                    if (header_.byte_order_mark != MAPPED_TABLE_BYTE_ORDER_MARK) {
+                        return "table was written on a machine with a different byte order";
+                    }
+                    if (header_.element_size != expected.element_size ||
+                            header_.modulus != expected.modulus) {
+                        return "table was written for a different field or field element layout";
+                    }
+                    if (header_.data_offset % MAPPED_TABLE_COLUMN_ALIGNMENT != 0 ||
+                            header_.column_stride % MAPPED_TABLE_COLUMN_ALIGNMENT != 0 ||
+                            header_.column_stride < header_.rows_amount * header_.element_size) {
+                        return "malformed column layout";
+                    }
+                    if (header_.usable_rows_amount >= header_.rows_amount) {
+                        return "rows amount should be greater than usable rows amount";
+                    }
+                    if (header_.data_offset + header_.columns_amount() * header_.column_stride > size_) {
+                        return "file is truncated";
+                    }
+                    return {};
+                }
+
+                void* data_;
+                std::size_t size_;
+                MappedAssignmentTableHeader header_;
+        };
+
+    } // namespace proof_generator
+} // namespace nil
+
+#endif // PROOF_GENERATOR_MAPPED_ASSIGNMENT_TABLE_HPP
@@ -0,0 +1,85 @@
+#ifndef PROOF_GENERATOR_LIBS_PRESET_CIRCUIT_CACHE_HPP_
+#define PROOF_GENERATOR_LIBS_PRESET_CIRCUIT_CACHE_HPP_
+
+#include <sstream>
+#include <string>
+
+#include <boost/filesystem.hpp>
+
+#include <nil/crypto3/hash/algorithm/hash.hpp>
+#include <nil/crypto3/hash/sha2.hpp>
+
+#include <nil/proof-generator/preset/limits.hpp>
+
+#include "circuits_hash.h"
+
+namespace nil {
+    namespace proof_generator {
+
+        // Generated circuits are cached on disk in a directory per circuit, named by the hash of everything the
+        // generation depends on: the circuit name, its limits and the hash of the circuit sources (CIRCUITS_SOURCES_HASH,
+        // computed by cmake). Preprocessed data stored in the same directory is additionally keyed by the
+        // preprocessing parameters, see entry_file.
+        class CircuitCache {
+        public:
+            static constexpr const char CIRCUIT_FILE[] = "circuit.crct";
+            static constexpr const char PRESET_TABLE_FILE[] = "preset.tbl";
+
+            CircuitCache(const boost::filesystem::path& cache_dir,
+                         const std::string& circuit_name,
+                         const CircuitsLimits& circuits_limits)
+                : directory_(cache_dir / (circuit_name + "_" + circuit_key(circuit_name, circuits_limits))) {}
+
+            const boost::filesystem::path& directory() const {
+                return directory_;
+            }
+
+            boost::filesystem::path circuit_file() const {
+                return directory_ / CIRCUIT_FILE;
+            }
+
+            boost::filesystem::path preset_table_file() const {
+                return directory_ / PRESET_TABLE_FILE;
+            }
+
+            bool has_circuit() const {
+                return boost::filesystem::exists(circuit_file()) && boost::filesystem::exists(preset_table_file());
+            }
+
+            // File of the cached entry identified by the given parameters, e.g. preprocessed data for some table size.
+            boost::filesystem::path entry_file(const std::string& prefix, const std::string& parameters) const {
+                return directory_ / (prefix + "_" + hex_hash(parameters) + ".dat");
+            }
+
+            // Entries are written to a temporary file first and renamed, so that concurrent provers sharing the cache
+            // never read a partially written file.
+            static boost::filesystem::path temporary_file(const boost::filesystem::path& file) {
+                return boost::filesystem::path(file.string() + "." + boost::filesystem::unique_path().string() + ".tmp");
+            }
+
+        private:
+            static std::string hex_hash(const std::string& value) {
+                return nil::crypto3::hash<nil::crypto3::hashes::sha2<256>>(value);
+            }
+
+            static std::string circuit_key(const std::string& circuit_name, const CircuitsLimits& limits) {
+                std::stringstream key;
+                key << CIRCUITS_SOURCES_HASH << " " << circuit_name
+                    << " " << limits.max_copy
+                    << " " << limits.max_rw_size
+                    << " " << limits.max_keccak_blocks
+                    << " " << limits.max_bytecode_size
+                    << " " << limits.max_rows
+                    << " " << limits.max_mpt_size
+                    << " " << limits.max_zkevm_rows
+                    << " " << limits.max_exp_rows
+                    << " " << limits.RLC_CHALLENGE;
+                return hex_hash(key.str());
+            }
+
+            boost::filesystem::path directory_;
+        };
+    } // proof_generator
+} // nil
+
+#endif  // PROOF_GENERATOR_LIBS_PRESET_CIRCUIT_CACHE_HPP_
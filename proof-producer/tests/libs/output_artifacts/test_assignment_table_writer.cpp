@@ -5,6 +5,7 @@
 #include <sstream>
 #include <format>
 #include <algorithm>
+#include <filesystem>
 
 #include <boost/algorithm/string.hpp>
 
@@ -13,10 +14,12 @@
 #include <nil/marshalling/status_type.hpp>
 
 #include <nil/crypto3/algebra/curves/pallas.hpp>
+#include <nil/crypto3/algebra/curves/vesta.hpp>
 #include <nil/crypto3/marshalling/zk/types/plonk/assignment_table.hpp>
 
 #include <nil/proof-generator/output_artifacts/output_artifacts.hpp>
 #include <nil/proof-generator/output_artifacts/assignment_table_writer.hpp>
+#include <nil/proof-generator/output_artifacts/mapped_assignment_table.hpp>
 
 using Endianness = nil::crypto3::marshalling::option::big_endian;
 using TTypeBase = nil::crypto3::marshalling::field_type<Endianness>;
@@ -29,6 +32,8 @@ using AssignmentTableDescription = Writer::AssignmentTableDescription;
 
 using MarshalledTable = nil::crypto3::marshalling::types::plonk_assignment_table<TTypeBase, AssignmentTable>;
 
+using MappedTable = nil::proof_generator::mapped_assignment_table<BlueprintField>;
+
 using nil::proof_generator::OutputArtifacts;
 using nil::proof_generator::Ranges;
 using nil::proof_generator::Range;
@@ -134,6 +139,75 @@ TEST_F(AssignmentTableWriterTest, WriteBinaryAssignment)
     ASSERT_TRUE(std::memcmp(written->view().data(), table_bytes_.data(), table_bytes_.size()) == 0);
 }
 
+TEST_F(AssignmentTableWriterTest, WriteMappedAssignment)
+{
+    const std::string mapped_table_path =
+        (std::filesystem::temp_directory_path() / "test_assignment_table_writer_mapped.tbl").string();
+    {
+        std::ofstream out(mapped_table_path, std::ios::binary | std::ios::out);
+        ASSERT_TRUE(out.is_open());
+        Writer::write_mapped_assignment(out, table_, desc_);
+        ASSERT_FALSE(out.fail());
+    }
+
+    ASSERT_TRUE(nil::proof_generator::is_mapped_assignment_table(mapped_table_path));
+    ASSERT_FALSE(nil::proof_generator::is_mapped_assignment_table(std::string(TEST_DATA_DIR) + "assignment.tbl"));
+
+    auto mapped = MappedTable::open(mapped_table_path);
+    ASSERT_TRUE(mapped.has_value()) << mapped.error();
+
+    const auto& header = mapped->header();
+    EXPECT_EQ(header.data_offset % 4096, 0);
+    EXPECT_EQ(header.column_stride % nil::proof_generator::MAPPED_TABLE_COLUMN_ALIGNMENT, 0);
+
+    auto [desc, table] = mapped->make_table();
+    EXPECT_EQ(desc.witness_columns, table_.witnesses_amount());
+    EXPECT_EQ(desc.public_input_columns, table_.public_inputs_amount());
+    EXPECT_EQ(desc.constant_columns, table_.constants_amount());
+    EXPECT_EQ(desc.selector_columns, table_.selectors_amount());
+    EXPECT_EQ(desc.usable_rows_amount, desc_.usable_rows_amount);
+    EXPECT_EQ(desc.rows_amount, desc_.rows_amount);
+
+    const auto check_columns = [&](std::size_t amount, auto get_expected, auto get_actual, auto get_view) {
+        for (std::size_t col = 0; col < amount; col++) {
+            const auto& expected = get_expected(col);
+            const auto& actual = get_actual(col);
+            const auto view = get_view(col);
+            ASSERT_EQ(actual.size(), desc.rows_amount) << "col: " << col;
+            ASSERT_EQ(view.size(), desc.rows_amount) << "col: " << col;
+            for (std::size_t row = 0; row < desc.rows_amount; row++) {
+                const auto expected_value = row < expected.size() ? expected[row] : BlueprintField::value_type::zero();
+                ASSERT_EQ(expected_value, actual[row]) << "row: " << row << " col: " << col;
+                ASSERT_EQ(expected_value, view[row]) << "row: " << row << " col: " << col;
+            }
+        }
+    };
+
+    check_columns(table_.witnesses_amount(),
+        [&](std::size_t i) -> const auto& { return table_.witness(i); },
+        [&](std::size_t i) -> const auto& { return table.witness(i); },
+        [&](std::size_t i) { return mapped->witness(i); });
+    check_columns(table_.public_inputs_amount(),
+        [&](std::size_t i) -> const auto& { return table_.public_input(i); },
+        [&](std::size_t i) -> const auto& { return table.public_input(i); },
+        [&](std::size_t i) { return mapped->public_input(i); });
+    check_columns(table_.constants_amount(),
+        [&](std::size_t i) -> const auto& { return table_.constant(i); },
+        [&](std::size_t i) -> const auto& { return table.constant(i); },
+        [&](std::size_t i) { return mapped->constant(i); });
+    check_columns(table_.selectors_amount(),
+        [&](std::size_t i) -> const auto& { return table_.selector(i); },
+        [&](std::size_t i) -> const auto& { return table.selector(i); },
+        [&](std::size_t i) { return mapped->selector(i); });
+
+    // table written for another field must be refused
+    using OtherField = typename nil::crypto3::algebra::curves::vesta::base_field_type;
+    auto other = nil::proof_generator::mapped_assignment_table<OtherField>::open(mapped_table_path);
+    EXPECT_FALSE(other.has_value());
+
+    std::filesystem::remove(mapped_table_path);
+}
+
 TEST_F(AssignmentTableWriterTest, WriteFullTextAssignment) 
 {
     OutputArtifacts artifacts;